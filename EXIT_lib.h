@@ -33,6 +33,8 @@
  * 3. Macros de acceso a registros
  * a. Acceso completo
  * b. Acceso a campos
+ * c. Limpieza de pendientes (W1C)
+ * d. Interrupción software
  */
 
 #ifndef EXTI_LIB_H_
@@ -40,6 +42,8 @@
 
 #include <stdint.h>
 
+#include "EXTI_variant.h"
+
 /************************************************************************************************
  * 1. DEFINICION DE REGISTROS
  ************************************************************************************************/
@@ -757,53 +761,79 @@ typedef struct {
  * accidentales en zonas reservadas por el hardware.
  */
 
+/* Las máscaras se derivan de la variante de chip seleccionada (EXTI_variant.h): los
+ * registros de configuración de flanco, SWIER y PR solo implementan las líneas
+ * configurables, mientras que IMR/EMR implementan todas las líneas de la parte. */
+
 /* EXTI_IMR1 Register Masks */
-#define mEXTI_IMR1_VALID     (0xFFFFFFFFU)  /*!< Máscara de todos los bits válidos en IMR1 */
-#define mEXTI_IMR1_RESERVED  (0x00000000U)  /*!< Máscara de todos los bits reservados en IMR1 */
+#define mEXTI_IMR1_VALID     (kEXTI_VAR_LINES1)              /*!< Máscara de todos los bits válidos en IMR1 */
+#define mEXTI_IMR1_RESERVED  (~kEXTI_VAR_LINES1)             /*!< Máscara de todos los bits reservados en IMR1 */
 
 /* EXTI_EMR1 Register Masks */
-#define mEXTI_EMR1_VALID     (0xFFFFFFFFU)  /*!< Máscara de todos los bits válidos en EMR1 */
-#define mEXTI_EMR1_RESERVED  (0x00000000U)  /*!< Máscara de todos los bits reservados en EMR1 */
+#define mEXTI_EMR1_VALID     (kEXTI_VAR_LINES1)              /*!< Máscara de todos los bits válidos en EMR1 */
+#define mEXTI_EMR1_RESERVED  (~kEXTI_VAR_LINES1)             /*!< Máscara de todos los bits reservados en EMR1 */
 
 /* EXTI_RTSR1 Register Masks */
-#define mEXTI_RTSR1_VALID    (0x007DFFFFU)  /*!< Máscara de todos los bits válidos en RTSR1 */
-#define mEXTI_RTSR1_RESERVED (0xFF820000U)  /*!< Máscara de todos los bits reservados en RTSR1 */
+#define mEXTI_RTSR1_VALID    (kEXTI_VAR_CONFIG1)             /*!< Máscara de todos los bits válidos en RTSR1 */
+#define mEXTI_RTSR1_RESERVED (~kEXTI_VAR_CONFIG1)            /*!< Máscara de todos los bits reservados en RTSR1 */
 
 /* EXTI_FTSR1 Register Masks */
-#define mEXTI_FTSR1_VALID    (0x007DFFFFU)  /*!< Máscara de todos los bits válidos en FTSR1 */
-#define mEXTI_FTSR1_RESERVED (0xFF820000U)  /*!< Máscara de todos los bits reservados en FTSR1 */
+#define mEXTI_FTSR1_VALID    (kEXTI_VAR_CONFIG1)             /*!< Máscara de todos los bits válidos en FTSR1 */
+#define mEXTI_FTSR1_RESERVED (~kEXTI_VAR_CONFIG1)            /*!< Máscara de todos los bits reservados en FTSR1 */
 
 /* EXTI_SWIER1 Register Masks */
-#define mEXTI_SWIER1_VALID   (0x007DFFFFU)  /*!< Máscara de todos los bits válidos en SWIER1 */
-#define mEXTI_SWIER1_RESERVED (0xFF820000U) /*!< Máscara de todos los bits reservados en SWIER1 */
+#define mEXTI_SWIER1_VALID   (kEXTI_VAR_CONFIG1)             /*!< Máscara de todos los bits válidos en SWIER1 */
+#define mEXTI_SWIER1_RESERVED (~kEXTI_VAR_CONFIG1)           /*!< Máscara de todos los bits reservados en SWIER1 */
 
 /* EXTI_PR1 Register Masks */
-#define mEXTI_PR1_VALID      (0x007DFFFFU)  /*!< Máscara de todos los bits válidos en PR1 */
-#define mEXTI_PR1_RESERVED   (0xFF820000U)  /*!< Máscara de todos los bits reservados en PR1 */
+#define mEXTI_PR1_VALID      (kEXTI_VAR_CONFIG1)             /*!< Máscara de todos los bits válidos en PR1 */
+#define mEXTI_PR1_RESERVED   (~kEXTI_VAR_CONFIG1)            /*!< Máscara de todos los bits reservados en PR1 */
 
 /* EXTI_IMR2 Register Masks */
-#define mEXTI_IMR2_VALID     (0x000001FFU)  /*!< Máscara de todos los bits válidos en IMR2 */
-#define mEXTI_IMR2_RESERVED  (0xFFFFFE00U)  /*!< Máscara de todos los bits reservados en IMR2 */
+#define mEXTI_IMR2_VALID     (kEXTI_VAR_LINES2)              /*!< Máscara de todos los bits válidos en IMR2 */
+#define mEXTI_IMR2_RESERVED  (~kEXTI_VAR_LINES2)             /*!< Máscara de todos los bits reservados en IMR2 */
 
 /* EXTI_EMR2 Register Masks */
-#define mEXTI_EMR2_VALID     (0x000001FFU)  /*!< Máscara de todos los bits válidos en EMR2 */
-#define mEXTI_EMR2_RESERVED  (0xFFFFFE00U)  /*!< Máscara de todos los bits reservados en EMR2 */
+#define mEXTI_EMR2_VALID     (kEXTI_VAR_LINES2)              /*!< Máscara de todos los bits válidos en EMR2 */
+#define mEXTI_EMR2_RESERVED  (~kEXTI_VAR_LINES2)             /*!< Máscara de todos los bits reservados en EMR2 */
 
 /* EXTI_RTSR2 Register Masks */
-#define mEXTI_RTSR2_VALID    (0x00000078U)  /*!< Máscara de todos los bits válidos en RTSR2 (bits 3-6) */
-#define mEXTI_RTSR2_RESERVED (0xFFFFFF87U)  /*!< Máscara de todos los bits reservados en RTSR2 */
+#define mEXTI_RTSR2_VALID    (kEXTI_VAR_CONFIG2)             /*!< Máscara de todos los bits válidos en RTSR2 */
+#define mEXTI_RTSR2_RESERVED (~kEXTI_VAR_CONFIG2)            /*!< Máscara de todos los bits reservados en RTSR2 */
 
 /* EXTI_FTSR2 Register Masks */
-#define mEXTI_FTSR2_VALID    (0x00000078U)  /*!< Máscara de todos los bits válidos en FTSR2 (bits 3-6) */
-#define mEXTI_FTSR2_RESERVED (0xFFFFFF87U)  /*!< Máscara de todos los bits reservados en FTSR2 */
+#define mEXTI_FTSR2_VALID    (kEXTI_VAR_CONFIG2)             /*!< Máscara de todos los bits válidos en FTSR2 */
+#define mEXTI_FTSR2_RESERVED (~kEXTI_VAR_CONFIG2)            /*!< Máscara de todos los bits reservados en FTSR2 */
 
 /* EXTI_SWIER2 Register Masks */
-#define mEXTI_SWIER2_VALID   (0x00000078U)  /*!< Máscara de todos los bits válidos en SWIER2 (bits 3-6) */
-#define mEXTI_SWIER2_RESERVED (0xFFFFFF87U) /*!< Máscara de todos los bits reservados en SWIER2 */
+#define mEXTI_SWIER2_VALID   (kEXTI_VAR_CONFIG2)             /*!< Máscara de todos los bits válidos en SWIER2 */
+#define mEXTI_SWIER2_RESERVED (~kEXTI_VAR_CONFIG2)           /*!< Máscara de todos los bits reservados en SWIER2 */
 
 /* EXTI_PR2 Register Masks */
-#define mEXTI_PR2_VALID      (0x00000078U)  /*!< Máscara de todos los bits válidos en PR2 (bits 3-6) */
-#define mEXTI_PR2_RESERVED   (0xFFFFFF87U)  /*!< Máscara de todos los bits reservados en PR2 */
+#define mEXTI_PR2_VALID      (kEXTI_VAR_CONFIG2)             /*!< Máscara de todos los bits válidos en PR2 */
+#define mEXTI_PR2_RESERVED   (~kEXTI_VAR_CONFIG2)            /*!< Máscara de todos los bits reservados en PR2 */
+
+
+/* c. Macros de acceso */
+/**
+ * \brief  Dirección base y puntero al bloque de registros EXTI.
+ * \details En el microcontrolador el bloque EXTI se encuentra en 0x40010400 (bus APB2).
+ * Ambas macros pueden redefinirse antes de incluir esta cabecera. El simulador de host
+ * compila con EXTI_SIM y apunta sEXTI a un bloque en RAM (sEXTI_SIM), de modo que las
+ * macros rEXTI_* y bEXTI_* funcionan sin cambios fuera del hardware.
+ */
+#ifndef EXTI_BASE
+#define EXTI_BASE         (0x40010400UL)
+#endif
+
+#ifndef sEXTI
+#ifdef EXTI_SIM
+extern __EXTI_t sEXTI_SIM;                      /*!< Bloque EXTI simulado (host) */
+#define sEXTI             (&sEXTI_SIM)
+#else
+#define sEXTI             ((__EXTI_t *) EXTI_BASE)
+#endif
+#endif
 
 
 /************************************************************************************************
@@ -1048,5 +1078,42 @@ typedef struct {
 #define bEXTI_PIF37       (sEXTI->PR2.b.PIF37)
 #define bEXTI_PIF38       (sEXTI->PR2.b.PIF38)
 
+/* c. Limpieza de pendientes (W1C) */
+/**
+ * \brief  Macros para reconocer pendientes en PR1/PR2.
+ * \details PRx es W1C: se escribe la máscara de todas las líneas atendidas en una sola
+ * escritura. No debe usarse bEXTI_PIFx = 1, ya que el bitfield lee el registro completo y
+ * limpiaría también los pendientes que aún no se han atendido. En el simulador de host la
+ * escritura W1C se emula con EXTI_SIM_ClearPending1/2.
+ */
+#ifdef EXTI_SIM
+#ifdef __cplusplus
+extern "C" {
+#endif
+void EXTI_SIM_ClearPending1(uint32_t mask);
+void EXTI_SIM_ClearPending2(uint32_t mask);
+void EXTI_SIM_Software1(uint32_t mask);
+#ifdef __cplusplus
+}
+#endif
+#define EXTI_PR1_CLEAR(m)     EXTI_SIM_ClearPending1(m)
+#define EXTI_PR2_CLEAR(m)     EXTI_SIM_ClearPending2(m)
+#else
+#define EXTI_PR1_CLEAR(m)     (rEXTI_PR1 = (m))
+#define EXTI_PR2_CLEAR(m)     (rEXTI_PR2 = (m))
+#endif
+
+/* d. Interrupción software */
+/**
+ * \brief  Macro para lanzar la interrupción software de líneas configurables de SWIER1.
+ * \details Escribir 1 en SWIx marca PIFx (y pide la IRQ si IMx = 1); escribir 0 no tiene
+ * efecto, por lo que basta una escritura directa. El bit se borra al limpiar PIFx.
+ */
+#ifdef EXTI_SIM
+#define EXTI_SWIER1_SET(m)    EXTI_SIM_Software1(m)
+#else
+#define EXTI_SWIER1_SET(m)    (rEXTI_SWIER1 = (m))
+#endif
+
 
 #endif /* EXTI_LIB_H_ */
\ No newline at end of file
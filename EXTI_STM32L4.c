@@ -1,13 +1,43 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 
+#include "EXTI_line.h"
+#include "EXTI_loop.h"
+
+#define kAPP_BUTTON_GPIO      (15u)
+#define kAPP_HELLO_PERIOD     (1000000u)   /* Ticks de la rueda (1 us en RP2040) */
+
+static __EXTI_LOOP_t  sAPP_LOOP;
+static __EXTI_TIMER_t sAPP_HELLO;
+
+static void app_hello(__EXTI_TIMER_t *t, void *ctx)
+{
+    (void) ctx;
+    printf("Hello, world!\n");
+    /* Periodo sin deriva: se rearma desde la expiración anterior */
+    EXTI_TimerStart(&sEXTI_WHEEL, t, t->expires + kAPP_HELLO_PERIOD);
+}
+
+static void app_button(const __EXTI_EVENT_t *ev, void *ctx)
+{
+    (void) ctx;
+    printf("GPIO%u: events 0x%x at %lu us\n", ev->line, ev->events, (unsigned long) ev->ts);
+}
+
 
 int main()
 {
     stdio_init_all();
 
-    while (true) {
-        printf("Hello, world!\n");
-        sleep_ms(1000);
-    }
+    gpio_init(kAPP_BUTTON_GPIO);
+    gpio_pull_up(kAPP_BUTTON_GPIO);
+
+    EXTI_LineInit();
+    EXTI_LoopInit(&sAPP_LOOP);
+    EXTI_LoopLineConfig(&sAPP_LOOP, kAPP_BUTTON_GPIO, kEXTI_TRIG_EDGE_FALLING, app_button, NULL);
+
+    EXTI_TimerInit(&sAPP_HELLO, app_hello, NULL);
+    EXTI_TimerStartIn(&sEXTI_WHEEL, &sAPP_HELLO, kAPP_HELLO_PERIOD);
+
+    EXTI_LoopRun(&sAPP_LOOP);
 }
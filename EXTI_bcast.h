@@ -0,0 +1,275 @@
+/**
+ * \file EXTI_bcast.h
+ * \brief Cola de difusión de eventos de línea: un productor, varios suscriptores.
+ * \details Un único búfer circular de eventos compartido por todos los módulos que consumen
+ * el flujo EXTI (registro, estadísticas, decodificadores, aplicación), en lugar de copiar cada
+ * evento en N colas EXTI_ring.h. Cada suscriptor tiene su propio cursor de lectura y un filtro
+ * de líneas; los eventos de líneas fuera de su filtro se saltan sin copiarse, y los de líneas
+ * que ningún suscriptor escucha ni siquiera se publican.
+ *
+ * El productor (una ISR) conoce el cursor más lento con una cota en caché (gate), que solo
+ * recalcula recorriendo los suscriptores cuando la cola parece llena. Con el búfer lleno:
+ *  - kEXTI_BCAST_BLOCK:     el evento nuevo se descarta (dropped): ningún suscriptor pierde
+ *                           eventos ya publicados.
+ *  - kEXTI_BCAST_OVERWRITE: se sobrescribe el más antiguo; el suscriptor rezagado detecta el
+ *                           solape con la secuencia de cada ranura, salta al evento más
+ *                           antiguo aún válido y suma lo perdido en su contador lost.
+ *
+ * Las suscripciones se hacen en la inicialización, antes de que publique el productor. Como
+ * en EXTI_ring.h solo se usan cargas/almacenamientos de 32 bits con acquire/release: cada
+ * cursor lo escribe únicamente su suscriptor. kEXTI_BCAST_SIZE debe ser potencia de 2.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_BCAST_H_
+#define EXTI_BCAST_H_
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "EXTI_ring.h"
+
+#ifndef kEXTI_BCAST_SIZE
+#define kEXTI_BCAST_SIZE      (256u)
+#endif
+
+#ifndef kEXTI_BCAST_SUBS
+#define kEXTI_BCAST_SUBS      (8u)
+#endif
+
+#if (kEXTI_BCAST_SIZE & (kEXTI_BCAST_SIZE - 1u)) != 0u
+#error "kEXTI_BCAST_SIZE debe ser potencia de 2"
+#endif
+
+#define mEXTI_BCAST_INDEX     (kEXTI_BCAST_SIZE - 1u)
+#define kEXTI_BCAST_ALL       (~(uint64_t) 0u)   /*!< Filtro: todas las líneas */
+
+#define EXTI_BCAST_LINE(line) ((uint64_t) 1u << (line))
+
+/**
+ * \brief  Política con el búfer lleno.
+ */
+typedef enum {
+  kEXTI_BCAST_BLOCK     = 0,
+  kEXTI_BCAST_OVERWRITE = 1
+} __EXTI_BCAST_POLICY_t;
+
+/**
+ * \brief  Ranura: evento y secuencia + 1 del evento que contiene (0 mientras se escribe).
+ */
+typedef struct {
+  _Atomic uint32_t seq;
+  __EXTI_EVENT_t   ev;
+} __EXTI_BCAST_SLOT_t;
+
+/**
+ * \brief  Suscriptor. Cada uno en su propia línea de caché (solo relevante en el host).
+ */
+typedef struct {
+  _Atomic uint32_t cursor;    /*!< Secuencia del siguiente evento a leer */
+  _Atomic uint32_t active;
+  uint64_t         filter;    /*!< EXTI_BCAST_LINE() de las líneas de interés */
+  uint32_t         lost;      /*!< Eventos sobrescritos antes de leerlos (OVERWRITE) */
+  uint8_t          _pad[kEXTI_RING_PAD - 20u];
+} __EXTI_BCAST_SUB_t;
+
+/**
+ * \brief  Cola de difusión.
+ */
+typedef struct {
+  _Atomic uint32_t    head;                        /*!< Escrito solo por el productor */
+  uint32_t            gate;                        /*!< Cota del cursor más lento (productor) */
+  uint32_t            policy;
+  uint32_t            dropped;                     /*!< Eventos descartados (BLOCK) */
+  uint64_t            filter;                      /*!< Unión de los filtros */
+  uint8_t             _pad[kEXTI_RING_PAD - 24u];
+  __EXTI_BCAST_SUB_t  sub[kEXTI_BCAST_SUBS];
+  __EXTI_BCAST_SLOT_t buf[kEXTI_BCAST_SIZE];
+} __EXTI_BCAST_t;
+
+/**
+ * \brief  Inicializa la cola vacía y sin suscriptores.
+ */
+static inline void EXTI_BcastInit(__EXTI_BCAST_t *b, __EXTI_BCAST_POLICY_t policy)
+{
+  atomic_store_explicit(&b->head, 0u, memory_order_relaxed);
+  b->gate    = 0u;
+  b->policy  = (uint32_t) policy;
+  b->dropped = 0u;
+  b->filter  = 0u;
+  for (uint32_t i = 0u; i < kEXTI_BCAST_SUBS; i++) {
+    atomic_store_explicit(&b->sub[i].active, 0u, memory_order_relaxed);
+  }
+  for (uint32_t i = 0u; i < kEXTI_BCAST_SIZE; i++) {
+    atomic_store_explicit(&b->buf[i].seq, 0u, memory_order_relaxed);
+  }
+}
+
+/**
+ * \brief  Añade un suscriptor que recibe los eventos publicados desde ahora.
+ * \param  filter  Líneas de interés (EXTI_BCAST_LINE() o kEXTI_BCAST_ALL).
+ * \return Identificador del suscriptor, o -1 si no quedan huecos.
+ */
+static inline int32_t EXTI_BcastSubscribe(__EXTI_BCAST_t *b, uint64_t filter)
+{
+  for (uint32_t i = 0u; i < kEXTI_BCAST_SUBS; i++) {
+    __EXTI_BCAST_SUB_t *s = &b->sub[i];
+
+    if (atomic_load_explicit(&s->active, memory_order_relaxed) == 0u) {
+      s->filter = filter;
+      s->lost   = 0u;
+      atomic_store_explicit(&s->cursor, atomic_load_explicit(&b->head, memory_order_relaxed),
+                            memory_order_relaxed);
+      atomic_store_explicit(&s->active, 1u, memory_order_release);
+      b->filter |= filter;
+      return (int32_t) i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * \brief  Retira un suscriptor: deja de frenar al productor y el filtro de la cola se
+ * recalcula con los suscriptores que quedan, de modo que las líneas que ya nadie escucha
+ * dejan de publicarse.
+ * \details Cada mitad de 32 bits del filtro pasa del valor anterior al nuevo; una lectura
+ * del productor a medio cambio solo puede publicar de más un evento que nadie leerá.
+ */
+static inline void EXTI_BcastUnsubscribe(__EXTI_BCAST_t *b, int32_t id)
+{
+  uint64_t filter = 0u;
+
+  atomic_store_explicit(&b->sub[id].active, 0u, memory_order_release);
+  for (uint32_t i = 0u; i < kEXTI_BCAST_SUBS; i++) {
+    if (atomic_load_explicit(&b->sub[i].active, memory_order_relaxed) != 0u) {
+      filter |= b->sub[i].filter;
+    }
+  }
+  b->filter = filter;
+}
+
+/* Cursor más lento de los suscriptores activos (head si no hay ninguno) */
+static inline uint32_t EXTI_BcastSlowest(__EXTI_BCAST_t *b, uint32_t head)
+{
+  uint32_t lag = 0u;
+
+  for (uint32_t i = 0u; i < kEXTI_BCAST_SUBS; i++) {
+    if (atomic_load_explicit(&b->sub[i].active, memory_order_acquire) != 0u) {
+      uint32_t d = head - atomic_load_explicit(&b->sub[i].cursor, memory_order_acquire);
+
+      lag = (d > lag) ? d : lag;
+    }
+  }
+  return head - lag;
+}
+
+/**
+ * \brief  Publica un evento (lado productor).
+ * \return 1 si se publicó o ningún suscriptor escucha la línea, 0 si se descartó (BLOCK).
+ */
+static inline uint32_t EXTI_BcastPublish(__EXTI_BCAST_t *b, uint32_t ts, uint32_t line,
+                                         uint32_t events)
+{
+  uint32_t             head = atomic_load_explicit(&b->head, memory_order_relaxed);
+  __EXTI_BCAST_SLOT_t *slot;
+
+  if ((b->filter & EXTI_BCAST_LINE(line)) == 0u) {
+    return 1u;
+  }
+  if ((b->policy == kEXTI_BCAST_BLOCK) && ((head - b->gate) >= kEXTI_BCAST_SIZE)) {
+    b->gate = EXTI_BcastSlowest(b, head);
+    if ((head - b->gate) >= kEXTI_BCAST_SIZE) {
+      b->dropped++;
+      return 0u;
+    }
+  }
+
+  slot = &b->buf[head & mEXTI_BCAST_INDEX];
+  atomic_store_explicit(&slot->seq, 0u, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  slot->ev.ts     = ts;
+  slot->ev.line   = (uint16_t) line;
+  slot->ev.events = (uint16_t) events;
+  atomic_store_explicit(&slot->seq, head + 1u, memory_order_release);
+  atomic_store_explicit(&b->head, head + 1u, memory_order_release);
+  return 1u;
+}
+
+/**
+ * \brief  Siguiente evento del filtro del suscriptor (lado consumidor).
+ * \return 1 si había un evento, 0 si no quedan.
+ */
+static inline uint32_t EXTI_BcastPoll(__EXTI_BCAST_t *b, int32_t id, __EXTI_EVENT_t *out)
+{
+  __EXTI_BCAST_SUB_t *s    = &b->sub[id];
+  uint32_t            cur  = atomic_load_explicit(&s->cursor, memory_order_relaxed);
+  uint32_t            head = atomic_load_explicit(&b->head, memory_order_acquire);
+  uint32_t            got  = 0u;
+
+  if (b->policy == kEXTI_BCAST_BLOCK) {
+    /* El productor no pisa ranuras sin leer: sin validación de secuencia */
+    while (cur != head) {
+      const __EXTI_EVENT_t *ev = &b->buf[cur & mEXTI_BCAST_INDEX].ev;
+
+      cur++;
+      if ((s->filter & EXTI_BCAST_LINE(ev->line)) != 0u) {
+        *out = *ev;
+        got  = 1u;
+        break;
+      }
+    }
+    atomic_store_explicit(&s->cursor, cur, memory_order_release);
+    return got;
+  }
+
+  while (cur != head) {
+    const __EXTI_BCAST_SLOT_t *slot = &b->buf[cur & mEXTI_BCAST_INDEX];
+    __EXTI_EVENT_t             ev;
+
+    if ((head - cur) > kEXTI_BCAST_SIZE) {
+      /* Lo anterior a head - SIZE ya no existe */
+      s->lost += (head - cur) - kEXTI_BCAST_SIZE;
+      cur      = head - kEXTI_BCAST_SIZE;
+      continue;
+    }
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != cur + 1u) {
+      /* Ranura reescrita por una vuelta posterior: head >= cur + SIZE. Con head = cur + SIZE
+       * (ranura a medio escribir) se pierde solo este evento; si no, lo resuelve la rama
+       * anterior */
+      head = atomic_load_explicit(&b->head, memory_order_acquire);
+      if ((head - cur) == kEXTI_BCAST_SIZE) {
+        cur++;
+        s->lost++;
+      }
+      continue;
+    }
+    ev = slot->ev;
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&slot->seq, memory_order_relaxed) != cur + 1u) {
+      continue;
+    }
+    cur++;
+    if ((s->filter & EXTI_BCAST_LINE(ev.line)) != 0u) {
+      *out = ev;
+      got  = 1u;
+      break;
+    }
+  }
+  atomic_store_explicit(&s->cursor, cur, memory_order_release);
+  return got;
+}
+
+/**
+ * \brief  Eventos pendientes de leer por el suscriptor (incluidos los de fuera de su filtro).
+ */
+static inline uint32_t EXTI_BcastBacklog(__EXTI_BCAST_t *b, int32_t id)
+{
+  return atomic_load_explicit(&b->head, memory_order_acquire)
+       - atomic_load_explicit(&b->sub[id].cursor, memory_order_acquire);
+}
+
+#endif /* EXTI_BCAST_H_ */
@@ -0,0 +1,78 @@
+/**
+ * \file EXTI_claim.c
+ * \brief Imagen de arranque y tabla de propietarios de las líneas reclamadas (EXTI_claim.h).
+ */
+
+#include "EXTI_claim.h"
+
+/* NVIC_ISER: en el host, el modelo de EXTI_sim.h */
+#ifdef EXTI_SIM
+#include "EXTI_sim.h"
+#define EXTI_CLAIM_ISER_SET(n, m)  (sEXTI_SIM_NVIC.ISER[n] |= (m))
+#else
+#define EXTI_CLAIM_ISER_SET(n, m)  (((volatile uint32_t *) 0xE000E100UL)[n] = (m))
+#endif
+
+/**
+ * \brief  Línea reclamada: una fila de EXTI_CLAIMS(X).
+ */
+typedef struct {
+  const char      *owner;
+  uint8_t          line;
+  uint8_t          delivery;
+  uint16_t         trigger;
+  __EXTI_HANDLER_t fn;
+  void            *ctx;
+} __EXTI_CLAIM_t;
+
+#define EXTI_CLAIM_ROW_(o, line, trig, dlv, fn, ctx)   \
+  { #o, (uint8_t) (line), (uint8_t) (dlv), (uint16_t) (trig), (fn), (ctx) },
+
+static const __EXTI_CLAIM_t kEXTI_CLAIM_TABLE[] = {
+  EXTI_CLAIMS(EXTI_CLAIM_ROW_)
+};
+
+const __EXTI_IMAGE_t kEXTI_CLAIM_IMAGE = {
+  .imr1  = (uint32_t) kEXTI_CLAIM_IRQ_SET,
+  .emr1  = (uint32_t) kEXTI_CLAIM_EVENT_SET,
+  .rtsr1 = (uint32_t) kEXTI_CLAIM_RISING,
+  .ftsr1 = (uint32_t) kEXTI_CLAIM_FALLING,
+  .imr2  = (uint32_t) (kEXTI_CLAIM_IRQ_SET >> 32),
+  .emr2  = (uint32_t) (kEXTI_CLAIM_EVENT_SET >> 32),
+  .rtsr2 = (uint32_t) (kEXTI_CLAIM_RISING >> 32),
+  .ftsr2 = (uint32_t) (kEXTI_CLAIM_FALLING >> 32),
+};
+
+void EXTI_ClaimInit(void)
+{
+  EXTI_LineInitImage(&kEXTI_CLAIM_IMAGE);
+
+  for (uint32_t i = 0u; i < kEXTI_CLAIM_COUNT; i++) {
+    const __EXTI_CLAIM_t *c = &kEXTI_CLAIM_TABLE[i];
+
+    sEXTI_SLOTS[c->line].fn      = c->fn;
+    sEXTI_SLOTS[c->line].ctx     = c->ctx;
+    sEXTI_SLOTS[c->line].trigger = c->trigger;
+  }
+
+  /* Constantes: las palabras sin vectores no se escriben */
+  if (kEXTI_CLAIM_ISER0 != 0u) {
+    EXTI_CLAIM_ISER_SET(0u, kEXTI_CLAIM_ISER0);
+  }
+  if (kEXTI_CLAIM_ISER1 != 0u) {
+    EXTI_CLAIM_ISER_SET(1u, kEXTI_CLAIM_ISER1);
+  }
+  if (kEXTI_CLAIM_ISER2 != 0u) {
+    EXTI_CLAIM_ISER_SET(2u, kEXTI_CLAIM_ISER2);
+  }
+}
+
+const char *EXTI_ClaimOwner(uint32_t line)
+{
+  for (uint32_t i = 0u; i < kEXTI_CLAIM_COUNT; i++) {
+    if (kEXTI_CLAIM_TABLE[i].line == line) {
+      return kEXTI_CLAIM_TABLE[i].owner;
+    }
+  }
+  return NULL;
+}
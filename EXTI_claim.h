@@ -0,0 +1,170 @@
+/**
+ * \file EXTI_claim.h
+ * \brief Reparto de líneas EXTI entre módulos, comprobado en compilación, e imagen de
+ * arranque única para STM32L4.
+ * \details Cada módulo del firmware declara en su cabecera las líneas que usa con una
+ * X-macro propia, sin llamar a EXTI_LineConfig() en su inicialización:
+ *
+ *   #define SENSOR_EXTI_CLAIMS(X)                                                   \
+ *     X(sensor, 5, kEXTI_TRIG_EDGE_RISING, kEXTI_CLAIM_IRQ, sensor_drdy, NULL)
+ *
+ * con X(propietario, línea, disparo, entrega, manejador, contexto): la línea es un literal
+ * sin sufijo (5, no 5u), la entrega kEXTI_CLAIM_IRQ (IMRx, vector y manejador),
+ * kEXTI_CLAIM_EVENT (EMRx, despertar de WFE sin vector) o ambas, y el contexto una
+ * constante de dirección (o NULL). La aplicación compone todas las tablas en
+ * EXTI_CLAIMS(X) en el fichero EXTI_CLAIMS_CONFIG (por defecto EXTI_claims_cfg.h). A
+ * partir de esa composición:
+ *  - En compilación se rechazan dos módulos que reclaman la misma línea (el error nombra la
+ *    línea: redeclaración de kEXTI_CLAIM_LINE_<n>), líneas que no existen en la variante,
+ *    disparos por nivel, flancos en líneas directas, líneas configurables sin flanco,
+ *    entregas vacías y la línea reservada de EXTI_DEFER; con EXTI_STATIC, también las
+ *    interrupciones en líneas GPIO, que atiende la tabla de EXTI_static.h.
+ *  - Las máscaras de IMRx, EMRx, RTSRx, FTSRx y NVIC_ISERn son expresiones constantes.
+ *  - EXTI_ClaimInit() sustituye a EXTI_LineInit() y a las inicializaciones EXTI de cada
+ *    módulo: aplica la imagen con una escritura por registro (EXTI_LineInitImage()),
+ *    rellena los slots de las líneas reclamadas y habilita los vectores con una escritura
+ *    por palabra de NVIC_ISER.
+ *
+ * Tras EXTI_ClaimInit() la API de líneas sigue disponible para cambios en ejecución
+ * (EXTI_LineDisable(), reconfiguración de una línea propia...).
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_CLAIM_H_
+#define EXTI_CLAIM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "EXTI_line.h"
+
+#if EXTI_PORT != EXTI_PORT_STM32L4
+#error "EXTI_claim.h: solo para el backend STM32L4"
+#endif
+
+/* Entrega de una línea reclamada */
+#define kEXTI_CLAIM_IRQ       (1u << 0)   /*!< IMRx: petición de interrupción al vector */
+#define kEXTI_CLAIM_EVENT     (1u << 1)   /*!< EMRx: evento hacia el núcleo (WFE) */
+
+#ifndef EXTI_CLAIMS_CONFIG
+#define EXTI_CLAIMS_CONFIG    "EXTI_claims_cfg.h"
+#endif
+#include EXTI_CLAIMS_CONFIG
+
+#ifndef EXTI_CLAIMS
+#error "EXTI_CLAIMS_CONFIG debe definir EXTI_CLAIMS(X)"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bit de una línea en una palabra de 64 bits (bit n = línea n, como __EXTI_WAKE_SET_t) */
+#define EXTI_CLAIM_BIT(line)  ((uint64_t) 1u << ((line) & 63u))
+
+#define EXTI_CLAIM_OR_(o, line, trig, dlv, fn, ctx)      | EXTI_CLAIM_BIT(line)
+#define EXTI_CLAIM_SUM_(o, line, trig, dlv, fn, ctx)     + EXTI_CLAIM_BIT(line)
+#define EXTI_CLAIM_ONE_(o, line, trig, dlv, fn, ctx)     + 1u
+#define EXTI_CLAIM_RANGE_(o, line, trig, dlv, fn, ctx)   + ((line) > kEXTI_MAX_LINE)
+#define EXTI_CLAIM_IF_(cond, line)                       (((cond) != 0u) ? EXTI_CLAIM_BIT(line) : 0u)
+#define EXTI_CLAIM_IRQ_(o, line, trig, dlv, fn, ctx)     | EXTI_CLAIM_IF_((dlv) & kEXTI_CLAIM_IRQ, line)
+#define EXTI_CLAIM_EVENT_(o, line, trig, dlv, fn, ctx)   | EXTI_CLAIM_IF_((dlv) & kEXTI_CLAIM_EVENT, line)
+#define EXTI_CLAIM_RISE_(o, line, trig, dlv, fn, ctx)    | EXTI_CLAIM_IF_((trig) & kEXTI_TRIG_EDGE_RISING, line)
+#define EXTI_CLAIM_FALL_(o, line, trig, dlv, fn, ctx)    | EXTI_CLAIM_IF_((trig) & kEXTI_TRIG_EDGE_FALLING, line)
+#define EXTI_CLAIM_LEVEL_(o, line, trig, dlv, fn, ctx)   | EXTI_CLAIM_IF_((trig) & mEXTI_TRIG_LEVEL, line)
+#define EXTI_CLAIM_NOEDGE_(o, line, trig, dlv, fn, ctx)  | EXTI_CLAIM_IF_(((trig) & mEXTI_TRIG_EDGE) == 0u, line)
+#define EXTI_CLAIM_BADDLV_(o, line, trig, dlv, fn, ctx)  \
+  | EXTI_CLAIM_IF_((((dlv) & (kEXTI_CLAIM_IRQ | kEXTI_CLAIM_EVENT)) == 0u) || \
+                   (((dlv) & ~(kEXTI_CLAIM_IRQ | kEXTI_CLAIM_EVENT)) != 0u), line)
+
+/* Máscaras de la composición (expresiones constantes) */
+#define kEXTI_CLAIM_COUNT     (0u EXTI_CLAIMS(EXTI_CLAIM_ONE_))
+#define kEXTI_CLAIM_LINES     ((uint64_t) 0u EXTI_CLAIMS(EXTI_CLAIM_OR_))
+#define kEXTI_CLAIM_IRQ_SET   ((uint64_t) 0u EXTI_CLAIMS(EXTI_CLAIM_IRQ_))
+#define kEXTI_CLAIM_EVENT_SET ((uint64_t) 0u EXTI_CLAIMS(EXTI_CLAIM_EVENT_))
+#define kEXTI_CLAIM_RISING    ((uint64_t) 0u EXTI_CLAIMS(EXTI_CLAIM_RISE_))
+#define kEXTI_CLAIM_FALLING   ((uint64_t) 0u EXTI_CLAIMS(EXTI_CLAIM_FALL_))
+
+#define kEXTI_CLAIM_VALID     (((uint64_t) kEXTI_VAR_LINES2 << 32) | kEXTI_VAR_LINES1)
+#define kEXTI_CLAIM_CONFIG    (((uint64_t) kEXTI_VAR_CONFIG2 << 32) | kEXTI_VAR_CONFIG1)
+
+/* NVIC_ISERn de los vectores con líneas entregadas como interrupción */
+#define EXTI_CLAIM_ISER_BIT_(n, irqn, hit)  \
+  ((((hit) != 0u) && (((irqn) >> 5) == (n))) ? (1u << ((irqn) & 31u)) : 0u)
+#define EXTI_CLAIM_ISER_SRC_(n, line, irqn) \
+  | EXTI_CLAIM_ISER_BIT_(n, irqn, kEXTI_CLAIM_IRQ_SET & EXTI_CLAIM_BIT(line))
+#define EXTI_CLAIM_ISER_VEC_(n, irqn, mask) \
+  | EXTI_CLAIM_ISER_BIT_(n, irqn, kEXTI_CLAIM_IRQ_SET & (uint64_t) (mask))
+#define EXTI_CLAIM_ISER0_SRC_(line, name, irqn)  EXTI_CLAIM_ISER_SRC_(0u, line, irqn)
+#define EXTI_CLAIM_ISER1_SRC_(line, name, irqn)  EXTI_CLAIM_ISER_SRC_(1u, line, irqn)
+#define EXTI_CLAIM_ISER2_SRC_(line, name, irqn)  EXTI_CLAIM_ISER_SRC_(2u, line, irqn)
+#define EXTI_CLAIM_ISER0_VEC_(name, irqn, mask)  EXTI_CLAIM_ISER_VEC_(0u, irqn, mask)
+#define EXTI_CLAIM_ISER1_VEC_(name, irqn, mask)  EXTI_CLAIM_ISER_VEC_(1u, irqn, mask)
+#define EXTI_CLAIM_ISER2_VEC_(name, irqn, mask)  EXTI_CLAIM_ISER_VEC_(2u, irqn, mask)
+
+#define kEXTI_CLAIM_ISER0     \
+  (0u EXTI_VAR_GPIO_VECTORS(EXTI_CLAIM_ISER0_VEC_) EXTI_VAR_SOURCES(EXTI_CLAIM_ISER0_SRC_))
+#define kEXTI_CLAIM_ISER1     \
+  (0u EXTI_VAR_GPIO_VECTORS(EXTI_CLAIM_ISER1_VEC_) EXTI_VAR_SOURCES(EXTI_CLAIM_ISER1_SRC_))
+#define kEXTI_CLAIM_ISER2     \
+  (0u EXTI_VAR_GPIO_VECTORS(EXTI_CLAIM_ISER2_VEC_) EXTI_VAR_SOURCES(EXTI_CLAIM_ISER2_SRC_))
+
+#ifdef __cplusplus
+#define EXTI_CLAIM_ASSERT_(c, msg)   static_assert(c, msg)
+#else
+#define EXTI_CLAIM_ASSERT_(c, msg)   _Static_assert(c, msg)
+#endif
+
+/* Una línea, un propietario: el compilador señala la línea repetida */
+#define EXTI_CLAIM_ENUM_(o, line, trig, dlv, fn, ctx)    kEXTI_CLAIM_LINE_##line,
+enum { EXTI_CLAIMS(EXTI_CLAIM_ENUM_) kEXTI_CLAIM_LINE_END_ };
+
+EXTI_CLAIM_ASSERT_(kEXTI_CLAIM_COUNT != 0u, "EXTI_CLAIMS: composicion vacia");
+EXTI_CLAIM_ASSERT_((0u EXTI_CLAIMS(EXTI_CLAIM_RANGE_)) == 0u,
+                   "EXTI_CLAIMS: linea fuera del bloque EXTI (0-40)");
+EXTI_CLAIM_ASSERT_(((uint64_t) 0u EXTI_CLAIMS(EXTI_CLAIM_SUM_)) == kEXTI_CLAIM_LINES,
+                   "EXTI_CLAIMS: linea reclamada por mas de un modulo");
+EXTI_CLAIM_ASSERT_((kEXTI_CLAIM_LINES & ~kEXTI_CLAIM_VALID) == 0u,
+                   "EXTI_CLAIMS: linea no disponible en esta variante");
+EXTI_CLAIM_ASSERT_(((uint64_t) 0u EXTI_CLAIMS(EXTI_CLAIM_LEVEL_)) == 0u,
+                   "EXTI_CLAIMS: EXTI solo detecta flancos");
+EXTI_CLAIM_ASSERT_(((kEXTI_CLAIM_RISING | kEXTI_CLAIM_FALLING) & ~kEXTI_CLAIM_CONFIG) == 0u,
+                   "EXTI_CLAIMS: flanco en una linea directa (el evento lo define el periferico)");
+EXTI_CLAIM_ASSERT_((((uint64_t) 0u EXTI_CLAIMS(EXTI_CLAIM_NOEDGE_)) & kEXTI_CLAIM_CONFIG) == 0u,
+                   "EXTI_CLAIMS: linea configurable sin flanco");
+EXTI_CLAIM_ASSERT_(((uint64_t) 0u EXTI_CLAIMS(EXTI_CLAIM_BADDLV_)) == 0u,
+                   "EXTI_CLAIMS: entrega distinta de kEXTI_CLAIM_IRQ / kEXTI_CLAIM_EVENT");
+#ifdef EXTI_DEFER
+EXTI_CLAIM_ASSERT_((kEXTI_CLAIM_LINES & EXTI_CLAIM_BIT(kEXTI_DEFER_LINE)) == 0u,
+                   "EXTI_CLAIMS: kEXTI_DEFER_LINE esta reservada para el despacho diferido");
+#endif
+#ifdef EXTI_STATIC
+EXTI_CLAIM_ASSERT_((kEXTI_CLAIM_IRQ_SET & 0xFFFFu) == 0u,
+                   "EXTI_CLAIMS: con EXTI_STATIC las interrupciones GPIO van en EXTI_static.h");
+#endif
+
+/**
+ * \brief  Aplica la composición: imagen de registros, slots de las líneas reclamadas y
+ *         vectores del NVIC. Sustituye a EXTI_LineInit().
+ */
+void EXTI_ClaimInit(void);
+
+/**
+ * \brief  Imagen de registros de la composición (la que aplica EXTI_ClaimInit()).
+ */
+extern const __EXTI_IMAGE_t kEXTI_CLAIM_IMAGE;
+
+/**
+ * \brief  Módulo propietario de una línea (nombre de la composición), NULL si está libre.
+ */
+const char *EXTI_ClaimOwner(uint32_t line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_CLAIM_H_ */
@@ -0,0 +1,48 @@
+/**
+ * \file EXTI_claims_cfg.h
+ * \brief Composición de las líneas EXTI que reclama cada módulo del firmware (EXTI_claim.h).
+ * \details Cada módulo exporta en su cabecera una tabla <MÓDULO>_EXTI_CLAIMS(X) y los
+ * prototipos de sus manejadores; este fichero incluye esas cabeceras y compone las tablas en
+ * EXTI_CLAIMS(X). Dos módulos que reclaman la misma línea detienen la compilación.
+ *
+ * El ejemplo declara las tablas aquí mismo. Cada aplicación mantiene su propia copia; la
+ * ruta se indica con EXTI_CLAIMS_CONFIG.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_CLAIMS_CFG_H_
+#define EXTI_CLAIMS_CFG_H_
+
+/* Manejadores de los módulos (en la aplicación, desde la cabecera de cada módulo) */
+void buttons_exti(uint32_t line, uint32_t events, void *ctx);
+void imu_drdy(uint32_t line, uint32_t events, void *ctx);
+void radio_irq(uint32_t line, uint32_t events, void *ctx);
+void clock_wakeup(uint32_t line, uint32_t events, void *ctx);
+
+/* X(propietario, línea sin sufijo, disparo, entrega, manejador, contexto) */
+#define BUTTONS_EXTI_CLAIMS(X)                                                          \
+  X(buttons, 0,  kEXTI_TRIG_EDGE_FALLING, kEXTI_CLAIM_IRQ,   buttons_exti, NULL)        \
+  X(buttons, 13, kEXTI_TRIG_EDGE_BOTH,    kEXTI_CLAIM_IRQ,   buttons_exti, NULL)
+
+#define IMU_EXTI_CLAIMS(X)                                                              \
+  X(imu,     5,  kEXTI_TRIG_EDGE_RISING,  kEXTI_CLAIM_IRQ,   imu_drdy,     NULL)        \
+  X(imu,     6,  kEXTI_TRIG_EDGE_RISING,  kEXTI_CLAIM_EVENT, NULL,         NULL)
+
+#define RADIO_EXTI_CLAIMS(X)                                                            \
+  X(radio,   8,  kEXTI_TRIG_EDGE_RISING,  kEXTI_CLAIM_IRQ,   radio_irq,    NULL)
+
+#define CLOCK_EXTI_CLAIMS(X)                                                            \
+  X(clock,   20, kEXTI_TRIG_EDGE_RISING,  kEXTI_CLAIM_IRQ,   clock_wakeup, NULL)        \
+  X(clock,   32, 0u,                      kEXTI_CLAIM_IRQ,   NULL,         NULL)
+
+#define EXTI_CLAIMS(X)                \
+  BUTTONS_EXTI_CLAIMS(X)              \
+  IMU_EXTI_CLAIMS(X)                  \
+  RADIO_EXTI_CLAIMS(X)                \
+  CLOCK_EXTI_CLAIMS(X)
+
+#endif /* EXTI_CLAIMS_CFG_H_ */
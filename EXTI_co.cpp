@@ -0,0 +1,127 @@
+/**
+ * \file EXTI_co.cpp
+ * \brief Planificador estático de las esperas de flanco con corrutinas (EXTI_co.h).
+ */
+
+#include "EXTI_co.h"
+
+namespace exti {
+
+alignas(std::max_align_t) static unsigned char sEXTI_CO_POOL[kEXTI_CO_FRAMES][kEXTI_CO_FRAME_SIZE];
+
+scheduler::waiter  scheduler::sWaiters[kEXTI_CO_WAITERS];
+volatile uint32_t  scheduler::sArmed;
+uint32_t           scheduler::sFrames;
+
+__EXTI_STATUS_t scheduler::attach(uint32_t line, uint32_t trigger)
+{
+  __EXTI_STATUS_t status = EXTI_LineConfig(line, trigger, &scheduler::on_line, nullptr);
+
+  if (status == kEXTI_OK) {
+    EXTI_LineEnable(line);
+  }
+  return status;
+}
+
+bool scheduler::arm(edge_awaiter *a, std::coroutine_handle<> h) noexcept
+{
+  uint32_t free = ~sArmed & ((kEXTI_CO_WAITERS < 32u) ? ((1u << kEXTI_CO_WAITERS) - 1u) : ~0u);
+  uint32_t i;
+
+  if ((free == 0u) || ((a->line_ != kEXTI_CO_NO_LINE) && (a->line_ >= kEXTI_LINE_COUNT))) {
+    return false;
+  }
+  i = static_cast<uint32_t>(__builtin_ctz(free));
+
+  waiter &w  = sWaiters[i];
+  w.line     = a->line_;
+  w.mask     = a->mask_;
+  w.timed    = (a->timeout_ != kEXTI_CO_FOREVER);
+  w.deadline = EXTI_TIMESTAMP() + a->timeout_;
+  w.awaiter  = a;
+  w.handle   = h;
+  w.events   = 0u;
+  w.ts       = 0u;
+
+  /* La ISR solo mira las entradas armadas: se publica la entrada completa */
+  __atomic_signal_fence(__ATOMIC_RELEASE);
+  sArmed = sArmed | (1u << i);
+  return true;
+}
+
+void scheduler::on_line(uint32_t line, uint32_t events, void *ctx)
+{
+  uint32_t armed = sArmed;
+  uint32_t ts    = EXTI_TIMESTAMP();
+
+  (void) ctx;
+  while (armed != 0u) {
+    waiter &w = sWaiters[__builtin_ctz(armed)];
+
+    armed &= armed - 1u;
+    if ((w.line == line) && ((events & w.mask) != 0u) && (w.events == 0u)) {
+      w.ts     = ts;
+      w.events = events & w.mask;
+    }
+  }
+}
+
+uint32_t scheduler::run()
+{
+  uint32_t armed   = sArmed;
+  uint32_t now     = EXTI_TIMESTAMP();
+  uint32_t resumed = 0u;
+
+  while (armed != 0u) {
+    uint32_t i   = static_cast<uint32_t>(__builtin_ctz(armed));
+    waiter  &w   = sWaiters[i];
+    uint32_t ev  = w.events;
+
+    armed &= armed - 1u;
+    if (ev != 0u) {
+      w.awaiter->result_ = edge_result{ ev, w.ts };
+    } else if (w.timed && (static_cast<int32_t>(now - w.deadline) >= 0)) {
+      w.awaiter->result_ = edge_result{ 0u, now };
+    } else {
+      continue;
+    }
+    sArmed = sArmed & ~(1u << i);
+    resumed++;
+    w.handle.resume();
+  }
+  return resumed;
+}
+
+uint32_t scheduler::waiting() noexcept
+{
+  return static_cast<uint32_t>(__builtin_popcount(sArmed));
+}
+
+uint32_t scheduler::frames() noexcept
+{
+  return static_cast<uint32_t>(__builtin_popcount(sFrames));
+}
+
+void *scheduler::frame_alloc(std::size_t n) noexcept
+{
+  /* Máscara en dos desplazamientos: válida también con 32 marcos */
+  uint32_t free = ~sFrames & ((1u << (kEXTI_CO_FRAMES - 1u) << 1) - 1u);
+  uint32_t i;
+
+  if ((n > kEXTI_CO_FRAME_SIZE) || (free == 0u)) {
+    return nullptr;
+  }
+  i = static_cast<uint32_t>(__builtin_ctz(free));
+  sFrames |= 1u << i;
+  return sEXTI_CO_POOL[i];
+}
+
+void scheduler::frame_free(void *p) noexcept
+{
+  std::size_t i = static_cast<std::size_t>(static_cast<unsigned char *>(p) - &sEXTI_CO_POOL[0][0])
+                / kEXTI_CO_FRAME_SIZE;
+
+  sFrames &= ~(1u << i);
+}
+
+} /* namespace exti */
@@ -0,0 +1,198 @@
+/**
+ * \file EXTI_co.h
+ * \brief Esperas de flanco con corrutinas de C++20: co_await exti::edge(linea, Edge::Rising, t).
+ * \details Permite escribir protocolos (handshakes, lecturas de pulsos) como código secuencial
+ * en lugar de máquinas de estados a mano, sin memoria dinámica:
+ *
+ *  - Los marcos de corrutina salen de un pool estático (kEXTI_CO_FRAMES marcos de
+ *    kEXTI_CO_FRAME_SIZE bytes). Si el marco no cabe o el pool está agotado, la tarea no
+ *    arranca y exti::task::valid() devuelve false.
+ *  - Cada co_await ocupa una de las kEXTI_CO_WAITERS entradas de espera estáticas.
+ *  - El manejador de línea (ISR) solo anota evento y marca de tiempo en la entrada; la
+ *    reanudación la hace exti::scheduler::run() desde el bucle principal, nunca en la ISR.
+ *
+ * La ISR y run() deben ejecutarse en el mismo núcleo: la ISR se ve como atómica desde run().
+ * Las líneas se asocian al planificador con exti::scheduler::attach(), que registra el
+ * manejador en EXTI_line. Los plazos se expresan en ticks de EXTI_TIMESTAMP() (EXTI_time.h);
+ * kEXTI_CO_FOREVER espera sin plazo.
+ *
+ * Ejemplo:
+ *   exti::task handshake() {
+ *     for (;;) {
+ *       auto req = co_await exti::edge(3, exti::Edge::Rising, 1000u);
+ *       if (req.timed_out()) continue;
+ *       ...
+ *     }
+ *   }
+ *
+ * Requiere C++20 (-std=c++20; en arm-none-eabi-g++ también con -fno-exceptions).
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_CO_H_
+#define EXTI_CO_H_
+
+#if !defined(__cplusplus) || (__cplusplus < 202002L)
+#error "EXTI_co.h requiere C++20"
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+#include "EXTI_line.h"
+#include "EXTI_time.h"
+
+#ifndef kEXTI_CO_FRAMES
+#define kEXTI_CO_FRAMES       (4u)     /*!< Corrutinas vivas simultáneamente */
+#endif
+#ifndef kEXTI_CO_FRAME_SIZE
+#define kEXTI_CO_FRAME_SIZE   (256u)   /*!< Bytes por marco (locales vivas + promesa + estado) */
+#endif
+#ifndef kEXTI_CO_WAITERS
+#define kEXTI_CO_WAITERS      (8u)     /*!< co_await pendientes simultáneamente */
+#endif
+
+#define kEXTI_CO_FOREVER      (0u)
+#define kEXTI_CO_NO_LINE      (0xFFFFFFFFu)
+
+static_assert((kEXTI_CO_FRAMES >= 1u) && (kEXTI_CO_FRAMES <= 32u), "kEXTI_CO_FRAMES: 1..32");
+static_assert(kEXTI_CO_WAITERS <= 32u, "kEXTI_CO_WAITERS > 32");
+
+namespace exti {
+
+/** \brief Flanco esperado (codificación kEXTI_TRIG_*). */
+enum class Edge : uint32_t {
+  Falling = kEXTI_TRIG_EDGE_FALLING,
+  Rising  = kEXTI_TRIG_EDGE_RISING,
+  Both    = kEXTI_TRIG_EDGE_BOTH
+};
+
+/** \brief Resultado de una espera: eventos observados (0 si venció el plazo) y su marca. */
+struct edge_result {
+  uint32_t events;
+  uint32_t ts;
+
+  bool timed_out() const noexcept { return events == 0u; }
+  explicit operator bool() const noexcept { return events != 0u; }
+};
+
+class edge_awaiter;
+
+/**
+ * \brief  Planificador estático: entradas de espera, pool de marcos y reanudación.
+ */
+class scheduler {
+public:
+  /** \brief Configura la línea con el disparo dado, la asocia al planificador y la habilita. */
+  static __EXTI_STATUS_t attach(uint32_t line, uint32_t trigger);
+
+  /**
+   * \brief  Reanuda las corrutinas cuyo flanco llegó o cuyo plazo venció.
+   * \return Número de corrutinas reanudadas.
+   */
+  static uint32_t run();
+
+  /** \brief Esperas armadas. */
+  static uint32_t waiting() noexcept;
+
+  /** \brief Marcos de corrutina en uso. */
+  static uint32_t frames() noexcept;
+
+  /** \brief Manejador de línea registrado por attach() (contexto de ISR). */
+  static void on_line(uint32_t line, uint32_t events, void *ctx);
+
+  static void *frame_alloc(std::size_t n) noexcept;
+  static void  frame_free(void *p) noexcept;
+
+private:
+  friend class edge_awaiter;
+
+  struct waiter {
+    uint32_t                line;      /*!< kEXTI_CO_NO_LINE para una espera sin línea */
+    uint32_t                mask;      /*!< Flancos aceptados */
+    uint32_t                deadline;  /*!< Marca límite (si timed) */
+    uint32_t                timed;
+    edge_awaiter           *awaiter;
+    std::coroutine_handle<> handle;
+    volatile uint32_t       events;    /*!< Escrito por la ISR */
+    volatile uint32_t       ts;        /*!< Escrito por la ISR */
+  };
+
+  static bool arm(edge_awaiter *a, std::coroutine_handle<> h) noexcept;
+
+  static waiter            sWaiters[kEXTI_CO_WAITERS];
+  static volatile uint32_t sArmed;     /*!< Bit i: entrada i armada (solo la escribe run/arm) */
+  static uint32_t          sFrames;    /*!< Bit i: marco i ocupado */
+};
+
+/**
+ * \brief  Awaitable de flanco. Se crea con exti::edge() o exti::delay().
+ */
+class edge_awaiter {
+public:
+  edge_awaiter(uint32_t line, uint32_t mask, uint32_t timeout) noexcept
+    : line_(line), mask_(mask), timeout_(timeout), result_{0u, 0u} {}
+
+  bool await_ready() const noexcept { return false; }
+
+  /* Sin entrada libre no se suspende: se reanuda al momento con events = 0 */
+  bool await_suspend(std::coroutine_handle<> h) noexcept { return scheduler::arm(this, h); }
+
+  edge_result await_resume() const noexcept { return result_; }
+
+private:
+  friend class scheduler;
+
+  uint32_t    line_;
+  uint32_t    mask_;
+  uint32_t    timeout_;
+  edge_result result_;
+};
+
+/** \brief Espera un flanco en la línea (asociada con scheduler::attach) o el plazo en ticks. */
+inline edge_awaiter edge(uint32_t line, Edge e, uint32_t timeout = kEXTI_CO_FOREVER) noexcept
+{
+  return edge_awaiter(line, static_cast<uint32_t>(e), timeout);
+}
+
+/** \brief Espera ticks sin línea asociada. */
+inline edge_awaiter delay(uint32_t ticks) noexcept
+{
+  return edge_awaiter(kEXTI_CO_NO_LINE, 0u, (ticks != 0u) ? ticks : 1u);
+}
+
+/**
+ * \brief  Tarea de corrutina sin propietario: arranca al crearse, corre hasta su primer
+ * co_await y libera su marco al terminar.
+ */
+class task {
+public:
+  struct promise_type {
+    static void *operator new(std::size_t n) noexcept { return scheduler::frame_alloc(n); }
+    static void  operator delete(void *p) noexcept { scheduler::frame_free(p); }
+
+    static task get_return_object_on_allocation_failure() noexcept { return task(false); }
+    task get_return_object() noexcept { return task(true); }
+
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { for (;;) {} }
+  };
+
+  bool valid() const noexcept { return valid_; }
+
+private:
+  explicit task(bool valid) noexcept : valid_(valid) {}
+
+  bool valid_;
+};
+
+} /* namespace exti */
+
+#endif /* EXTI_CO_H_ */
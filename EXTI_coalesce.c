@@ -0,0 +1,87 @@
+/**
+ * \file EXTI_coalesce.c
+ * \brief Agrupación de flancos por línea en ventanas (EXTI_coalesce.h).
+ */
+
+#include <stddef.h>
+
+#include "EXTI_coalesce.h"
+#include "EXTI_crit.h"
+#include "EXTI_time.h"
+
+/* IMR1/INTE se modifican con lectura-escritura: se protegen frente a otras ISRs de línea */
+static void coal_enable(uint32_t line, uint32_t enable)
+{
+  uint32_t s = EXTI_CRIT_ENTER();
+
+  EXTI_PORT_Enable(line, enable);
+  EXTI_CRIT_EXIT(s);
+}
+
+static void coal_close(__EXTI_TIMER_t *t, void *ctx)
+{
+  __EXTI_COAL_t *c      = (__EXTI_COAL_t *) ctx;
+  uint32_t       events = EXTI_PORT_Pending(c->ev.line);
+
+  (void) t;
+  if (events != 0u) {
+    c->ev.count++;
+    c->ev.events |= (uint16_t) events;
+    c->ev.last    = EXTI_TIMESTAMP();
+    if (++c->windows < c->max_windows) {
+      EXTI_TimerStart(&sEXTI_WHEEL, &c->timer, c->timer.expires + c->window);
+      return;
+    }
+  }
+
+  if (c->fn != NULL) {
+    c->fn(&c->ev, c->ctx);
+  }
+  /* Un flanco entre la lectura de PR y este punto pide la IRQ nada más habilitar */
+  coal_enable(c->ev.line, 1u);
+}
+
+__EXTI_STATUS_t EXTI_CoalesceAttach(__EXTI_COAL_t *c, uint32_t line, uint32_t trigger,
+                                    uint32_t window, __EXTI_COAL_FN_t fn, void *ctx)
+{
+  __EXTI_STATUS_t status;
+
+  if (window == 0u) {
+    return kEXTI_ERR_TRIGGER;
+  }
+  EXTI_TimerInit(&c->timer, coal_close, c);
+  c->ev.line      = (uint16_t) line;
+  c->window       = window;
+  c->max_windows  = kEXTI_COAL_MAX_WINDOWS;
+  c->windows      = 0u;
+  c->fn           = fn;
+  c->ctx          = ctx;
+
+  status = EXTI_LineConfig(line, trigger, EXTI_CoalesceEdge, c);
+  if (status == kEXTI_OK) {
+    coal_enable(line, 1u);
+  }
+  return status;
+}
+
+void EXTI_CoalesceDetach(__EXTI_COAL_t *c)
+{
+  coal_enable(c->ev.line, 0u);
+  (void) EXTI_TimerCancel(&sEXTI_WHEEL, &c->timer);
+  (void) EXTI_PORT_Pending(c->ev.line);
+}
+
+void EXTI_CoalesceEdge(uint32_t line, uint32_t events, void *ctx)
+{
+  __EXTI_COAL_t *c  = (__EXTI_COAL_t *) ctx;
+  uint32_t       ts = EXTI_TIMESTAMP();
+
+  /* La línea queda deshabilitada hasta que se cierre la ventana */
+  coal_enable(line, 0u);
+  c->ev.first  = ts;
+  c->ev.last   = ts;
+  c->ev.count  = 1u;
+  c->ev.events = (uint16_t) events;
+  c->windows   = 0u;
+  EXTI_TimerStartIn(&sEXTI_WHEEL, &c->timer, c->window);
+}
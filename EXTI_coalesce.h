@@ -0,0 +1,91 @@
+/**
+ * \file EXTI_coalesce.h
+ * \brief Agrupación de flancos por línea en ventanas: un evento por ráfaga.
+ * \details Para líneas en las que solo importa "ha pasado algo" (contactos de puerta,
+ * sensores de presencia). El primer flanco abre una ventana de window ticks de sEXTI_WHEEL
+ * (contados desde EXTI_WheelNow(), no desde el último avance de la rueda) y
+ * deshabilita la interrupción de la línea (IMR1 en STM32L4, INTE en RP2040), de modo que el
+ * rebote o el ruido no vuelven a entrar en la ISR. Al cerrar la ventana:
+ *
+ *  - Si el hardware latcheó algún flanco mientras tanto (EXTI_PORT_Pending), se reconoce, se
+ *    cuenta y se abre otra ventana, hasta max_windows ventanas seguidas.
+ *  - Si no, o al alcanzar max_windows, se entrega un único evento con el número de flancos,
+ *    la marca del primero y la del último, y se vuelve a habilitar la línea.
+ *
+ * Con la línea deshabilitada el hardware solo retiene un flanco, así que count es una cota
+ * inferior (1 + ventanas con actividad) y last tiene la resolución de la ventana; first es
+ * exacto. El cierre se ejecuta en el contexto que avanza la rueda (tick o bucle sin tick),
+ * que se inicializa con EXTI_LoopInit() o EXTI_WaitInit().
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_COALESCE_H_
+#define EXTI_COALESCE_H_
+
+#include <stdint.h>
+
+#include "EXTI_line.h"
+#include "EXTI_wheel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define kEXTI_COAL_MAX_WINDOWS  (16u)   /*!< Ventanas seguidas por defecto antes de entregar */
+
+/**
+ * \brief  Evento agrupado.
+ */
+typedef struct {
+  uint32_t first;   /*!< EXTI_TIMESTAMP() del primer flanco */
+  uint32_t last;    /*!< EXTI_TIMESTAMP() del último flanco observado */
+  uint32_t count;   /*!< Flancos observados (cota inferior, ver \details) */
+  uint16_t line;
+  uint16_t events;  /*!< Unión de eventos kEXTI_TRIG_* */
+} __EXTI_COAL_EVENT_t;
+
+/**
+ * \brief  Entrega de un evento agrupado (contexto de la rueda).
+ */
+typedef void (*__EXTI_COAL_FN_t)(const __EXTI_COAL_EVENT_t *ev, void *ctx);
+
+/**
+ * \brief  Estado de agrupación de una línea (del llamador, sin memoria dinámica).
+ */
+typedef struct {
+  __EXTI_TIMER_t       timer;        /*!< Cierre de la ventana en sEXTI_WHEEL */
+  __EXTI_COAL_EVENT_t  ev;           /*!< Evento en curso */
+  uint32_t             window;       /*!< Ticks de sEXTI_WHEEL */
+  uint32_t             max_windows;
+  uint32_t             windows;      /*!< Ventanas del evento en curso */
+  __EXTI_COAL_FN_t     fn;
+  void                *ctx;
+} __EXTI_COAL_t;
+
+/**
+ * \brief  Configura la línea con el disparo dado en modo agrupado y la habilita.
+ * \param  window  Duración de cada ventana en ticks de sEXTI_WHEEL (> 0).
+ * \details max_windows queda en kEXTI_COAL_MAX_WINDOWS; puede cambiarse antes del primer flanco.
+ */
+__EXTI_STATUS_t EXTI_CoalesceAttach(__EXTI_COAL_t *c, uint32_t line, uint32_t trigger,
+                                    uint32_t window, __EXTI_COAL_FN_t fn, void *ctx);
+
+/**
+ * \brief  Deshabilita la línea y descarta el evento en curso.
+ */
+void EXTI_CoalesceDetach(__EXTI_COAL_t *c);
+
+/**
+ * \brief  Manejador de línea registrado por EXTI_CoalesceAttach() (contexto de ISR).
+ */
+void EXTI_CoalesceEdge(uint32_t line, uint32_t events, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_COALESCE_H_ */
@@ -0,0 +1,44 @@
+/**
+ * \file EXTI_crit.h
+ * \brief Secciones críticas cortas entre ISRs de distinta prioridad y el bucle principal.
+ * \details En Cortex-M (M0+ y M4) se guarda PRIMASK y se enmascaran las interrupciones con
+ * CPSID I; la salida restaura el valor guardado, por lo que las secciones se pueden anidar.
+ * En el host (simuladores, un solo hilo) las macros no hacen nada.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_CRIT_H_
+#define EXTI_CRIT_H_
+
+#include <stdint.h>
+
+#if defined(__ARM_ARCH)
+
+static inline uint32_t EXTI_CritEnter(void)
+{
+  uint32_t primask;
+
+  __asm volatile("mrs %0, primask\n\tcpsid i" : "=r"(primask) :: "memory");
+  return primask;
+}
+
+static inline void EXTI_CritExit(uint32_t primask)
+{
+  __asm volatile("msr primask, %0" :: "r"(primask) : "memory");
+}
+
+#define EXTI_CRIT_ENTER()     EXTI_CritEnter()
+#define EXTI_CRIT_EXIT(s)     EXTI_CritExit(s)
+
+#else
+
+#define EXTI_CRIT_ENTER()     (0u)
+#define EXTI_CRIT_EXIT(s)     ((void) (s))
+
+#endif
+
+#endif /* EXTI_CRIT_H_ */
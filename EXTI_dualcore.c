@@ -0,0 +1,126 @@
+/**
+ * \file EXTI_dualcore.c
+ * \brief Captura en el núcleo 0 y procesamiento en el núcleo 1 sobre una cola SPSC.
+ */
+
+#include <stddef.h>
+
+#include "EXTI_dualcore.h"
+
+#if (EXTI_PORT == EXTI_PORT_RP2040) && !defined(IO_BANK0_SIM)
+#include "pico/multicore.h"
+#define EXTI_DUAL_NOTIFY()    __sev()
+#define EXTI_DUAL_IDLE()      __wfe()
+#else
+#define EXTI_DUAL_NOTIFY()    ((void) 0)
+#define EXTI_DUAL_IDLE()      ((void) 0)
+#endif
+
+void EXTI_DualInit(__EXTI_DUAL_t *d)
+{
+  EXTI_RingInit(&d->ring);
+  for (uint32_t line = 0u; line < kEXTI_LINE_COUNT; line++) {
+    __EXTI_DUAL_LINE_t *l = &d->lines[line];
+
+    l->decode   = NULL;
+    l->ctx      = NULL;
+    l->debounce = 0u;
+    l->last_ts  = 0u;
+    l->accepted = 0u;
+    l->bounced  = 0u;
+    l->min_dt   = UINT32_MAX;
+    l->max_dt   = 0u;
+  }
+  d->latency_max = 0u;
+  d->latency_sum = 0u;
+  d->processed   = 0u;
+}
+
+__EXTI_STATUS_t EXTI_DualLineConfig(__EXTI_DUAL_t *d, uint32_t line, uint32_t trigger,
+                                    uint32_t debounce, __EXTI_DUAL_DECODE_t decode, void *ctx)
+{
+  __EXTI_STATUS_t status;
+
+  if (line >= kEXTI_LINE_COUNT) {
+    return kEXTI_ERR_LINE;
+  }
+  d->lines[line].decode   = decode;
+  d->lines[line].ctx      = ctx;
+  d->lines[line].debounce = debounce;
+
+  status = EXTI_LineConfig(line, trigger, EXTI_DualCapture, d);
+  if (status == kEXTI_OK) {
+    EXTI_LineEnable(line);
+  }
+  return status;
+}
+
+void EXTI_DualCapture(uint32_t line, uint32_t events, void *ctx)
+{
+  __EXTI_DUAL_t *d = (__EXTI_DUAL_t *) ctx;
+
+  if (EXTI_RingPush(&d->ring, EXTI_TIMESTAMP(), line, events)) {
+    EXTI_DUAL_NOTIFY();
+  }
+}
+
+uint32_t EXTI_DualProcess(__EXTI_DUAL_t *d, uint32_t max)
+{
+  __EXTI_EVENT_t ev;
+  uint32_t       n = 0u;
+
+  while ((n < max) && EXTI_RingPop(&d->ring, &ev)) {
+    __EXTI_DUAL_LINE_t *l       = &d->lines[ev.line];
+    uint32_t            latency = EXTI_TIMESTAMP() - ev.ts;
+    uint32_t            dt      = ev.ts - l->last_ts;
+
+    n++;
+    d->latency_sum += latency;
+    if (latency > d->latency_max) {
+      d->latency_max = latency;
+    }
+
+    if (l->accepted == 0u) {
+      dt = 0u;
+    } else if (dt < l->debounce) {
+      l->bounced++;
+      continue;
+    } else {
+      if (dt < l->min_dt) {
+        l->min_dt = dt;
+      }
+      if (dt > l->max_dt) {
+        l->max_dt = dt;
+      }
+    }
+
+    l->last_ts = ev.ts;
+    l->accepted++;
+    if (l->decode != NULL) {
+      l->decode(&ev, dt, l->ctx);
+    }
+  }
+  d->processed += n;
+  return n;
+}
+
+#if (EXTI_PORT == EXTI_PORT_RP2040) && !defined(IO_BANK0_SIM)
+
+static __EXTI_DUAL_t *sEXTI_DUAL_CORE1;
+
+static void exti_dual_core1_main(void)
+{
+  for (;;) {
+    if (EXTI_DualProcess(sEXTI_DUAL_CORE1, UINT32_MAX) == 0u) {
+      EXTI_DUAL_IDLE();
+    }
+  }
+}
+
+void EXTI_DualStart(__EXTI_DUAL_t *d)
+{
+  sEXTI_DUAL_CORE1 = d;
+  multicore_launch_core1(exti_dual_core1_main);
+}
+
+#endif
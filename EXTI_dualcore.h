@@ -0,0 +1,89 @@
+/**
+ * \file EXTI_dualcore.h
+ * \brief Reparto de trabajo en dos núcleos: captura de flancos en el núcleo 0 y
+ * procesamiento (decodificación, antirrebote y estadísticas) en el núcleo 1.
+ * \details El núcleo 0 atiende IO_IRQ_BANK0 con el manejador mínimo EXTI_DualCapture(): toma
+ * la marca de tiempo y encola el evento en una cola SPSC (EXTI_ring.h) compartida en SRAM.
+ * El núcleo 1 vacía la cola con EXTI_DualProcess(), aplica el antirrebote por línea, mide
+ * intervalos y latencia entre núcleos, y entrega cada evento aceptado al decodificador de la
+ * línea. En RP2040 el núcleo 0 avisa con SEV y el núcleo 1 duerme en WFE con la cola vacía.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_DUALCORE_H_
+#define EXTI_DUALCORE_H_
+
+#include <stdint.h>
+
+#include "EXTI_line.h"
+#include "EXTI_ring.h"
+#include "EXTI_time.h"
+
+/**
+ * \brief  Decodificador de línea (núcleo 1).
+ * \param  ev   Evento aceptado por el antirrebote.
+ * \param  dt   Ticks desde el evento aceptado anterior de la línea (0 en el primero).
+ * \param  ctx  Contexto registrado con la línea.
+ */
+typedef void (*__EXTI_DUAL_DECODE_t)(const __EXTI_EVENT_t *ev, uint32_t dt, void *ctx);
+
+/**
+ * \brief  Estado por línea del lado de procesamiento.
+ */
+typedef struct {
+  __EXTI_DUAL_DECODE_t decode;    /*!< Decodificador, NULL para solo estadísticas */
+  void                *ctx;       /*!< Contexto del decodificador */
+  uint32_t             debounce;  /*!< Ventana de antirrebote en ticks (0 = sin antirrebote) */
+  uint32_t             last_ts;   /*!< Marca del último evento aceptado */
+  uint32_t             accepted;  /*!< Eventos aceptados */
+  uint32_t             bounced;   /*!< Eventos descartados por antirrebote */
+  uint32_t             min_dt;    /*!< Intervalo mínimo entre eventos aceptados */
+  uint32_t             max_dt;    /*!< Intervalo máximo entre eventos aceptados */
+} __EXTI_DUAL_LINE_t;
+
+/**
+ * \brief  Contexto del reparto en dos núcleos.
+ */
+typedef struct {
+  __EXTI_RING_t       ring;                       /*!< Cola núcleo 0 -> núcleo 1 */
+  __EXTI_DUAL_LINE_t  lines[kEXTI_LINE_COUNT];
+  uint32_t            latency_max;                /*!< Latencia máxima captura -> proceso */
+  uint64_t            latency_sum;                /*!< Suma de latencias (media = sum/count) */
+  uint32_t            processed;                  /*!< Eventos sacados de la cola */
+} __EXTI_DUAL_t;
+
+/**
+ * \brief  Inicializa el contexto (cola vacía, sin líneas).
+ */
+void EXTI_DualInit(__EXTI_DUAL_t *d);
+
+/**
+ * \brief  Configura una línea para captura en el núcleo 0 y procesamiento en el núcleo 1.
+ * \details Debe llamarse desde el núcleo 0 tras EXTI_LineInit(); deja la línea habilitada.
+ */
+__EXTI_STATUS_t EXTI_DualLineConfig(__EXTI_DUAL_t *d, uint32_t line, uint32_t trigger,
+                                    uint32_t debounce, __EXTI_DUAL_DECODE_t decode, void *ctx);
+
+/**
+ * \brief  Manejador de captura (núcleo 0): marca de tiempo + encolado. ctx = __EXTI_DUAL_t.
+ */
+void EXTI_DualCapture(uint32_t line, uint32_t events, void *ctx);
+
+/**
+ * \brief  Procesa hasta max eventos de la cola (núcleo 1).
+ * \return Número de eventos procesados.
+ */
+uint32_t EXTI_DualProcess(__EXTI_DUAL_t *d, uint32_t max);
+
+#if (EXTI_PORT == EXTI_PORT_RP2040) && !defined(IO_BANK0_SIM)
+/**
+ * \brief  Arranca el núcleo 1 con el bucle de procesamiento de d (no retorna en núcleo 1).
+ */
+void EXTI_DualStart(__EXTI_DUAL_t *d);
+#endif
+
+#endif /* EXTI_DUALCORE_H_ */
@@ -0,0 +1,153 @@
+/**
+ * \file EXTI_line.c
+ * \brief Registro de manejadores y API portable de líneas (común a todos los backends).
+ */
+
+#include <stddef.h>
+
+#include "EXTI_line.h"
+
+#if defined(EXTI_RATE)
+#include "EXTI_crit.h"
+#endif
+
+__EXTI_SLOT_t sEXTI_SLOTS[kEXTI_LINE_COUNT];
+
+#if defined(EXTI_RATE)
+__EXTI_RATE_t sEXTI_RATE[kEXTI_LINE_COUNT];
+
+__EXTI_STATUS_t EXTI_LineRate(uint32_t line, __EXTI_RATE_t *out)
+{
+  uint32_t s;
+
+  if (line >= kEXTI_LINE_COUNT) {
+    return kEXTI_ERR_LINE;
+  }
+  s    = EXTI_CRIT_ENTER();
+  *out = sEXTI_RATE[line];
+  EXTI_CRIT_EXIT(s);
+  return kEXTI_OK;
+}
+#endif
+
+#if EXTI_DISPATCH == EXTI_DISPATCH_PRIORITY
+#define kEXTI_PRIO_CFG_LINES  ((kEXTI_LINE_COUNT < kEXTI_PRIO_LINES) ? kEXTI_LINE_COUNT : kEXTI_PRIO_LINES)
+
+uint32_t       sEXTI_PRIO_PERM[4][256];
+uint8_t        sEXTI_PRIO_LINE[kEXTI_PRIO_LINES];
+static uint8_t sEXTI_PRIO[kEXTI_PRIO_LINES];
+
+/* Ordena las líneas por (prioridad, línea) y reconstruye rango <-> línea */
+static void prio_rebuild(void)
+{
+  uint32_t rank_of[kEXTI_PRIO_LINES];
+
+  for (uint32_t line = 0u; line < kEXTI_PRIO_LINES; line++) {
+    uint32_t r = line;
+
+    /* Inserción estable: 32 elementos */
+    while ((r > 0u) && (sEXTI_PRIO[sEXTI_PRIO_LINE[r - 1u]] > sEXTI_PRIO[line])) {
+      sEXTI_PRIO_LINE[r] = sEXTI_PRIO_LINE[r - 1u];
+      r--;
+    }
+    sEXTI_PRIO_LINE[r] = (uint8_t) line;
+  }
+  for (uint32_t r = 0u; r < kEXTI_PRIO_LINES; r++) {
+    rank_of[sEXTI_PRIO_LINE[r]] = r;
+  }
+
+  for (uint32_t b = 0u; b < 4u; b++) {
+    for (uint32_t v = 0u; v < 256u; v++) {
+      uint32_t ranks = 0u;
+
+      for (uint32_t i = 0u; i < 8u; i++) {
+        if ((v >> i) & 1u) {
+          ranks |= 1u << rank_of[8u * b + i];
+        }
+      }
+      sEXTI_PRIO_PERM[b][v] = ranks;
+    }
+  }
+}
+
+__EXTI_STATUS_t EXTI_LinePriority(uint32_t line, uint8_t prio)
+{
+  if (line >= kEXTI_PRIO_CFG_LINES) {
+    return kEXTI_ERR_LINE;
+  }
+  sEXTI_PRIO[line] = prio;
+  prio_rebuild();
+  return kEXTI_OK;
+}
+#endif
+
+/* Registro vacío: sin manejadores, estimadores y perfilador a cero, prioridades por defecto */
+static void line_reset(void)
+{
+  for (uint32_t line = 0u; line < kEXTI_LINE_COUNT; line++) {
+    sEXTI_SLOTS[line].fn      = NULL;
+    sEXTI_SLOTS[line].ctx     = NULL;
+    sEXTI_SLOTS[line].trigger = 0u;
+#if defined(EXTI_RATE)
+    EXTI_RateReset(&sEXTI_RATE[line]);
+#endif
+  }
+#if defined(EXTI_PROF)
+  EXTI_ProfReset();
+#endif
+#if EXTI_DISPATCH == EXTI_DISPATCH_PRIORITY
+  for (uint32_t line = 0u; line < kEXTI_PRIO_LINES; line++) {
+    sEXTI_PRIO[line] = 0u;
+  }
+  prio_rebuild();
+#endif
+}
+
+void EXTI_LineInit(void)
+{
+  line_reset();
+  EXTI_PORT_Init();
+}
+
+#if EXTI_PORT == EXTI_PORT_STM32L4
+void EXTI_LineInitImage(const __EXTI_IMAGE_t *img)
+{
+  line_reset();
+  EXTI_STM32L4_InitImage(img);
+}
+#endif
+
+__EXTI_STATUS_t EXTI_LineConfig(uint32_t line, uint32_t trigger,
+                                __EXTI_HANDLER_t fn, void *ctx)
+{
+  __EXTI_STATUS_t status;
+
+  if (line >= kEXTI_LINE_COUNT) {
+    return kEXTI_ERR_LINE;
+  }
+
+  EXTI_PORT_Enable(line, 0u);
+  status = EXTI_PORT_Config(line, trigger);
+  if (status != kEXTI_OK) {
+    return status;
+  }
+
+  sEXTI_SLOTS[line].fn      = fn;
+  sEXTI_SLOTS[line].ctx     = ctx;
+  sEXTI_SLOTS[line].trigger = trigger;
+  return kEXTI_OK;
+}
+
+void EXTI_LineEnable(uint32_t line)
+{
+  if (line < kEXTI_LINE_COUNT) {
+    EXTI_PORT_Enable(line, 1u);
+  }
+}
+
+void EXTI_LineDisable(uint32_t line)
+{
+  if (line < kEXTI_LINE_COUNT) {
+    EXTI_PORT_Enable(line, 0u);
+  }
+}
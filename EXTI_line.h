@@ -0,0 +1,493 @@
+/**
+ * \file EXTI_line.h
+ * \brief API portable de interrupciones por línea y motor de despacho común.
+ * \details Una "línea" es una fuente de interrupción externa: una línea EXTI en STM32L4 o un
+ * GPIO del IO_BANK0 en RP2040. Ambos backends comparten el registro de manejadores y el
+ * motor de despacho; cada uno solo aporta la configuración de registros y la rutina de
+ * servicio, que reconoce los pendientes de una palabra completa con una única escritura
+ * antes de despachar.
+ *
+ * Los eventos entregados a un manejador usan la codificación de nibble del RP2040:
+ * kEXTI_TRIG_LEVEL_LOW, kEXTI_TRIG_LEVEL_HIGH, kEXTI_TRIG_EDGE_FALLING y
+ * kEXTI_TRIG_EDGE_RISING. En STM32L4 el hardware no distingue el flanco que disparó, por lo
+ * que se entregan los flancos configurados para la línea.
+ *
+ * El orden de despacho dentro de una rutina de servicio se elige en compilación con
+ * EXTI_DISPATCH: por número de línea (bitscan, por defecto), por prioridad lógica asignada
+ * con EXTI_LinePriority() o por turno rotativo con presupuesto (EXTI_DISPATCH_FAIR). El orden
+ * entre vectores distintos lo fija el NVIC.
+ *
+ * Con EXTI_RATE definido, el despacho actualiza además el estimador de intervalo y tasa de
+ * cada línea (EXTI_rate.h) con EXTI_TIMESTAMP() antes de llamar al manejador. Con EXTI_PROF
+ * definido, atribuye el despertar en curso a la línea y mide la llamada al manejador
+ * (EXTI_prof.h).
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_LINE_H_
+#define EXTI_LINE_H_
+
+#include <stdint.h>
+
+/************************************************************************************************
+ * 1. Selección de backend
+ ************************************************************************************************/
+
+#define EXTI_PORT_STM32L4    1  /*!< Periférico EXTI de STM32L4 (EXIT_lib.h) */
+#define EXTI_PORT_RP2040     2  /*!< IO_BANK0 de RP2040 (IO_BANK0_lib.h) */
+
+#ifndef EXTI_PORT
+#define EXTI_PORT            EXTI_PORT_STM32L4
+#endif
+
+#if EXTI_PORT == EXTI_PORT_RP2040
+#include "IO_BANK0_lib.h"
+#define kEXTI_LINE_COUNT     (kIO_BANK0_NGPIO)
+#elif EXTI_PORT == EXTI_PORT_STM32L4
+#include "EXIT_lib.h"
+#define kEXTI_LINE_COUNT     (kEXTI_MAX_LINE + 1u)
+#else
+#error "EXTI_PORT desconocido"
+#endif
+
+#define EXTI_DISPATCH_BITSCAN    1  /*!< Líneas pendientes en orden de número de línea */
+#define EXTI_DISPATCH_PRIORITY   2  /*!< Líneas pendientes en orden de prioridad lógica */
+#define EXTI_DISPATCH_FAIR       3  /*!< Turno rotativo con presupuesto de líneas por pasada */
+
+#ifndef EXTI_DISPATCH
+#define EXTI_DISPATCH            EXTI_DISPATCH_BITSCAN
+#endif
+
+#if defined(EXTI_RATE)
+#include "EXTI_rate.h"
+#endif
+
+#if defined(EXTI_PROF)
+#include "EXTI_prof.h"
+#endif
+
+#if (EXTI_DISPATCH == EXTI_DISPATCH_FAIR) && !defined(kEXTI_DISPATCH_BUDGET)
+#define kEXTI_DISPATCH_BUDGET    (4u)  /*!< Líneas despachadas por pasada de la rutina de servicio */
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/************************************************************************************************
+ * 2. Tipos y constantes
+ ************************************************************************************************/
+
+/* Disparos / eventos (codificación de nibble de IO_BANK0) */
+#define kEXTI_TRIG_LEVEL_LOW     (1u << 0)
+#define kEXTI_TRIG_LEVEL_HIGH    (1u << 1)
+#define kEXTI_TRIG_EDGE_FALLING  (1u << 2)
+#define kEXTI_TRIG_EDGE_RISING   (1u << 3)
+#define kEXTI_TRIG_EDGE_BOTH     (kEXTI_TRIG_EDGE_FALLING | kEXTI_TRIG_EDGE_RISING)
+
+#define mEXTI_TRIG_LEVEL         (0x3u)
+#define mEXTI_TRIG_EDGE          (0xCu)
+
+/**
+ * \brief  Códigos de retorno de la API de líneas.
+ */
+typedef enum {
+  kEXTI_OK          =  0,  /*!< Operación correcta */
+  kEXTI_ERR_LINE    = -1,  /*!< La línea no existe en este backend/variante */
+  kEXTI_ERR_TRIGGER = -2   /*!< Disparo no soportado por la línea (p. ej. nivel en STM32) */
+} __EXTI_STATUS_t;
+
+/**
+ * \brief  Manejador de línea.
+ * \param  line    Línea que generó el evento.
+ * \param  events  Eventos kEXTI_TRIG_* observados.
+ * \param  ctx     Contexto registrado junto al manejador.
+ */
+typedef void (*__EXTI_HANDLER_t)(uint32_t line, uint32_t events, void *ctx);
+
+/**
+ * \brief  Entrada del registro de manejadores (una por línea).
+ */
+typedef struct {
+  __EXTI_HANDLER_t fn;       /*!< Manejador, NULL si la línea no está registrada */
+  void            *ctx;      /*!< Contexto del manejador */
+  uint32_t         trigger;  /*!< Disparos configurados kEXTI_TRIG_* */
+} __EXTI_SLOT_t;
+
+extern __EXTI_SLOT_t sEXTI_SLOTS[kEXTI_LINE_COUNT];
+
+#if EXTI_PORT == EXTI_PORT_STM32L4
+/**
+ * \brief  Imagen de arranque de los registros de configuración de EXTI (EXTI_claim.h).
+ */
+typedef struct {
+  uint32_t imr1;   /*!< Interrupciones desenmascaradas, líneas 0-31 */
+  uint32_t emr1;   /*!< Eventos (WFE) desenmascarados, líneas 0-31 */
+  uint32_t rtsr1;  /*!< Flancos de subida, líneas 0-31 */
+  uint32_t ftsr1;  /*!< Flancos de bajada, líneas 0-31 */
+  uint32_t imr2;   /*!< Ídem, líneas 32-40 */
+  uint32_t emr2;
+  uint32_t rtsr2;
+  uint32_t ftsr2;
+} __EXTI_IMAGE_t;
+#endif
+
+#if EXTI_DISPATCH == EXTI_DISPATCH_PRIORITY
+/* Líneas con prioridad lógica: las de una palabra de pendientes (PR1, INTS0-3 de RP2040) */
+#define kEXTI_PRIO_LINES     (32u)
+
+/**
+ * \brief  Permutación de la palabra de pendientes, byte a byte: sEXTI_PRIO_PERM[b][v] tiene el
+ * bit de rango de cada línea 8b+i con el bit i de v. El rango 0 es la línea más prioritaria.
+ */
+extern uint32_t sEXTI_PRIO_PERM[4][256];
+
+/**
+ * \brief  Rango -> línea.
+ */
+extern uint8_t  sEXTI_PRIO_LINE[kEXTI_PRIO_LINES];
+#endif
+
+#if defined(EXTI_RATE)
+/**
+ * \brief  Estimador de cada línea, escrito solo por la rutina de servicio de su vector.
+ */
+extern __EXTI_RATE_t sEXTI_RATE[kEXTI_LINE_COUNT];
+#endif
+
+
+/************************************************************************************************
+ * 3. API
+ ************************************************************************************************/
+
+/**
+ * \brief  Inicializa el backend: todas las líneas deshabilitadas y sin manejador.
+ */
+void EXTI_LineInit(void);
+
+#if EXTI_PORT == EXTI_PORT_STM32L4
+/**
+ * \brief  Como EXTI_LineInit(), pero deja EXTI configurado con una imagen completa: una
+ *         escritura por registro en lugar de una lectura-modificación-escritura por línea.
+ * \details Los slots quedan vacíos; quien construye la imagen los rellena (EXTI_ClaimInit()).
+ */
+void EXTI_LineInitImage(const __EXTI_IMAGE_t *img);
+#endif
+
+/**
+ * \brief  Registra el manejador y configura el disparo de una línea (queda deshabilitada).
+ */
+__EXTI_STATUS_t EXTI_LineConfig(uint32_t line, uint32_t trigger,
+                                __EXTI_HANDLER_t fn, void *ctx);
+
+/**
+ * \brief  Habilita / deshabilita la interrupción de una línea configurada.
+ */
+void EXTI_LineEnable(uint32_t line);
+void EXTI_LineDisable(uint32_t line);
+
+#if EXTI_DISPATCH == EXTI_DISPATCH_PRIORITY
+/**
+ * \brief  Asigna la prioridad lógica de una línea (0 = la más alta, como en el NVIC).
+ * \details Las líneas de igual prioridad se despachan por número de línea; tras
+ * EXTI_LineInit() todas tienen prioridad 0 (orden de bitscan). Recalcula las tablas de
+ * permutación (unas 8K operaciones), por lo que se configura en la inicialización, antes de
+ * habilitar las líneas: una rutina de servicio concurrente vería una tabla a medio construir.
+ */
+__EXTI_STATUS_t EXTI_LinePriority(uint32_t line, uint8_t prio);
+#endif
+
+#if defined(EXTI_RATE)
+/**
+ * \brief  Copia coherente del estimador de una línea (desde el bucle principal).
+ * \details Los campos de 64 bits no se leen de forma atómica en Cortex-M: la copia se hace en
+ * una sección crítica corta.
+ */
+__EXTI_STATUS_t EXTI_LineRate(uint32_t line, __EXTI_RATE_t *out);
+#endif
+
+
+/************************************************************************************************
+ * 4. Motor de despacho
+ ************************************************************************************************/
+
+#if defined(EXTI_RATE) || defined(EXTI_PROF)
+#include "EXTI_time.h"
+#endif
+
+/**
+ * \brief  Llama al manejador de una línea.
+ */
+static inline void EXTI_DispatchLine(uint32_t line, uint32_t events)
+{
+  const __EXTI_SLOT_t *slot = &sEXTI_SLOTS[line];
+
+#if defined(EXTI_RATE)
+  EXTI_RateUpdate(&sEXTI_RATE[line], EXTI_TIMESTAMP());
+#endif
+#if defined(EXTI_PROF)
+  uint32_t t0 = EXTI_TIMESTAMP();
+
+  EXTI_ProfCause(line);
+  if (slot->fn != 0) {
+    slot->fn(line, events, slot->ctx);
+  }
+  EXTI_ProfDispatch(line, (uint32_t) (uintptr_t) slot->fn, t0, EXTI_TIMESTAMP());
+#else
+  if (slot->fn != 0) {
+    slot->fn(line, events, slot->ctx);
+  }
+#endif
+}
+
+/**
+ * \brief  Despacha una palabra de pendientes con un bit por línea (PRx de STM32).
+ * \param  base  Línea del bit 0 de la palabra.
+ * \param  pend  Pendientes ya reconocidos en el hardware.
+ * \details Recorre los bits con ctz, de coste constante por línea pendiente.
+ */
+static inline void EXTI_DispatchMask(uint32_t base, uint32_t pend)
+{
+  while (pend != 0u) {
+    uint32_t line = base + (uint32_t) __builtin_ctz(pend);
+
+    pend &= pend - 1u;
+    EXTI_DispatchLine(line, sEXTI_SLOTS[line].trigger & mEXTI_TRIG_EDGE);
+  }
+}
+
+/**
+ * \brief  Despacha una palabra de pendientes con un nibble por línea (INTS de RP2040).
+ * \param  base  Línea del nibble 0 de la palabra.
+ * \param  ints  Estado de interrupción de 8 líneas.
+ */
+static inline void EXTI_DispatchNibbles(uint32_t base, uint32_t ints)
+{
+  while (ints != 0u) {
+    uint32_t shift = (uint32_t) __builtin_ctz(ints) & ~3u;
+    uint32_t ev    = (ints >> shift) & 0xFu;
+
+    ints &= ~(0xFu << shift);
+    EXTI_DispatchLine(base + (shift >> 2), ev);
+  }
+}
+
+/**
+ * \brief  Un bit por nibble no nulo: 8 nibbles de INTS -> 8 bits de línea.
+ */
+static inline uint32_t EXTI_NibbleMask(uint32_t ints)
+{
+  uint32_t x = ints | (ints >> 1);
+
+  x = (x | (x >> 2)) & 0x11111111u;
+  x = (x | (x >> 3)) & 0x03030303u;
+  x = (x | (x >> 6)) & 0x000F000Fu;
+  return (x | (x >> 12)) & 0xFFu;
+}
+
+/**
+ * \brief  Inversa de EXTI_NibbleMask(): 8 bits de línea -> nibbles completos (0xF por línea).
+ */
+static inline uint32_t EXTI_NibbleExpand(uint32_t lines)
+{
+  uint32_t x = lines & 0xFFu;
+
+  x = (x | (x << 12)) & 0x000F000Fu;
+  x = (x | (x << 6)) & 0x03030303u;
+  x = (x | (x << 3)) & 0x11111111u;
+  return x * 0xFu;
+}
+
+#if EXTI_DISPATCH == EXTI_DISPATCH_PRIORITY
+/**
+ * \brief  Palabra de pendientes (bit = línea) -> palabra de rangos (bit = rango).
+ * \details Cuatro lecturas de tabla, independientes del número de líneas pendientes.
+ */
+static inline uint32_t EXTI_PrioRank(uint32_t pend)
+{
+  return sEXTI_PRIO_PERM[0][pend & 0xFFu]
+       | sEXTI_PRIO_PERM[1][(pend >> 8) & 0xFFu]
+       | sEXTI_PRIO_PERM[2][(pend >> 16) & 0xFFu]
+       | sEXTI_PRIO_PERM[3][pend >> 24];
+}
+
+/**
+ * \brief  Despacha los pendientes de PR1 (líneas 0-31) en orden de prioridad.
+ * \details Permuta la palabra a rangos y la recorre con ctz: coste constante por línea
+ * pendiente, como EXTI_DispatchMask().
+ */
+static inline void EXTI_DispatchMaskPrio(uint32_t pend)
+{
+  uint32_t rank = EXTI_PrioRank(pend);
+
+  while (rank != 0u) {
+    uint32_t line = sEXTI_PRIO_LINE[__builtin_ctz(rank)];
+
+    rank &= rank - 1u;
+    EXTI_DispatchLine(line, sEXTI_SLOTS[line].trigger & mEXTI_TRIG_EDGE);
+  }
+}
+
+/**
+ * \brief  Despacha en orden de prioridad varias palabras de nibbles (INTS0-3 de RP2040).
+ * \param  ints   Estado de interrupción ya reconocido, 8 líneas por palabra desde la línea 0.
+ * \param  nregs  Número de palabras (hasta 4).
+ */
+static inline void EXTI_DispatchNibblesPrio(const uint32_t *ints, uint32_t nregs)
+{
+  uint32_t pend = 0u;
+  uint32_t rank;
+
+  for (uint32_t n = 0u; n < nregs; n++) {
+    pend |= EXTI_NibbleMask(ints[n]) << (8u * n);
+  }
+  rank = EXTI_PrioRank(pend);
+
+  while (rank != 0u) {
+    uint32_t line = sEXTI_PRIO_LINE[__builtin_ctz(rank)];
+
+    rank &= rank - 1u;
+    EXTI_DispatchLine(line, (ints[line >> 3] >> (4u * (line & 7u))) & 0xFu);
+  }
+}
+#endif
+
+
+#if EXTI_DISPATCH == EXTI_DISPATCH_FAIR
+static inline uint32_t EXTI_Rotr(uint32_t x, uint32_t n)
+{
+  n &= 31u;
+  return (n == 0u) ? x : ((x >> n) | (x << (32u - n)));
+}
+
+/**
+ * \brief  Líneas a atender en esta pasada: las kEXTI_DISPATCH_BUDGET primeras pendientes en
+ * orden circular desde la línea start.
+ * \details El resto queda sin reconocer en el hardware: la petición sigue activa y el vector
+ * vuelve a entrar por tail-chaining, después de los vectores de igual prioridad y menor número
+ * que estén pendientes. Una pasada nunca despacha más de kEXTI_DISPATCH_BUDGET manejadores.
+ */
+static inline uint32_t EXTI_FairSelect(uint32_t pend, uint32_t start)
+{
+  uint32_t r    = EXTI_Rotr(pend, start);
+  uint32_t rest = r;
+
+  for (uint32_t i = 0u; (i < kEXTI_DISPATCH_BUDGET) && (rest != 0u); i++) {
+    rest &= rest - 1u;
+  }
+  return EXTI_Rotr(r ^ rest, 32u - start);
+}
+
+/**
+ * \brief  Despacha sel (un bit por línea, no vacío) en orden circular desde start.
+ * \return Línea siguiente a la última despachada: inicio de la próxima pasada.
+ */
+static inline uint32_t EXTI_DispatchMaskFair(uint32_t sel, uint32_t start)
+{
+  uint32_t r    = EXTI_Rotr(sel, start);
+  uint32_t line = start;
+
+  while (r != 0u) {
+    line = (start + (uint32_t) __builtin_ctz(r)) & 31u;
+    r &= r - 1u;
+    EXTI_DispatchLine(line, sEXTI_SLOTS[line].trigger & mEXTI_TRIG_EDGE);
+  }
+  return (line + 1u) & 31u;
+}
+
+/**
+ * \brief  Como EXTI_DispatchMaskFair() con los eventos tomados de las palabras de nibbles.
+ */
+static inline uint32_t EXTI_DispatchNibblesFair(const uint32_t *ints, uint32_t sel, uint32_t start)
+{
+  uint32_t r    = EXTI_Rotr(sel, start);
+  uint32_t line = start;
+
+  while (r != 0u) {
+    line = (start + (uint32_t) __builtin_ctz(r)) & 31u;
+    r &= r - 1u;
+    EXTI_DispatchLine(line, (ints[line >> 3] >> (4u * (line & 7u))) & 0xFu);
+  }
+  return (line + 1u) & 31u;
+}
+#endif
+
+
+/************************************************************************************************
+ * 5. Interfaz de backend (EXTI_port_*.c)
+ ************************************************************************************************/
+
+void            EXTI_PORT_Init(void);
+__EXTI_STATUS_t EXTI_PORT_Config(uint32_t line, uint32_t trigger);
+void            EXTI_PORT_Enable(uint32_t line, uint32_t enable);
+
+/**
+ * \brief  Lee y reconoce los flancos latcheados de una línea, también con la interrupción
+ * deshabilitada (PRx en STM32L4, INTR en RP2040).
+ * \return Eventos kEXTI_TRIG_EDGE_* observados, 0 si no hubo ninguno.
+ */
+uint32_t        EXTI_PORT_Pending(uint32_t line);
+
+#if EXTI_PORT == EXTI_PORT_STM32L4
+/**
+ * \brief  Rutina de servicio de un grupo de líneas de PR1 (la llaman los EXTIx_IRQHandler).
+ */
+void EXTI_STM32L4_Service(uint32_t lines);
+
+/**
+ * \brief  EXTI_PORT_Init() con una imagen en lugar de todo a cero: flancos, limpieza de
+ *         pendientes y después máscaras, una escritura por registro. No habilita vectores.
+ */
+void EXTI_STM32L4_InitImage(const __EXTI_IMAGE_t *img);
+
+#ifdef EXTI_DEFER
+#if EXTI_DISPATCH == EXTI_DISPATCH_FAIR
+#error "EXTI_DEFER: el modo EXTI_DISPATCH_FAIR ya acota la pasada por número de líneas"
+#endif
+/* Despacho diferido: la rutina de servicio de un vector GPIO despacha mientras no se agote
+ * kEXTI_DEFER_BUDGET (ticks de EXTI_TIMESTAMP(), ciclos en STM32L4) y pasa el resto de líneas
+ * reconocidas a un conjunto diferido. Lo atiende el vector de kEXTI_DEFER_LINE, una línea
+ * configurable sin uso lanzada por SWIER1 y con prioridad kEXTI_DEFER_PRIO, menor que la de
+ * los vectores GPIO: el código de tiempo real con prioridad intermedia solo ve el
+ * presupuesto, no la ráfaga completa. */
+#ifndef kEXTI_DEFER_BUDGET
+#define kEXTI_DEFER_BUDGET   (2000u)       /*!< ~17 us a 120 MHz; siempre se despacha 1 línea */
+#endif
+#ifndef kEXTI_DEFER_LINE
+#define kEXTI_DEFER_LINE     (22u)         /*!< COMP2: vector COMP_IRQHandler (IRQ 64) */
+#define EXTI_DEFER_VECTOR    COMP
+#elif !defined(EXTI_DEFER_VECTOR)
+/* El preprocesador no puede buscar el vector de la línea en EXTI_VAR_SOURCES */
+#error "EXTI_DEFER: kEXTI_DEFER_LINE propio sin EXTI_DEFER_VECTOR (prefijo de su _IRQHandler)"
+#endif
+#ifndef kEXTI_DEFER_PRIO
+#define kEXTI_DEFER_PRIO     (0xFFu)       /*!< Byte de NVIC_IPR: la prioridad más baja */
+#endif
+
+/**
+ * \brief  Rutina de servicio del conjunto diferido (la llama el vector EXTI_DEFER_VECTOR).
+ */
+void EXTI_STM32L4_DeferService(void);
+
+/**
+ * \brief  Líneas diferidas pendientes de atender.
+ */
+uint32_t EXTI_STM32L4_Deferred(void);
+#endif
+#elif EXTI_PORT == EXTI_PORT_RP2040
+/**
+ * \brief  Rutina de servicio de IO_IRQ_BANK0 para el núcleo que la ejecuta.
+ */
+void EXTI_RP2040_Service(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_LINE_H_ */
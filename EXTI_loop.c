@@ -0,0 +1,163 @@
+/**
+ * \file EXTI_loop.c
+ * \brief Bucle de eventos sin tick (EXTI_loop.h).
+ */
+
+#include <stddef.h>
+
+#include "EXTI_crit.h"
+#include "EXTI_loop.h"
+#include "EXTI_time.h"
+
+#ifdef EXTI_LOOP_PORT_RP2040
+
+#include "hardware/timer.h"
+
+/* La alarma solo despierta: su IRQ no tiene trabajo (el SDK limpia INTR) */
+static void exti_loop_alarm(uint alarm)
+{
+  (void) alarm;
+}
+
+static void loop_port_init(void)
+{
+  hardware_alarm_claim(kEXTI_LOOP_ALARM);
+  hardware_alarm_set_callback(kEXTI_LOOP_ALARM, exti_loop_alarm);
+}
+
+static uint32_t loop_now(void)
+{
+  return EXTI_TIMESTAMP();
+}
+
+static void loop_sleep(uint32_t armed, uint32_t deadline)
+{
+  if (armed) {
+    uint64_t now = time_us_64();
+    uint64_t at  = now + (uint64_t) (int64_t) (int32_t) (deadline - (uint32_t) now);
+
+    /* Objetivo ya pasado: no se duerme, el bucle lo atiende en la siguiente pasada */
+    if (hardware_alarm_set_target(kEXTI_LOOP_ALARM, from_us_since_boot(at))) {
+      return;
+    }
+  }
+  __wfi();
+}
+
+#else
+
+#define loop_port_init()      ((void) 0)
+#define loop_now              EXTI_LOOP_Now
+#define loop_sleep            EXTI_LOOP_Sleep
+
+#endif
+
+void EXTI_LoopInit(__EXTI_LOOP_t *lp)
+{
+  EXTI_RingInit(&lp->ring);
+  for (uint32_t line = 0u; line < kEXTI_LINE_COUNT; line++) {
+    lp->lines[line].fn  = NULL;
+    lp->lines[line].ctx = NULL;
+  }
+  lp->wakeups     = 0u;
+  lp->events      = 0u;
+  lp->timers      = 0u;
+  lp->latency_max = 0u;
+  lp->latency_sum = 0u;
+
+  loop_port_init();
+  EXTI_WheelInit(&sEXTI_WHEEL, loop_now());
+  /* La ISR de línea corre antes de EXTI_LoopRunOnce(): sus plazos no pueden usar now */
+  EXTI_WheelClock(&sEXTI_WHEEL, loop_now);
+  EXTI_WheelSleep(&sEXTI_WHEEL, loop_sleep);
+}
+
+__EXTI_STATUS_t EXTI_LoopLineConfig(__EXTI_LOOP_t *lp, uint32_t line, uint32_t trigger,
+                                    __EXTI_LOOP_FN_t fn, void *ctx)
+{
+  __EXTI_STATUS_t status;
+
+  if (line >= kEXTI_LINE_COUNT) {
+    return kEXTI_ERR_LINE;
+  }
+  lp->lines[line].fn  = fn;
+  lp->lines[line].ctx = ctx;
+
+  status = EXTI_LineConfig(line, trigger, EXTI_LoopCapture, lp);
+  if (status == kEXTI_OK) {
+    EXTI_LineEnable(line);
+  }
+  return status;
+}
+
+void EXTI_LoopCapture(uint32_t line, uint32_t events, void *ctx)
+{
+  __EXTI_LOOP_t *lp = (__EXTI_LOOP_t *) ctx;
+  uint32_t       s;
+
+  /* Los vectores GPIO pueden tener prioridades distintas (planificador NVIC, EXTI_DEFER): uno
+   * que expulsa a otro leería el mismo head y pisaría su ranura. La sección crítica reduce
+   * los productores de la cola SPSC a uno */
+  s = EXTI_CRIT_ENTER();
+  (void) EXTI_RingPush(&lp->ring, EXTI_TIMESTAMP(), line, events);
+  EXTI_CRIT_EXIT(s);
+}
+
+uint32_t EXTI_LoopRunOnce(__EXTI_LOOP_t *lp)
+{
+  __EXTI_EVENT_t ev;
+  uint32_t       work = 0u;
+  uint32_t       fired;
+
+  while (EXTI_RingPop(&lp->ring, &ev)) {
+    uint32_t latency = EXTI_TIMESTAMP() - ev.ts;
+
+    lp->latency_sum += latency;
+    if (latency > lp->latency_max) {
+      lp->latency_max = latency;
+    }
+    if (lp->lines[ev.line].fn != NULL) {
+      lp->lines[ev.line].fn(&ev, lp->lines[ev.line].ctx);
+    }
+    lp->events++;
+    work++;
+  }
+
+  fired = EXTI_WheelAdvance(&sEXTI_WHEEL, loop_now());
+  lp->timers += fired;
+  return work + fired;
+}
+
+void EXTI_LoopIdle(__EXTI_LOOP_t *lp)
+{
+  uint32_t s = EXTI_CRIT_ENTER();
+  uint32_t deadline;
+  uint32_t armed;
+
+  if (EXTI_RingCount(&lp->ring) != 0u) {
+    EXTI_CRIT_EXIT(s);
+    return;
+  }
+  armed = EXTI_WheelNextExpiry(&sEXTI_WHEEL, &deadline);
+  if (armed && ((int32_t) (deadline - loop_now()) <= 0)) {
+    EXTI_CRIT_EXIT(s);
+    return;
+  }
+#if defined(EXTI_PROF)
+  EXTI_ProfSleepBegin(EXTI_TIMESTAMP());
+  loop_sleep(armed, deadline);
+  EXTI_ProfSleepEnd(EXTI_TIMESTAMP());
+#else
+  loop_sleep(armed, deadline);
+#endif
+  lp->wakeups++;
+  EXTI_CRIT_EXIT(s);
+}
+
+void EXTI_LoopRun(__EXTI_LOOP_t *lp)
+{
+  for (;;) {
+    (void) EXTI_LoopRunOnce(lp);
+    EXTI_LoopIdle(lp);
+  }
+}
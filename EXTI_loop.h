@@ -0,0 +1,120 @@
+/**
+ * \file EXTI_loop.h
+ * \brief Bucle de eventos sin tick: cola de eventos de línea + temporizadores + WFI.
+ * \details Sustituye al sondeo con sleep_ms(). Las ISRs de línea solo encolan el evento con
+ * su marca de tiempo (EXTI_LoopCapture) y el bucle, en contexto de hilo:
+ *
+ *  1. Vacía la cola EXTI_ring.h y entrega cada evento al manejador de su línea.
+ *  2. Avanza sEXTI_WHEEL hasta el instante actual con EXTI_WheelAdvance(), ejecutando los
+ *     temporizadores vencidos.
+ *  3. Sin trabajo pendiente, calcula la próxima expiración, programa un único temporizador
+ *     de despertar y ejecuta WFI con las líneas EXTI armadas como fuente de despertar.
+ *
+ * La comprobación de cola vacía y el WFI se hacen con PRIMASK = 1: una interrupción que
+ * llega en medio deja el WFI sin efecto en lugar de perderse hasta el siguiente despertar.
+ *
+ * La rueda avanza en ticks de EXTI_LOOP_NOW(): en RP2040 el contador TIMERAWL (1 us) con la
+ * alarma hardware kEXTI_LOOP_ALARM como despertador. En otros destinos y en el host, con
+ * EXTI_LOOP_HOOK, la aplicación aporta EXTI_LOOP_Now() y EXTI_LOOP_Sleep() (por ejemplo un
+ * LPTIM en STM32L4, o el reloj virtual de la simulación).
+ *
+ * Con EXTI_PROF definido, cada reposo se anota en el perfilador de despertares (EXTI_prof.h).
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_LOOP_H_
+#define EXTI_LOOP_H_
+
+#include <stdint.h>
+
+#include "EXTI_line.h"
+#include "EXTI_ring.h"
+#include "EXTI_wheel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (EXTI_PORT == EXTI_PORT_RP2040) && !defined(IO_BANK0_SIM) && !defined(EXTI_LOOP_HOOK)
+#define EXTI_LOOP_PORT_RP2040
+#ifndef kEXTI_LOOP_ALARM
+#define kEXTI_LOOP_ALARM      (0u)     /*!< Alarma hardware 0-3 (la 3 es la del pool del SDK) */
+#endif
+#else
+/**
+ * \brief  Tick actual de la rueda (contador libre de 32 bits).
+ */
+uint32_t EXTI_LOOP_Now(void);
+
+/**
+ * \brief  Duerme hasta una interrupción; con armed != 0, programa antes el despertar en el
+ * tick deadline. Se llama con PRIMASK = 1 (la interrupción que despierta se atiende al salir).
+ */
+void EXTI_LOOP_Sleep(uint32_t armed, uint32_t deadline);
+#endif
+
+/**
+ * \brief  Manejador de evento de línea en contexto de hilo.
+ */
+typedef void (*__EXTI_LOOP_FN_t)(const __EXTI_EVENT_t *ev, void *ctx);
+
+/**
+ * \brief  Contexto del bucle.
+ */
+typedef struct {
+  __EXTI_RING_t     ring;                      /*!< ISRs de línea -> bucle */
+  struct {
+    __EXTI_LOOP_FN_t fn;
+    void            *ctx;
+  }                 lines[kEXTI_LINE_COUNT];
+  uint32_t          wakeups;                   /*!< Salidas de WFI */
+  uint32_t          events;                    /*!< Eventos de línea entregados */
+  uint32_t          timers;                    /*!< Callbacks de temporizador ejecutados */
+  uint32_t          latency_max;               /*!< Mayor captura -> entrega [ticks] */
+  uint64_t          latency_sum;
+} __EXTI_LOOP_t;
+
+/**
+ * \brief  Inicializa el bucle y la rueda compartida en el instante actual.
+ */
+void EXTI_LoopInit(__EXTI_LOOP_t *lp);
+
+/**
+ * \brief  Configura una línea cuyos eventos entrega el bucle a fn, y la habilita.
+ */
+__EXTI_STATUS_t EXTI_LoopLineConfig(__EXTI_LOOP_t *lp, uint32_t line, uint32_t trigger,
+                                    __EXTI_LOOP_FN_t fn, void *ctx);
+
+/**
+ * \brief  Manejador de línea (ISR): encola el evento. ctx = __EXTI_LOOP_t.
+ * \details Lo registran todas las líneas del bucle, desde vectores que pueden tener
+ * prioridades distintas; el encolado se hace en sección crítica para que la cola siga
+ * teniendo un único productor.
+ */
+void EXTI_LoopCapture(uint32_t line, uint32_t events, void *ctx);
+
+/**
+ * \brief  Una pasada: vacía la cola y ejecuta los temporizadores vencidos.
+ * \return Eventos y temporizadores atendidos.
+ */
+uint32_t EXTI_LoopRunOnce(__EXTI_LOOP_t *lp);
+
+/**
+ * \brief  Duerme hasta el siguiente temporizador o interrupción si no hay trabajo pendiente.
+ */
+void EXTI_LoopIdle(__EXTI_LOOP_t *lp);
+
+/**
+ * \brief  Bucle principal: EXTI_LoopRunOnce() + EXTI_LoopIdle(). No retorna.
+ */
+void EXTI_LoopRun(__EXTI_LOOP_t *lp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_LOOP_H_ */
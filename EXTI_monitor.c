@@ -0,0 +1,181 @@
+/**
+ * \file EXTI_monitor.c
+ * \brief Vigilancia de latido y banda de frecuencia (EXTI_monitor.h).
+ */
+
+#include <stddef.h>
+
+#include "EXTI_crit.h"
+#include "EXTI_monitor.h"
+
+/* Arma el temporizador en deadline salvo que ya esté armado antes (llamar en sección crítica) */
+static void mon_arm(__EXTI_MON_t *m, uint32_t deadline)
+{
+  if (!EXTI_TimerPending(&m->timer) || ((int32_t) (deadline - m->timer.expires) < 0)) {
+    EXTI_TimerStart(&sEXTI_WHEEL, &m->timer, deadline);
+  }
+}
+
+static void mon_notify(__EXTI_MON_t *m, const __EXTI_MON_LINE_t *l)
+{
+  if (m->fn != NULL) {
+    m->fn(l->line, (__EXTI_MON_STATE_t) l->state, m->ctx);
+  }
+}
+
+static __EXTI_MON_LINE_t *mon_find(const __EXTI_MON_t *m, uint32_t line)
+{
+  for (uint32_t used = m->used; used != 0u; used &= used - 1u) {
+    const __EXTI_MON_LINE_t *l = &m->ln[__builtin_ctz(used)];
+
+    if (l->line == line) {
+      return (__EXTI_MON_LINE_t *) l;
+    }
+  }
+  return NULL;
+}
+
+static void mon_expire(__EXTI_TIMER_t *t, void *ctx)
+{
+  __EXTI_MON_t *m    = (__EXTI_MON_t *) ctx;
+  uint32_t      next = 0u;
+  uint32_t      any  = 0u;
+  uint32_t      s;
+
+  for (uint32_t used = m->used; used != 0u; used &= used - 1u) {
+    __EXTI_MON_LINE_t *l = &m->ln[__builtin_ctz(used)];
+    uint32_t           late;
+
+    if (l->state == kEXTI_MON_MISSED) {
+      continue;
+    }
+    /* Un flanco entre la comprobación y el cambio de estado no debe perderse; el instante se
+     * lee dentro de la sección para que seen nunca sea posterior */
+    s    = EXTI_CRIT_ENTER();
+    late = (EXTI_WheelNow(&sEXTI_WHEEL) - l->seen) >= l->timeout;
+    if (late) {
+      l->state = kEXTI_MON_MISSED;
+    }
+    EXTI_CRIT_EXIT(s);
+
+    if (late) {
+      mon_notify(m, l);
+    } else if (!any || ((int32_t) (l->seen + l->timeout - next) < 0)) {
+      next = l->seen + l->timeout;
+      any  = 1u;
+    }
+  }
+
+  if (any) {
+    s = EXTI_CRIT_ENTER();
+    mon_arm(m, next);
+    EXTI_CRIT_EXIT(s);
+  }
+  (void) t;
+}
+
+void EXTI_MonitorInit(__EXTI_MON_t *m, __EXTI_MON_FN_t fn, void *ctx)
+{
+  EXTI_TimerInit(&m->timer, mon_expire, m);
+  m->used = 0u;
+  m->fn   = fn;
+  m->ctx  = ctx;
+}
+
+__EXTI_STATUS_t EXTI_MonitorAttach(__EXTI_MON_t *m, uint32_t line, uint32_t trigger,
+                                   uint32_t timeout, uint32_t ivl_min, uint32_t ivl_max)
+{
+  uint32_t           free = ~m->used & ((1u << (kEXTI_MON_LINES - 1u) << 1) - 1u);
+  __EXTI_MON_LINE_t *l;
+  __EXTI_STATUS_t    status;
+  uint32_t           s;
+
+  if (timeout == 0u) {
+    return kEXTI_ERR_TRIGGER;
+  }
+  if ((free == 0u) || (mon_find(m, line) != NULL)) {
+    return kEXTI_ERR_LINE;
+  }
+  l          = &m->ln[__builtin_ctz(free)];
+  l->mon     = m;
+  l->timeout = timeout;
+  l->ivl_min = ivl_min;
+  l->ivl_max = ivl_max;
+  l->line    = (uint16_t) line;
+  l->state   = kEXTI_MON_OK;
+  l->seen    = EXTI_WheelNow(&sEXTI_WHEEL);
+  EXTI_RateReset(&l->rate);
+
+  status = EXTI_LineConfig(line, trigger, EXTI_MonitorEdge, l);
+  if (status != kEXTI_OK) {
+    return status;
+  }
+  s        = EXTI_CRIT_ENTER();
+  m->used |= 1u << (uint32_t) (l - m->ln);
+  mon_arm(m, l->seen + timeout);
+  EXTI_CRIT_EXIT(s);
+  EXTI_LineEnable(line);
+  return kEXTI_OK;
+}
+
+void EXTI_MonitorDetach(__EXTI_MON_t *m, uint32_t line)
+{
+  __EXTI_MON_LINE_t *l = mon_find(m, line);
+  uint32_t           s;
+
+  if (l == NULL) {
+    return;
+  }
+  EXTI_LineDisable(line);
+  s        = EXTI_CRIT_ENTER();
+  m->used &= ~(1u << (uint32_t) (l - m->ln));
+  if (m->used == 0u) {
+    (void) EXTI_TimerCancel(&sEXTI_WHEEL, &m->timer);
+  }
+  EXTI_CRIT_EXIT(s);
+}
+
+__EXTI_MON_STATE_t EXTI_MonitorState(const __EXTI_MON_t *m, uint32_t line)
+{
+  const __EXTI_MON_LINE_t *l = mon_find(m, line);
+
+  return (l != NULL) ? (__EXTI_MON_STATE_t) l->state : kEXTI_MON_OK;
+}
+
+void EXTI_MonitorEdge(uint32_t line, uint32_t events, void *ctx)
+{
+  __EXTI_MON_LINE_t *l     = (__EXTI_MON_LINE_t *) ctx;
+  __EXTI_MON_t      *m     = l->mon;
+  uint32_t           state = kEXTI_MON_OK;
+  uint32_t           s;
+
+  (void) line;
+  (void) events;
+  l->seen = EXTI_WheelNow(&sEXTI_WHEEL);
+
+  if (l->state == kEXTI_MON_MISSED) {
+    /* Tras un hueco el intervalo medio no es representativo: se vuelve a calentar */
+    EXTI_RateReset(&l->rate);
+    EXTI_RateUpdate(&l->rate, EXTI_TIMESTAMP());
+    s        = EXTI_CRIT_ENTER();
+    l->state = kEXTI_MON_OK;
+    mon_arm(m, l->seen + l->timeout);
+    EXTI_CRIT_EXIT(s);
+    mon_notify(m, l);
+    return;
+  }
+
+  EXTI_RateUpdate(&l->rate, EXTI_TIMESTAMP());
+  if ((l->ivl_max == 0u) || (l->rate.count <= (1u << kEXTI_RATE_SHIFT))) {
+    return;
+  }
+  if (EXTI_RateMean(&l->rate) < l->ivl_min) {
+    state = kEXTI_MON_FAST;
+  } else if (EXTI_RateMean(&l->rate) > l->ivl_max) {
+    state = kEXTI_MON_SLOW;
+  }
+  if (state != l->state) {
+    l->state = (uint8_t) state;
+    mon_notify(m, l);
+  }
+}
@@ -0,0 +1,129 @@
+/**
+ * \file EXTI_monitor.h
+ * \brief Vigilancia de señales periódicas en líneas EXTI: latido perdido y frecuencia fuera
+ * de banda.
+ * \details Para monitores de seguridad sobre PPS, salidas de watchdog externos o tacómetros
+ * de ventilador. Cada línea vigilada tiene un plazo (timeout, en ticks de sEXTI_WHEEL) que
+ * se renueva con cada flanco, y opcionalmente una banda [ivl_min, ivl_max] para el intervalo
+ * medio entre flancos (EWMA de EXTI_rate.h, en ticks de EXTI_TIMESTAMP()).
+ *
+ * Todas las líneas de un monitor comparten un único temporizador de sEXTI_WHEEL. El flanco
+ * solo guarda el tick actual de la rueda (EXTI_WheelNow(), O(1), sin tocar la rueda: también
+ * en modo sin tick, donde now va retrasado durante el reposo); el temporizador se arma
+ * en el plazo más cercano de todas las líneas y, al vencer, recorre las líneas: las que
+ * llevan timeout ticks sin flanco pasan a kEXTI_MON_MISSED y el resto fija el siguiente
+ * plazo. El recorrido cuesta O(líneas) por vencimiento, no por flanco.
+ *
+ * El callback de alarma se llama en cada cambio de estado de una línea: desde la rutina de
+ * servicio EXTI para las bandas y la recuperación, y desde el contexto de la rueda para los
+ * latidos perdidos.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_MONITOR_H_
+#define EXTI_MONITOR_H_
+
+#include <stdint.h>
+
+#include "EXTI_line.h"
+#include "EXTI_rate.h"
+#include "EXTI_time.h"
+#include "EXTI_wheel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef kEXTI_MON_LINES
+#define kEXTI_MON_LINES       (16u)   /*!< Líneas por monitor */
+#endif
+
+/* Intervalo en ticks de EXTI_TIMESTAMP() de una señal de hz hercios (para las bandas) */
+#define EXTI_MON_IVL(hz)      ((uint32_t) (kEXTI_TIME_HZ / (hz)))
+
+/**
+ * \brief  Estado de una línea vigilada.
+ */
+typedef enum {
+  kEXTI_MON_OK     = 0,   /*!< Latido presente y dentro de banda */
+  kEXTI_MON_MISSED = 1,   /*!< Sin flancos durante timeout ticks */
+  kEXTI_MON_FAST   = 2,   /*!< Intervalo medio < ivl_min */
+  kEXTI_MON_SLOW   = 3    /*!< Intervalo medio > ivl_max */
+} __EXTI_MON_STATE_t;
+
+typedef struct __EXTI_MON_s __EXTI_MON_t;
+
+/**
+ * \brief  Cambio de estado de una línea.
+ */
+typedef void (*__EXTI_MON_FN_t)(uint32_t line, __EXTI_MON_STATE_t state, void *ctx);
+
+/**
+ * \brief  Línea vigilada.
+ */
+typedef struct {
+  __EXTI_MON_t      *mon;
+  __EXTI_RATE_t      rate;      /*!< Intervalo medio entre flancos */
+  volatile uint32_t  seen;      /*!< Tick de sEXTI_WHEEL del último flanco */
+  uint32_t           timeout;   /*!< Ticks de sEXTI_WHEEL sin flanco hasta la alarma */
+  uint32_t           ivl_min;   /*!< Banda en ticks de EXTI_TIMESTAMP() (0 = sin banda) */
+  uint32_t           ivl_max;
+  uint16_t           line;
+  volatile uint8_t   state;     /*!< __EXTI_MON_STATE_t */
+  uint8_t            _pad;
+} __EXTI_MON_LINE_t;
+
+/**
+ * \brief  Monitor: hasta kEXTI_MON_LINES líneas sobre un único temporizador.
+ */
+struct __EXTI_MON_s {
+  __EXTI_TIMER_t    timer;
+  __EXTI_MON_LINE_t ln[kEXTI_MON_LINES];
+  uint32_t          used;       /*!< Bit i: ln[i] en uso */
+  __EXTI_MON_FN_t   fn;
+  void             *ctx;
+};
+
+/**
+ * \brief  Prepara un monitor vacío.
+ */
+void EXTI_MonitorInit(__EXTI_MON_t *m, __EXTI_MON_FN_t fn, void *ctx);
+
+/**
+ * \brief  Configura la línea con el disparo dado, la vigila y la habilita.
+ * \param  timeout  Ticks de sEXTI_WHEEL sin flanco hasta kEXTI_MON_MISSED (> 0), p. ej. 1,5
+ *                  periodos.
+ * \param  ivl_min  Banda del intervalo medio en ticks de EXTI_TIMESTAMP() (EXTI_MON_IVL());
+ *                  ivl_min = ivl_max = 0 desactiva la comprobación de frecuencia.
+ * \details El plazo cuenta desde la llamada. La banda se evalúa tras 2^kEXTI_RATE_SHIFT
+ * flancos de calentamiento.
+ * \return kEXTI_ERR_LINE si el monitor está lleno, la línea ya está vigilada o no existe;
+ *         kEXTI_ERR_TRIGGER si timeout es 0 o el disparo no es válido.
+ */
+__EXTI_STATUS_t EXTI_MonitorAttach(__EXTI_MON_t *m, uint32_t line, uint32_t trigger,
+                                   uint32_t timeout, uint32_t ivl_min, uint32_t ivl_max);
+
+/**
+ * \brief  Deshabilita la línea y deja de vigilarla.
+ */
+void EXTI_MonitorDetach(__EXTI_MON_t *m, uint32_t line);
+
+/**
+ * \brief  Estado actual de una línea (kEXTI_MON_OK si no está vigilada).
+ */
+__EXTI_MON_STATE_t EXTI_MonitorState(const __EXTI_MON_t *m, uint32_t line);
+
+/**
+ * \brief  Manejador de línea registrado por EXTI_MonitorAttach() (contexto de ISR).
+ */
+void EXTI_MonitorEdge(uint32_t line, uint32_t events, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_MONITOR_H_ */
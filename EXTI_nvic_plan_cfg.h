@@ -0,0 +1,45 @@
+/**
+ * \file EXTI_nvic_plan_cfg.h
+ * \brief Declaración de requisitos temporales por línea EXTI para el planificador de NVIC.
+ * \details La herramienta de host exti_nvic_plan (host/tools/exti_nvic_plan.c) lee esta
+ * tabla en tiempo de compilación, asigna prioridades NVIC a los vectores EXTI0..EXTI4,
+ * EXTI9_5 y EXTI15_10, calcula el tiempo de respuesta en el peor caso de cada línea
+ * (análisis de tiempo de respuesta con los vectores compartidos) y genera EXTI_nvic_plan.h.
+ * Si alguna línea no cumple su plazo la generación falla y la compilación se detiene.
+ *
+ * Las líneas que comparten vector (EXTI9_5, EXTI15_10) se interfieren entre sí aunque el
+ * vector tenga prioridad alta: un manejador lento en la línea 7 retrasa a la línea 6. Los
+ * manejadores largos deben ir en una línea con vector propio (EXTI0..EXTI4).
+ *
+ * Cada aplicación mantiene su propia copia; la ruta se indica con EXTI_PLAN_CONFIG.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_NVIC_PLAN_CFG_H_
+#define EXTI_NVIC_PLAN_CFG_H_
+
+/* X(linea, tasa maxima de flancos [Hz], plazo del manejador [us], WCET del manejador [us]) */
+#define EXTI_PLAN_LINES(X)            \
+  X(0,   2000,    50,   4)            \
+  X(2,   50,      5000, 150)          \
+  X(3,   500,     400,  20)           \
+  X(4,   100,     2000, 60)           \
+  X(6,   10000,   40,   2)            \
+  X(8,   2000,    60,   3)            \
+  X(14,  1000,    100,  8)
+
+/* Coste de entrada/salida de la ISR y del despacho común por activación [us] */
+#define kEXTI_PLAN_OVERHEAD_US        (0.4)
+
+/* Tiempo máximo con interrupciones deshabilitadas (PRIMASK/BASEPRI) en la aplicación [us] */
+#define kEXTI_PLAN_BLOCKING_US        (5.0)
+
+/* Bits de prioridad implementados en el NVIC (STM32L4: 4) y primer nivel asignable */
+#define kEXTI_PLAN_PRIO_BITS          (4)
+#define kEXTI_PLAN_PRIO_BASE          (2)
+
+#endif /* EXTI_NVIC_PLAN_CFG_H_ */
@@ -0,0 +1,159 @@
+/**
+ * \file EXTI_port_rp2040.c
+ * \brief Backend RP2040 de EXTI_line: interrupciones de pin de IO_BANK0 (IO_IRQ_BANK0).
+ * \details Los registros se manejan directamente (IO_BANK0_lib.h), sin pasar por
+ * hardware_gpio: la habilitación usa los alias atómicos SET/CLR y el servicio reconoce
+ * todos los flancos de un registro (8 GPIO) con una sola escritura W1C en INTR.
+ * Las interrupciones de nivel no se pueden reconocer: siguen activas mientras el pin
+ * mantenga el nivel, por lo que el manejador debe deshabilitar la línea o cambiar su
+ * disparo. El pin debe estar configurado como entrada (gpio_init) por la aplicación.
+ *
+ * Este backend toma IO_IRQ_BANK0 en exclusiva en el núcleo que llama a EXTI_LineInit();
+ * no debe combinarse con gpio_set_irq_enabled_with_callback().
+ */
+
+#include "EXTI_line.h"
+
+#if EXTI_PORT == EXTI_PORT_RP2040
+
+#ifndef IO_BANK0_SIM
+#include "hardware/irq.h"
+#endif
+
+/* SIO CPUID: 0 en el núcleo 0, 1 en el núcleo 1 */
+#ifdef IO_BANK0_SIM
+#define EXTI_RP2040_CPUID()       (0u)
+#else
+#define EXTI_RP2040_CPUID()       (*(volatile uint32_t *) 0xD0000000UL)
+#endif
+
+static volatile uint32_t *sEXTI_RP2040_INTE;  /*!< PROCx_INTE del núcleo de servicio */
+static volatile uint32_t *sEXTI_RP2040_INTS;  /*!< PROCx_INTS del núcleo de servicio */
+
+void EXTI_PORT_Init(void)
+{
+  if (EXTI_RP2040_CPUID() == 0u) {
+    sEXTI_RP2040_INTE = &rIO_BANK0_PROC0_INTE(0);
+    sEXTI_RP2040_INTS = &rIO_BANK0_PROC0_INTS(0);
+  } else {
+    sEXTI_RP2040_INTE = &rIO_BANK0_PROC1_INTE(0);
+    sEXTI_RP2040_INTS = &rIO_BANK0_PROC1_INTS(0);
+  }
+
+  for (uint32_t n = 0u; n < kIO_BANK0_NREGS; n++) {
+    IO_BANK0_REG_CLR(sEXTI_RP2040_INTE[n], 0xFFFFFFFFU);
+    IO_BANK0_INTR_CLEAR(n, mIO_BANK0_INT_EDGES);
+  }
+
+#ifndef IO_BANK0_SIM
+  irq_set_exclusive_handler(IO_IRQ_BANK0, EXTI_RP2040_Service);
+  irq_set_enabled(IO_IRQ_BANK0, true);
+#endif
+}
+
+__EXTI_STATUS_t EXTI_PORT_Config(uint32_t line, uint32_t trigger)
+{
+  if (line >= kIO_BANK0_NGPIO) {
+    return kEXTI_ERR_LINE;
+  }
+  if ((trigger & ~mIO_BANK0_INT_NIBBLE) != 0u) {
+    return kEXTI_ERR_TRIGGER;
+  }
+  /* Descarta flancos antiguos de la línea */
+  IO_BANK0_INTR_CLEAR(IO_BANK0_INT_REG(line),
+                      (kIO_BANK0_INT_EDGE_LOW | kIO_BANK0_INT_EDGE_HIGH)
+                        << IO_BANK0_INT_SHIFT(line));
+  return kEXTI_OK;
+}
+
+void EXTI_PORT_Enable(uint32_t line, uint32_t enable)
+{
+  uint32_t n     = IO_BANK0_INT_REG(line);
+  uint32_t shift = IO_BANK0_INT_SHIFT(line);
+
+  if (enable) {
+    IO_BANK0_REG_SET(sEXTI_RP2040_INTE[n], (sEXTI_SLOTS[line].trigger & mIO_BANK0_INT_NIBBLE) << shift);
+  } else {
+    IO_BANK0_REG_CLR(sEXTI_RP2040_INTE[n], mIO_BANK0_INT_NIBBLE << shift);
+  }
+}
+
+uint32_t EXTI_PORT_Pending(uint32_t line)
+{
+  uint32_t n     = IO_BANK0_INT_REG(line);
+  uint32_t shift = IO_BANK0_INT_SHIFT(line);
+  uint32_t edges = rIO_BANK0_INTR(n) & ((kIO_BANK0_INT_EDGE_LOW | kIO_BANK0_INT_EDGE_HIGH) << shift);
+
+  if (edges != 0u) {
+    IO_BANK0_INTR_CLEAR(n, edges);
+  }
+  return edges >> shift;
+}
+
+#if EXTI_DISPATCH == EXTI_DISPATCH_PRIORITY
+void EXTI_RP2040_Service(void)
+{
+  uint32_t ints[kIO_BANK0_NREGS];
+
+  /* Se reconocen los 4 registros antes de despachar: el orden de prioridad abarca las 30 GPIO */
+  for (uint32_t n = 0u; n < kIO_BANK0_NREGS; n++) {
+    uint32_t edges;
+
+    ints[n] = sEXTI_RP2040_INTS[n];
+    edges   = ints[n] & mIO_BANK0_INT_EDGES;
+    if (edges != 0u) {
+      IO_BANK0_INTR_CLEAR(n, edges);
+    }
+  }
+  EXTI_DispatchNibblesPrio(ints, kIO_BANK0_NREGS);
+}
+#elif EXTI_DISPATCH == EXTI_DISPATCH_FAIR
+static uint32_t sEXTI_RP2040_FAIR;  /*!< Inicio del turno */
+
+void EXTI_RP2040_Service(void)
+{
+  uint32_t ints[kIO_BANK0_NREGS];
+  uint32_t pend = 0u;
+  uint32_t sel;
+
+  for (uint32_t n = 0u; n < kIO_BANK0_NREGS; n++) {
+    ints[n] = sEXTI_RP2040_INTS[n];
+    pend   |= EXTI_NibbleMask(ints[n]) << (n * kIO_BANK0_GPIO_PER_REG);
+  }
+  if (pend == 0u) {
+    return;
+  }
+
+  /* Solo se reconocen los flancos de las GPIO de esta pasada: el resto mantiene IO_IRQ_BANK0
+   * activa y la rutina vuelve a entrar en cuanto retorna */
+  sel = EXTI_FairSelect(pend, sEXTI_RP2040_FAIR);
+  for (uint32_t n = 0u; n < kIO_BANK0_NREGS; n++) {
+    uint32_t edges = ints[n] & mIO_BANK0_INT_EDGES
+                   & EXTI_NibbleExpand(sel >> (n * kIO_BANK0_GPIO_PER_REG));
+
+    if (edges != 0u) {
+      IO_BANK0_INTR_CLEAR(n, edges);
+    }
+  }
+  sEXTI_RP2040_FAIR = EXTI_DispatchNibblesFair(ints, sel, sEXTI_RP2040_FAIR);
+}
+#else
+void EXTI_RP2040_Service(void)
+{
+  for (uint32_t n = 0u; n < kIO_BANK0_NREGS; n++) {
+    uint32_t ints = sEXTI_RP2040_INTS[n];
+
+    if (ints != 0u) {
+      uint32_t edges = ints & mIO_BANK0_INT_EDGES;
+
+      /* Un único W1C por registro para todos los flancos de sus 8 GPIO */
+      if (edges != 0u) {
+        IO_BANK0_INTR_CLEAR(n, edges);
+      }
+      EXTI_DispatchNibbles(n * kIO_BANK0_GPIO_PER_REG, ints);
+    }
+  }
+}
+#endif
+
+#endif /* EXTI_PORT == EXTI_PORT_RP2040 */
@@ -0,0 +1,301 @@
+/**
+ * \file EXTI_port_stm32l4.c
+ * \brief Backend STM32L4 de EXTI_line: registros EXTI (EXIT_lib.h) y vectores EXTIx.
+ * \details La selección de puerto GPIO de cada línea (SYSCFG_EXTICRx) y la configuración
+ * del pin corresponden al driver GPIO; aquí solo se gestionan EXTI y el NVIC.
+ */
+
+#include "EXTI_line.h"
+
+#if EXTI_PORT == EXTI_PORT_STM32L4
+
+/* NVIC_ISER: un bit por IRQn. En el simulador de host no hay NVIC que habilitar. */
+#ifdef EXTI_SIM
+#define EXTI_NVIC_ENABLE(irqn)    ((void) (irqn))
+#else
+#define EXTI_NVIC_ENABLE(irqn)    \
+  (((volatile uint32_t *) 0xE000E100UL)[(irqn) >> 5] = 1u << ((irqn) & 31u))
+#endif
+
+/* NVIC_IPR: un byte por IRQn, prioridad en los bits altos. Con EXTI_NVIC_PLAN se aplican
+ * las prioridades generadas por la herramienta exti_nvic_plan (EXTI_nvic_plan.h). */
+#ifdef EXTI_SIM
+#define EXTI_NVIC_IPR(irqn, v)    ((void) (irqn), (void) (v))
+#else
+#define EXTI_NVIC_IPR(irqn, v)    (((volatile uint8_t *) 0xE000E400UL)[(irqn)] = (uint8_t) (v))
+#endif
+
+#ifdef EXTI_NVIC_PLAN
+#include "EXTI_nvic_plan.h"
+#if kEXTI_NVIC_PLAN_MISSES != 0
+#error "EXTI_nvic_plan.h: hay líneas que no cumplen su plazo"
+#endif
+#define EXTI_NVIC_PRIORITY(irqn, prio)  \
+  EXTI_NVIC_IPR(irqn, (prio) << (8u - kEXTI_NVIC_PLAN_PRIO_BITS))
+#define EXTI_NVIC_PLAN_APPLY_(name, irqn, prio)   EXTI_NVIC_PRIORITY(irqn, prio);
+#endif
+
+#ifdef EXTI_DEFER
+#include "EXTI_crit.h"
+#include "EXTI_time.h"
+
+#if !EXTI_VAR_LINE_CONFIGURABLE(kEXTI_DEFER_LINE) || (kEXTI_DEFER_LINE < kEXTI_GPIO_LINES) || (kEXTI_DEFER_LINE >= 32u)
+#error "kEXTI_DEFER_LINE debe ser una línea configurable de PR1 que no sea GPIO"
+#endif
+
+static volatile uint32_t sEXTI_DEFER_SET;   /*!< Líneas diferidas sin atender */
+static volatile uint32_t sEXTI_DEFER_BUSY;  /*!< Línea cuyo manejador diferido está en curso */
+#endif
+
+#define kEXTI_NO_IRQN             (0xFFFFFFFFu)
+
+#define EXTI_IRQN_CASE_(line, name, irqn)   case (line): return (irqn);
+
+static uint32_t exti_irqn(uint32_t line)
+{
+  if (line < kEXTI_GPIO_LINES) {
+    return EXTI_VAR_GPIO_IRQN(line);
+  }
+  switch (line) {
+    EXTI_VAR_SOURCES(EXTI_IRQN_CASE_)
+    default: return kEXTI_NO_IRQN;
+  }
+}
+
+void EXTI_PORT_Init(void)
+{
+  static const __EXTI_IMAGE_t kEXTI_IMAGE_EMPTY = { 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u };
+
+  EXTI_STM32L4_InitImage(&kEXTI_IMAGE_EMPTY);
+}
+
+void EXTI_STM32L4_InitImage(const __EXTI_IMAGE_t *img)
+{
+  /* Flancos y pendientes antes que máscaras: un pendiente viejo no entra al desenmascarar */
+  rEXTI_RTSR1 = img->rtsr1;
+  rEXTI_FTSR1 = img->ftsr1;
+  rEXTI_RTSR2 = img->rtsr2;
+  rEXTI_FTSR2 = img->ftsr2;
+  EXTI_PR1_CLEAR(mEXTI_PR1_VALID);
+  EXTI_PR2_CLEAR(mEXTI_PR2_VALID);
+#ifdef EXTI_DEFER
+  sEXTI_DEFER_SET  = 0u;
+  sEXTI_DEFER_BUSY = 0u;
+  rEXTI_IMR1 = img->imr1 | EXTI_LINE_BIT(kEXTI_DEFER_LINE);
+#else
+  rEXTI_IMR1 = img->imr1;
+#endif
+  rEXTI_EMR1 = img->emr1;
+  rEXTI_IMR2 = img->imr2;
+  rEXTI_EMR2 = img->emr2;
+#ifdef EXTI_NVIC_PLAN
+  EXTI_NVIC_PLAN_VECTORS(EXTI_NVIC_PLAN_APPLY_)
+#endif
+#ifdef EXTI_DEFER
+  EXTI_NVIC_IPR(exti_irqn(kEXTI_DEFER_LINE), kEXTI_DEFER_PRIO);
+  EXTI_NVIC_ENABLE(exti_irqn(kEXTI_DEFER_LINE));
+#endif
+}
+
+__EXTI_STATUS_t EXTI_PORT_Config(uint32_t line, uint32_t trigger)
+{
+  uint32_t bit = EXTI_LINE_BIT(line);
+
+  if (!EXTI_VAR_LINE_VALID(line)) {
+    return kEXTI_ERR_LINE;
+  }
+  /* EXTI solo detecta flancos */
+  if ((trigger & mEXTI_TRIG_LEVEL) != 0u) {
+    return kEXTI_ERR_TRIGGER;
+  }
+  /* Líneas directas: el evento lo define el periférico, no hay nada que configurar */
+  if (!EXTI_VAR_LINE_CONFIGURABLE(line)) {
+    return kEXTI_OK;
+  }
+
+  if (line < 32u) {
+    rEXTI_RTSR1 = (trigger & kEXTI_TRIG_EDGE_RISING)  ? (rEXTI_RTSR1 | bit) : (rEXTI_RTSR1 & ~bit);
+    rEXTI_FTSR1 = (trigger & kEXTI_TRIG_EDGE_FALLING) ? (rEXTI_FTSR1 | bit) : (rEXTI_FTSR1 & ~bit);
+    EXTI_PR1_CLEAR(bit);
+  } else {
+    rEXTI_RTSR2 = (trigger & kEXTI_TRIG_EDGE_RISING)  ? (rEXTI_RTSR2 | bit) : (rEXTI_RTSR2 & ~bit);
+    rEXTI_FTSR2 = (trigger & kEXTI_TRIG_EDGE_FALLING) ? (rEXTI_FTSR2 | bit) : (rEXTI_FTSR2 & ~bit);
+    EXTI_PR2_CLEAR(bit);
+  }
+  return kEXTI_OK;
+}
+
+void EXTI_PORT_Enable(uint32_t line, uint32_t enable)
+{
+  uint32_t bit = EXTI_LINE_BIT(line);
+
+  if (!EXTI_VAR_LINE_VALID(line)) {
+    return;
+  }
+  if (line < 32u) {
+    rEXTI_IMR1 = enable ? (rEXTI_IMR1 | bit) : (rEXTI_IMR1 & ~bit);
+  } else {
+    rEXTI_IMR2 = enable ? (rEXTI_IMR2 | bit) : (rEXTI_IMR2 & ~bit);
+  }
+  /* Los vectores se comparten entre líneas: se habilitan pero nunca se deshabilitan aquí */
+  if (enable && (exti_irqn(line) != kEXTI_NO_IRQN)) {
+    EXTI_NVIC_ENABLE(exti_irqn(line));
+  }
+}
+
+uint32_t EXTI_PORT_Pending(uint32_t line)
+{
+  uint32_t bit = EXTI_LINE_BIT(line);
+
+  if (!EXTI_VAR_LINE_CONFIGURABLE(line)) {
+    return 0u;
+  }
+  if (line < 32u) {
+    if ((rEXTI_PR1 & bit) == 0u) {
+      return 0u;
+    }
+    EXTI_PR1_CLEAR(bit);
+  } else {
+    if ((rEXTI_PR2 & bit) == 0u) {
+      return 0u;
+    }
+    EXTI_PR2_CLEAR(bit);
+  }
+  /* Sin distinción de flanco: los configurados */
+  return sEXTI_SLOTS[line].trigger & mEXTI_TRIG_EDGE;
+}
+
+#if EXTI_DISPATCH == EXTI_DISPATCH_FAIR
+/* Inicio del turno de cada vector, indexado por la primera línea de su grupo */
+static uint8_t sEXTI_STM32L4_FAIR[32];
+
+void EXTI_STM32L4_Service(uint32_t lines)
+{
+  uint32_t pend = rEXTI_PR1 & rEXTI_IMR1 & lines;
+
+  /* Solo se reconocen las líneas de esta pasada; las demás siguen en PR1 y el vector vuelve
+   * a entrar por tail-chaining, empezando tras la última línea atendida */
+  if (pend != 0u) {
+    uint8_t *start = &sEXTI_STM32L4_FAIR[__builtin_ctz(lines)];
+    uint32_t sel   = EXTI_FairSelect(pend, *start);
+
+    EXTI_PR1_CLEAR(sel);
+    *start = (uint8_t) EXTI_DispatchMaskFair(sel, *start);
+  }
+}
+#elif defined(EXTI_DEFER)
+/* Primera línea de set en el orden del modo de despacho */
+static uint32_t exti_first(uint32_t set)
+{
+#if EXTI_DISPATCH == EXTI_DISPATCH_PRIORITY
+  return sEXTI_PRIO_LINE[__builtin_ctz(EXTI_PrioRank(set))];
+#else
+  return (uint32_t) __builtin_ctz(set);
+#endif
+}
+
+void EXTI_STM32L4_Service(uint32_t lines)
+{
+  uint32_t t0   = EXTI_TIMESTAMP();
+  uint32_t pend = rEXTI_PR1 & rEXTI_IMR1 & lines;
+  uint32_t held;
+
+  if (pend == 0u) {
+    return;
+  }
+  EXTI_PR1_CLEAR(pend);
+
+  /* Una línea ya diferida (o con su manejador diferido en curso) se fusiona con el conjunto
+   * diferido: no se adelanta a su evento anterior ni se anida sobre sí misma */
+  held  = pend & (sEXTI_DEFER_SET | sEXTI_DEFER_BUSY);
+  pend &= ~held;
+  while (pend != 0u) {
+    uint32_t line = exti_first(pend);
+
+    pend &= ~(1u << line);
+    EXTI_DispatchLine(line, sEXTI_SLOTS[line].trigger & mEXTI_TRIG_EDGE);
+    if ((uint32_t) (EXTI_TIMESTAMP() - t0) >= kEXTI_DEFER_BUDGET) {
+      break;
+    }
+  }
+
+  held |= pend;
+  if (held != 0u) {
+    uint32_t s = EXTI_CRIT_ENTER();
+
+    sEXTI_DEFER_SET |= held;
+    EXTI_CRIT_EXIT(s);
+    EXTI_SWIER1_SET(EXTI_LINE_BIT(kEXTI_DEFER_LINE));
+  }
+}
+
+void EXTI_STM32L4_DeferService(void)
+{
+  EXTI_PR1_CLEAR(EXTI_LINE_BIT(kEXTI_DEFER_LINE));
+
+  /* De una en una: las líneas siguen en el conjunto hasta que empieza su manejador */
+  for (;;) {
+    uint32_t s = EXTI_CRIT_ENTER();
+    uint32_t set = sEXTI_DEFER_SET;
+    uint32_t line;
+
+    if (set == 0u) {
+      sEXTI_DEFER_BUSY = 0u;
+      EXTI_CRIT_EXIT(s);
+      break;
+    }
+    line = exti_first(set);
+    sEXTI_DEFER_SET  = set & ~(1u << line);
+    sEXTI_DEFER_BUSY = 1u << line;
+    EXTI_CRIT_EXIT(s);
+
+    EXTI_DispatchLine(line, sEXTI_SLOTS[line].trigger & mEXTI_TRIG_EDGE);
+  }
+}
+
+uint32_t EXTI_STM32L4_Deferred(void)
+{
+  return sEXTI_DEFER_SET;
+}
+#else
+void EXTI_STM32L4_Service(uint32_t lines)
+{
+  uint32_t pend = rEXTI_PR1 & rEXTI_IMR1 & lines;
+
+  /* Un único W1C por vector, antes de despachar: un flanco que llegue durante los
+   * manejadores vuelve a marcar PR1 y el vector se re-dispara por tail-chaining */
+  if (pend != 0u) {
+    EXTI_PR1_CLEAR(pend);
+#if EXTI_DISPATCH == EXTI_DISPATCH_PRIORITY
+    EXTI_DispatchMaskPrio(pend);
+#else
+    EXTI_DispatchMask(0u, pend);
+#endif
+  }
+}
+#endif
+
+/* Vectores GPIO: EXTI0..EXTI4, EXTI9_5 y EXTI15_10. Con EXTI_STATIC los define la
+ * aplicación con EXTI_STATIC_VECTORS() (EXTI_static.h). */
+#if !defined(EXTI_STATIC)
+#define EXTI_ISR_(name, irqn, mask)                   \
+  void name##_IRQHandler(void)                        \
+  {                                                   \
+    EXTI_STM32L4_Service(mask);                       \
+  }
+
+EXTI_VAR_GPIO_VECTORS(EXTI_ISR_)
+#endif
+
+#if defined(EXTI_DEFER)
+#define EXTI_DEFER_ISR_(name)     EXTI_DEFER_ISR__(name)
+#define EXTI_DEFER_ISR__(name)                        \
+  void name##_IRQHandler(void)                        \
+  {                                                   \
+    EXTI_STM32L4_DeferService();                      \
+  }
+
+EXTI_DEFER_ISR_(EXTI_DEFER_VECTOR)
+#endif
+
+#endif /* EXTI_PORT == EXTI_PORT_STM32L4 */
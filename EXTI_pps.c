@@ -0,0 +1,154 @@
+/**
+ * \file EXTI_pps.c
+ * \brief Base de tiempo disciplinada por PPS (EXTI_pps.h).
+ */
+
+#include "EXTI_pps.h"
+#include "EXTI_time.h"
+
+/* n ticks * scale (Q32.32) -> ns, sin desbordar para n de 32 bits */
+static uint64_t pps_mul(uint32_t n, uint64_t scale)
+{
+  return (uint64_t) n * (scale >> 32) + (((uint64_t) n * (uint32_t) scale) >> 32);
+}
+
+/* ns / ticks en Q32.32 */
+static uint64_t pps_div(uint64_t ns, uint32_t ticks)
+{
+  uint64_t q = ns / ticks;
+  uint64_t r = ns % ticks;
+
+  return (q << 32) + ((r << 32) / ticks);
+}
+
+static void pps_publish(__EXTI_PPS_t *p, uint32_t ref, uint64_t base_ns, uint64_t scale)
+{
+  uint32_t            seq = atomic_load_explicit(&p->seq, memory_order_relaxed) + 1u;
+  __EXTI_PPS_PARAM_t *par = &p->par[seq & 1u];
+
+  par->ref     = ref;
+  par->base_ns = base_ns;
+  par->scale   = scale;
+  atomic_store_explicit(&p->seq, seq, memory_order_release);
+}
+
+void EXTI_PpsInit(__EXTI_PPS_t *p, uint32_t hz)
+{
+  atomic_store_explicit(&p->seq, 0u, memory_order_relaxed);
+  p->par[0].ref     = 0u;
+  p->par[0].base_ns = 0u;
+  p->par[0].scale   = pps_div(kEXTI_PPS_NS_PER_S, hz);
+  p->last           = 0u;
+  p->sec            = 0u;
+  p->integ          = (int64_t) p->par[0].scale;
+  p->pulses         = 0u;
+  p->glitches       = 0u;
+  p->steps          = 0u;
+  p->rejects        = 0u;
+  p->err_ns         = 0;
+}
+
+__EXTI_STATUS_t EXTI_PpsAttach(__EXTI_PPS_t *p, uint32_t line, uint32_t trigger)
+{
+  __EXTI_STATUS_t status = EXTI_LineConfig(line, trigger, EXTI_PpsEdge, p);
+
+  if (status == kEXTI_OK) {
+    EXTI_LineEnable(line);
+  }
+  return status;
+}
+
+void EXTI_PpsCapture(__EXTI_PPS_t *p, uint32_t ticks)
+{
+  const __EXTI_PPS_PARAM_t *cur =
+    &p->par[atomic_load_explicit(&p->seq, memory_order_relaxed) & 1u];
+  uint32_t period = ticks - p->last;
+  uint64_t pred, secs;
+  int64_t  e;
+
+  if (p->pulses == 0u) {
+    pps_publish(p, ticks, p->sec * kEXTI_PPS_NS_PER_S, cur->scale);
+    p->last   = ticks;
+    p->pulses = 1u;
+    return;
+  }
+
+  /* Segundos enteros transcurridos según el modelo vigente (cur->ref == p->last) */
+  pred = cur->base_ns + pps_mul(period, cur->scale);
+  secs = (pred - p->sec * kEXTI_PPS_NS_PER_S + kEXTI_PPS_NS_PER_S / 2u) / kEXTI_PPS_NS_PER_S;
+  if (secs == 0u) {
+    p->glitches++;
+    return;
+  }
+  e = (int64_t) ((p->sec + secs) * kEXTI_PPS_NS_PER_S - pred);
+  if ((p->pulses > 1u) && ((e > kEXTI_PPS_WINDOW_NS) || (e < -kEXTI_PPS_WINDOW_NS))) {
+    /* Fuera de la ventana: pulso espurio, salvo que se repita (la referencia ha cambiado) */
+    p->glitches++;
+    if (++p->rejects < kEXTI_PPS_REJECTS) {
+      return;
+    }
+    p->pulses = 0u;
+  }
+  p->rejects = 0u;
+  p->sec    += secs;
+
+  if (p->pulses == 0u) {
+    pps_publish(p, ticks, p->sec * kEXTI_PPS_NS_PER_S, cur->scale);
+    p->steps++;
+  } else if ((p->pulses == 1u) || (e > kEXTI_PPS_STEP_NS) || (e < -kEXTI_PPS_STEP_NS)) {
+    /* Adquisición: frecuencia medida sobre el último periodo y salto de fase */
+    p->integ = (int64_t) pps_div(secs * kEXTI_PPS_NS_PER_S, period);
+    p->steps++;
+    pps_publish(p, ticks, p->sec * kEXTI_PPS_NS_PER_S, (uint64_t) p->integ);
+  } else {
+    /* e / P en ns/tick Q32.32; |e| <= kEXTI_PPS_STEP_NS no desborda */
+    int64_t g = e * ((int64_t) 1 << 32) / (int64_t) period;
+
+    p->integ += g >> kEXTI_PPS_KI_SHIFT;
+    pps_publish(p, ticks, pred, (uint64_t) (p->integ + (g >> kEXTI_PPS_KP_SHIFT)));
+  }
+  p->err_ns = (int32_t) e;
+  p->last   = ticks;
+  p->pulses++;
+}
+
+void EXTI_PpsSetSecond(__EXTI_PPS_t *p, uint64_t sec)
+{
+  const __EXTI_PPS_PARAM_t *cur =
+    &p->par[atomic_load_explicit(&p->seq, memory_order_relaxed) & 1u];
+
+  pps_publish(p, cur->ref, cur->base_ns + (sec - p->sec) * kEXTI_PPS_NS_PER_S, cur->scale);
+  p->sec = sec;
+}
+
+uint64_t EXTI_PpsNs(__EXTI_PPS_t *p, uint32_t ticks)
+{
+  __EXTI_PPS_PARAM_t par;
+  uint32_t           seq;
+  int32_t            d;
+
+  do {
+    seq = atomic_load_explicit(&p->seq, memory_order_acquire);
+    par = p->par[seq & 1u];
+    atomic_thread_fence(memory_order_acquire);
+  } while (atomic_load_explicit(&p->seq, memory_order_relaxed) != seq);
+
+  d = (int32_t) (ticks - par.ref);
+  if (d >= 0) {
+    return par.base_ns + pps_mul((uint32_t) d, par.scale);
+  }
+  return par.base_ns - pps_mul(0u - (uint32_t) d, par.scale);
+}
+
+uint32_t EXTI_PpsLocked(const __EXTI_PPS_t *p)
+{
+  return (p->pulses > 2u) && (p->err_ns < kEXTI_PPS_LOCK_NS) &&
+         (p->err_ns > -kEXTI_PPS_LOCK_NS);
+}
+
+void EXTI_PpsEdge(uint32_t line, uint32_t events, void *ctx)
+{
+  (void) line;
+  (void) events;
+  EXTI_PpsCapture((__EXTI_PPS_t *) ctx, EXTI_TIMESTAMP() - kEXTI_PPS_LATENCY);
+}
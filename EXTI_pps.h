@@ -0,0 +1,151 @@
+/**
+ * \file EXTI_pps.h
+ * \brief Base de tiempo disciplinada por una entrada 1 PPS en una línea EXTI.
+ * \details La rutina de servicio de la línea PPS captura EXTI_TIMESTAMP() en cada pulso y un
+ * lazo PI corrige la frecuencia y la fase del contador (CYCCNT en STM32L4, TIMERAWL en
+ * RP2040), de modo que cualquier marca de evento se convierte a nanosegundos corregidos con
+ * EXTI_PpsNs(). Los eventos siguen guardando la marca cruda de 32 bits (una carga en la ISR);
+ * la conversión se hace en el consumidor con los parámetros vigentes y es válida para marcas
+ * hasta 2^31 ticks antes o después del último pulso.
+ *
+ * Modelo: ns(t) = base_ns + (t - ref) * scale, con scale en ns/tick en Q32.32. En cada pulso:
+ *  - Se predice con el modelo vigente el instante del pulso y se redondea al segundo entero
+ *    más cercano: así se toleran pulsos perdidos. Ya enganchado, un pulso a más de
+ *    kEXTI_PPS_WINDOW_NS del segundo se descarta como espurio; kEXTI_PPS_REJECTS descartes
+ *    seguidos reinician la adquisición.
+ *  - e = segundo verdadero - predicción. Con |e| > kEXTI_PPS_STEP_NS (arranque, saltos) se
+ *    mide la frecuencia directamente del último periodo y se salta la fase.
+ *  - Si no, integ += Ki * e / P y scale = integ + Kp * e / P (P = ticks del periodo), con
+ *    Kp = 2^-kEXTI_PPS_KP_SHIFT y Ki = 2^-kEXTI_PPS_KI_SHIFT. La fase no salta: base_ns es
+ *    la predicción en el pulso y el error se recupera ajustando la pendiente, por lo que la
+ *    hora es monótona.
+ * Una división de 64 bits por pulso, una vez por segundo; la conversión solo multiplica.
+ *
+ * Los parámetros se publican en dos copias alternas con un contador de secuencia: un lector
+ * interrumpido por el pulso reintenta, y un lector más prioritario que interrumpe al pulso
+ * lee la copia vigente, que el pulso no está escribiendo.
+ *
+ * La captura por ISR incluye la latencia de entrada y de despacho: su parte constante se
+ * descuenta con kEXTI_PPS_LATENCY (ticks) y la variable queda como ruido de fase que el lazo
+ * promedia. En RP2040 TIMERAWL cuenta microsegundos: la cuantización de +-0,5 us por placa
+ * impide el objetivo de 1 us entre placas, que requiere CYCCNT.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_PPS_H_
+#define EXTI_PPS_H_
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "EXTI_line.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef kEXTI_PPS_KP_SHIFT
+#define kEXTI_PPS_KP_SHIFT    (1u)          /*!< Kp = 1/2 */
+#endif
+
+#ifndef kEXTI_PPS_KI_SHIFT
+#define kEXTI_PPS_KI_SHIFT    (2u)          /*!< Ki = 1/4 */
+#endif
+
+#ifndef kEXTI_PPS_STEP_NS
+#define kEXTI_PPS_STEP_NS     (1000000)     /*!< Error de fase que fuerza una readquisición */
+#endif
+
+#ifndef kEXTI_PPS_WINDOW_NS
+#define kEXTI_PPS_WINDOW_NS   (100000000)   /*!< |e| mayor: pulso espurio descartado */
+#endif
+
+#ifndef kEXTI_PPS_REJECTS
+#define kEXTI_PPS_REJECTS     (3u)          /*!< Descartes seguidos que reinician la adquisición */
+#endif
+
+#ifndef kEXTI_PPS_LOCK_NS
+#define kEXTI_PPS_LOCK_NS     (1000)        /*!< |e| por debajo del cual se considera enganchado */
+#endif
+
+#ifndef kEXTI_PPS_LATENCY
+#define kEXTI_PPS_LATENCY     (0u)          /*!< Latencia fija flanco -> captura, en ticks */
+#endif
+
+#define kEXTI_PPS_NS_PER_S    (1000000000u)
+
+/**
+ * \brief  Parámetros de conversión publicados.
+ */
+typedef struct {
+  uint32_t ref;       /*!< Marca del último pulso */
+  uint32_t _pad;
+  uint64_t base_ns;   /*!< Nanosegundos en ref */
+  uint64_t scale;     /*!< ns/tick en Q32.32 */
+} __EXTI_PPS_PARAM_t;
+
+/**
+ * \brief  Estado de la base de tiempo.
+ */
+typedef struct {
+  __EXTI_PPS_PARAM_t par[2];
+  _Atomic uint32_t   seq;       /*!< Copia vigente: par[seq & 1] */
+  uint32_t           last;      /*!< Marca del último pulso aceptado */
+  uint64_t           sec;       /*!< Segundo del último pulso */
+  int64_t            integ;     /*!< Término integral: ns/tick en Q32.32 */
+  uint32_t           pulses;    /*!< Pulsos aceptados */
+  uint32_t           glitches;  /*!< Pulsos espurios descartados */
+  uint32_t           steps;     /*!< Readquisiciones (saltos de fase) */
+  uint32_t           rejects;   /*!< Descartes seguidos */
+  int32_t            err_ns;    /*!< Último error de fase */
+} __EXTI_PPS_t;
+
+/**
+ * \brief  Inicializa la base de tiempo con la frecuencia nominal del contador (Hz).
+ * \details Hasta el primer pulso EXTI_PpsNs() cuenta desde la marca 0 a la frecuencia nominal.
+ */
+void EXTI_PpsInit(__EXTI_PPS_t *p, uint32_t hz);
+
+/**
+ * \brief  Configura la línea PPS con el disparo dado, con EXTI_PpsEdge() como manejador, y la
+ *         habilita.
+ */
+__EXTI_STATUS_t EXTI_PpsAttach(__EXTI_PPS_t *p, uint32_t line, uint32_t trigger);
+
+/**
+ * \brief  Procesa un pulso capturado con la marca ticks (desde la ISR de la línea PPS u otra
+ *         fuente de captura, p. ej. captura de entrada de un temporizador).
+ */
+void EXTI_PpsCapture(__EXTI_PPS_t *p, uint32_t ticks);
+
+/**
+ * \brief  Etiqueta el último pulso con el segundo absoluto sec (p. ej. hora GPS de la trama
+ *         NMEA), para que varias placas compartan el mismo origen. Misma prioridad que la ISR
+ *         PPS o con ella deshabilitada.
+ */
+void EXTI_PpsSetSecond(__EXTI_PPS_t *p, uint64_t sec);
+
+/**
+ * \brief  Marca cruda -> nanosegundos corregidos (cualquier contexto).
+ */
+uint64_t EXTI_PpsNs(__EXTI_PPS_t *p, uint32_t ticks);
+
+/**
+ * \brief  1 si el último error de fase está por debajo de kEXTI_PPS_LOCK_NS.
+ */
+uint32_t EXTI_PpsLocked(const __EXTI_PPS_t *p);
+
+/**
+ * \brief  Manejador de línea registrado por EXTI_PpsAttach() (contexto de ISR).
+ */
+void EXTI_PpsEdge(uint32_t line, uint32_t events, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_PPS_H_ */
@@ -0,0 +1,40 @@
+/**
+ * \file EXTI_prof.c
+ * \brief Perfilador de despertares (EXTI_prof.h).
+ */
+
+#include <string.h>
+
+#include "EXTI_line.h"
+
+#if defined(EXTI_PROF)
+
+#include "EXTI_crit.h"
+
+__EXTI_PROF_t sEXTI_PROF;
+
+void EXTI_ProfReset(void)
+{
+  uint32_t s = EXTI_CRIT_ENTER();
+
+  memset(&sEXTI_PROF, 0, sizeof(sEXTI_PROF));
+  sEXTI_PROF.magic   = kEXTI_PROF_MAGIC;
+  sEXTI_PROF.version = kEXTI_PROF_VERSION;
+  sEXTI_PROF.entries = kEXTI_PROF_ENTRIES;
+  sEXTI_PROF.buckets = kEXTI_PROF_BUCKETS;
+  sEXTI_PROF.hz      = kEXTI_TIME_HZ;
+  sEXTI_PROF.shift   = kEXTI_PROF_HIST_SHIFT;
+  sEXTI_PROF.cause   = kEXTI_PROF_OTHER;
+  EXTI_CRIT_EXIT(s);
+}
+
+uint32_t EXTI_ProfCopy(void *dst)
+{
+  uint32_t s = EXTI_CRIT_ENTER();
+
+  memcpy(dst, &sEXTI_PROF, sizeof(sEXTI_PROF));
+  EXTI_CRIT_EXIT(s);
+  return (uint32_t) sizeof(sEXTI_PROF);
+}
+
+#endif
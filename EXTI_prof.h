@@ -0,0 +1,180 @@
+/**
+ * \file EXTI_prof.h
+ * \brief Perfilador de despertares: qué línea despierta al núcleo, cuánto tiempo queda
+ * despierto y qué manejador se ejecuta.
+ * \details Con EXTI_PROF definido:
+ *  - El bucle de reposo rodea cada WFI/STOP con EXTI_ProfSleepBegin() y EXTI_ProfSleepEnd()
+ *    (EXTI_loop.c lo hace; un bucle propio debe hacerlo con PRIMASK = 1, como EXTI_loop).
+ *  - El motor de despacho (EXTI_line.h) atribuye el despertar a la primera línea despachada
+ *    tras EXTI_ProfSleepEnd() y mide cada llamada a manejador.
+ *  - En el siguiente EXTI_ProfSleepBegin() el tiempo despierto, desde la salida del reposo
+ *    hasta la nueva entrada, se suma a la línea causante y a su histograma log2. Un
+ *    despertar sin línea EXTI despachada (SysTick, LPTIM, RTC por su vector) se anota en la
+ *    entrada kEXTI_PROF_OTHER; EXTI_ProfCause() permite a esos manejadores atribuirlo.
+ *
+ * Los tiempos se miden en ticks de EXTI_TIMESTAMP() y solo mientras el núcleo ejecuta: en
+ * STM32L4 CYCCNT se detiene en STOP, por lo que la transición de salida de STOP no se ve y la
+ * herramienta de host (host/tools/exti_prof.c) la añade con la tabla de chips de
+ * EXTI_energy.h.
+ *
+ * sEXTI_PROF tiene un formato fijo (campos de ancho fijo, misma disposición en Cortex-M y en
+ * el host) y empieza por una cabecera con firma y versión: se vuelca tal cual desde el
+ * depurador (dump binary memory prof.bin &sEXTI_PROF (&sEXTI_PROF)+1) o se envía por USB
+ * con EXTI_ProfCopy(). Se incluye desde EXTI_line.h (dimensiona la imagen con
+ * kEXTI_LINE_COUNT); el código de usuario incluye EXTI_line.h.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_PROF_H_
+#define EXTI_PROF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef kEXTI_LINE_COUNT
+#error "EXTI_prof.h se incluye desde EXTI_line.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define kEXTI_PROF_MAGIC      (0x46505845u)   /*!< "EXPF" en little-endian */
+#define kEXTI_PROF_VERSION    (1u)
+#define kEXTI_PROF_BUCKETS    (16u)
+#define kEXTI_PROF_OTHER      (kEXTI_LINE_COUNT)   /*!< Despertares sin línea EXTI */
+#define kEXTI_PROF_ENTRIES    (kEXTI_LINE_COUNT + 1u)
+
+#ifndef kEXTI_PROF_HIST_SHIFT
+#define kEXTI_PROF_HIST_SHIFT (6u)   /*!< Cubeta k: 2^(k-1+shift) <= ticks despierto < 2^(k+shift) */
+#endif
+
+/**
+ * \brief  Contadores de una línea (o de kEXTI_PROF_OTHER).
+ */
+typedef struct {
+  uint32_t wakes;                       /*!< Despertares atribuidos */
+  uint32_t dispatches;                  /*!< Llamadas al manejador (con y sin despertar) */
+  uint32_t handler;                     /*!< Dirección del último manejador ejecutado */
+  uint32_t handler_max;                 /*!< Llamada más larga [ticks] */
+  uint64_t awake;                       /*!< Tiempo despierto tras sus despertares [ticks] */
+  uint64_t busy;                        /*!< Tiempo dentro del manejador [ticks] */
+  uint32_t hist[kEXTI_PROF_BUCKETS];    /*!< Tiempo despierto por despertar, log2 */
+} __EXTI_PROF_LINE_t;
+
+/**
+ * \brief  Imagen volcable del perfilador.
+ */
+typedef struct {
+  uint32_t magic;                       /*!< kEXTI_PROF_MAGIC */
+  uint32_t version;                     /*!< kEXTI_PROF_VERSION */
+  uint32_t entries;                     /*!< kEXTI_PROF_ENTRIES (la última es OTHER) */
+  uint32_t buckets;                     /*!< kEXTI_PROF_BUCKETS */
+  uint32_t hz;                          /*!< kEXTI_TIME_HZ */
+  uint32_t shift;                       /*!< kEXTI_PROF_HIST_SHIFT */
+  uint32_t sleeps;                      /*!< Entradas en reposo */
+  uint32_t asleep;                      /*!< 1 entre la salida del reposo y el primer despacho */
+  uint32_t cause;                       /*!< Causante del despertar en curso */
+  uint32_t t_wake;                      /*!< Marca de la última salida del reposo */
+  __EXTI_PROF_LINE_t line[kEXTI_PROF_ENTRIES];
+} __EXTI_PROF_t;
+
+#ifdef __cplusplus
+#define EXTI_PROF_ASSERT_(c, msg)   static_assert(c, msg)
+#else
+#define EXTI_PROF_ASSERT_(c, msg)   _Static_assert(c, msg)
+#endif
+
+/* Formato del volcado sin relleno: idéntico en Cortex-M y en el host */
+EXTI_PROF_ASSERT_(sizeof(__EXTI_PROF_LINE_t) == 32u + 4u * kEXTI_PROF_BUCKETS,
+                  "__EXTI_PROF_LINE_t con relleno");
+EXTI_PROF_ASSERT_(offsetof(__EXTI_PROF_t, line) == 40u, "__EXTI_PROF_t con relleno");
+
+extern __EXTI_PROF_t sEXTI_PROF;
+
+/**
+ * \brief  Vacía los contadores y escribe la cabecera (EXTI_LineInit() lo llama).
+ */
+void EXTI_ProfReset(void);
+
+/**
+ * \brief  Copia coherente de sEXTI_PROF en dst (sizeof(__EXTI_PROF_t) bytes) para enviarla
+ *         por USB; devuelve el tamaño.
+ * \details La copia se hace en una sección crítica (unos 4 KB en STM32L4).
+ */
+uint32_t EXTI_ProfCopy(void *dst);
+
+/* Cubeta log2 como EXTI_StatBucket() (EXTI_stat.h), sin sus contadores atómicos */
+static inline uint32_t EXTI_ProfBucket(uint32_t dt)
+{
+  uint32_t v = dt >> kEXTI_PROF_HIST_SHIFT;
+  uint32_t k = (v == 0u) ? 0u : 32u - (uint32_t) __builtin_clz(v);
+
+  return (k < kEXTI_PROF_BUCKETS) ? k : (kEXTI_PROF_BUCKETS - 1u);
+}
+
+/**
+ * \brief  Atribuye el despertar en curso a una entrada si aún no tiene causante (para
+ *         manejadores que no pasan por el motor de despacho).
+ */
+static inline void EXTI_ProfCause(uint32_t entry)
+{
+  if (sEXTI_PROF.asleep != 0u) {
+    sEXTI_PROF.asleep = 0u;
+    sEXTI_PROF.cause  = entry;
+  }
+}
+
+/**
+ * \brief  Antes de WFI/STOP, con PRIMASK = 1: cierra el despertar anterior.
+ */
+static inline void EXTI_ProfSleepBegin(uint32_t now)
+{
+  __EXTI_PROF_t *p = &sEXTI_PROF;
+
+  if (p->sleeps != 0u) {
+    __EXTI_PROF_LINE_t *e  = &p->line[(p->asleep != 0u) ? kEXTI_PROF_OTHER : p->cause];
+    uint32_t            dt = now - p->t_wake;
+
+    e->wakes++;
+    e->awake += dt;
+    e->hist[EXTI_ProfBucket(dt)]++;
+  }
+  p->sleeps++;
+}
+
+/**
+ * \brief  Tras WFI/STOP, aún con PRIMASK = 1: el primer despacho será el causante.
+ */
+static inline void EXTI_ProfSleepEnd(uint32_t now)
+{
+  sEXTI_PROF.t_wake = now;
+  sEXTI_PROF.cause  = kEXTI_PROF_OTHER;
+  sEXTI_PROF.asleep = 1u;
+}
+
+/**
+ * \brief  Cuenta una llamada a manejador de la línea (rutina de servicio de su vector).
+ */
+static inline void EXTI_ProfDispatch(uint32_t line, uint32_t handler, uint32_t t0, uint32_t t1)
+{
+  __EXTI_PROF_LINE_t *e  = &sEXTI_PROF.line[line];
+  uint32_t            dt = t1 - t0;
+
+  e->dispatches++;
+  e->handler = handler;
+  e->busy   += dt;
+  if (dt > e->handler_max) {
+    e->handler_max = dt;
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_PROF_H_ */
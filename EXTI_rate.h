@@ -0,0 +1,118 @@
+/**
+ * \file EXTI_rate.h
+ * \brief Estimador incremental de intervalo entre eventos y tasa por línea.
+ * \details Media móvil exponencial (EWMA) del intervalo entre eventos y su varianza, en coma
+ * fija y en O(1) por evento, sin divisiones: el peso de la muestra nueva es
+ * alpha = 2^-kEXTI_RATE_SHIFT y ambas recurrencias se reducen a sumas, un producto y
+ * desplazamientos:
+ *
+ *     d    = x - media
+ *     media = media + alpha * d
+ *     var   = (1 - alpha) * (var + alpha * d^2)
+ *
+ * media y var se guardan multiplicadas por 2^kEXTI_RATE_SHIFT. Los intervalos se miden en
+ * ticks de EXTI_TIMESTAMP() y se saturan a kEXTI_RATE_IVL_MAX, de modo que d^2 y var caben
+ * en 64 bits. Con EXTI_RATE definido, el motor de despacho actualiza sEXTI_RATE[line] antes
+ * de llamar al manejador (EXTI_line.h).
+ *
+ * La tasa en Hz necesita una división y se calcula fuera de la ruta caliente con
+ * EXTI_RateMilliHz(); para reaccionar a cambios de tasa sin dividir basta con comparar
+ * EXTI_RateMean() con un umbral en ticks calculado en la inicialización.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_RATE_H_
+#define EXTI_RATE_H_
+
+#include <stdint.h>
+
+#ifndef kEXTI_RATE_SHIFT
+#define kEXTI_RATE_SHIFT      (3u)          /*!< alpha = 1/8: ~8 eventos de memoria */
+#endif
+
+#define kEXTI_RATE_IVL_MAX    (1u << 30)    /*!< Intervalo máximo (más largo = inactividad) */
+
+/**
+ * \brief  Estado del estimador de una línea.
+ */
+typedef struct {
+  uint32_t last;     /*!< Marca del último evento */
+  uint32_t count;    /*!< Eventos observados (satura) */
+  uint64_t mean_q;   /*!< Media del intervalo << kEXTI_RATE_SHIFT (ticks) */
+  uint64_t var_q;    /*!< Varianza del intervalo << kEXTI_RATE_SHIFT (ticks^2) */
+} __EXTI_RATE_t;
+
+/**
+ * \brief  Vuelve al estado sin eventos.
+ */
+static inline void EXTI_RateReset(__EXTI_RATE_t *r)
+{
+  r->last   = 0u;
+  r->count  = 0u;
+  r->mean_q = 0u;
+  r->var_q  = 0u;
+}
+
+/**
+ * \brief  Cuenta un evento con marca ts (contexto de ISR).
+ * \details El primer evento solo fija la referencia y el primer intervalo inicializa la
+ * media; a partir del segundo se aplica la recurrencia.
+ */
+static inline void EXTI_RateUpdate(__EXTI_RATE_t *r, uint32_t ts)
+{
+  uint32_t ivl = ts - r->last;
+  int64_t  d;
+  uint64_t d2;
+
+  r->last = ts;
+  ivl     = (ivl < kEXTI_RATE_IVL_MAX) ? ivl : kEXTI_RATE_IVL_MAX;
+  if (r->count < 2u) {
+    if (r->count++ == 1u) {
+      r->mean_q = (uint64_t) ivl << kEXTI_RATE_SHIFT;
+    }
+    return;
+  }
+
+  d          = (int64_t) ivl - (int64_t) (r->mean_q >> kEXTI_RATE_SHIFT);
+  d2         = (uint64_t) (d * d);
+  r->mean_q += (uint64_t) ivl - (r->mean_q >> kEXTI_RATE_SHIFT);
+  r->var_q  += d2 - (d2 >> kEXTI_RATE_SHIFT) - (r->var_q >> kEXTI_RATE_SHIFT);
+  r->count  += (r->count != UINT32_MAX) ? 1u : 0u;
+}
+
+/**
+ * \brief  Intervalo medio en ticks (0 con menos de dos eventos).
+ */
+static inline uint32_t EXTI_RateMean(const __EXTI_RATE_t *r)
+{
+  return (uint32_t) ((r->mean_q + (1u << (kEXTI_RATE_SHIFT - 1u))) >> kEXTI_RATE_SHIFT);
+}
+
+/**
+ * \brief  Varianza del intervalo en ticks^2.
+ */
+static inline uint64_t EXTI_RateVariance(const __EXTI_RATE_t *r)
+{
+  return r->var_q >> kEXTI_RATE_SHIFT;
+}
+
+/**
+ * \brief  Tasa en milihercios a partir de la frecuencia de EXTI_TIMESTAMP() (con división:
+ *         fuera de la ruta caliente).
+ */
+static inline uint32_t EXTI_RateMilliHz(const __EXTI_RATE_t *r, uint32_t hz)
+{
+  uint64_t q;
+
+  if (r->mean_q == 0u) {
+    return 0u;
+  }
+  q = (((uint64_t) hz * 1000u) << kEXTI_RATE_SHIFT) / r->mean_q;
+  return (q > UINT32_MAX) ? UINT32_MAX : (uint32_t) q;
+}
+
+#endif /* EXTI_RATE_H_ */
@@ -0,0 +1,192 @@
+/**
+ * \file EXTI_rec.h
+ * \brief Cola SPSC de registros de longitud variable, sin copias.
+ * \details Para decodificadores construidos sobre flancos EXTI (tramas IR, Wiegand, UART por
+ * software) cuya salida tiene tamaño variable. El productor reserva espacio contiguo con
+ * EXTI_RecReserve(), escribe la trama directamente en la cola y la publica con
+ * EXTI_RecCommit(); el consumidor obtiene una vista contigua con EXTI_RecPeek(), la procesa
+ * en sitio y la libera con EXTI_RecRelease(). No hay búferes intermedios ni memoria dinámica.
+ *
+ * Cada registro lleva una cabecera de 32 bits (longitud y etiqueta) y ocupa un múltiplo de 4
+ * bytes, de modo que las cargas útiles quedan alineadas a palabra. Si un registro no cabe
+ * antes del final del búfer, el productor publica un registro de relleno
+ * (kEXTI_REC_TAG_PAD) hasta el final y reserva desde el principio; el consumidor lo salta.
+ *
+ * Mismo esquema que EXTI_ring.h: índices en bytes que crecen libremente, cada uno escrito por
+ * un solo lado, cargas/almacenamientos de 32 bits con acquire/release. kEXTI_REC_SIZE debe ser
+ * potencia de 2 y la carga útil máxima es kEXTI_REC_SIZE / 2 - 4 bytes.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_REC_H_
+#define EXTI_REC_H_
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "EXTI_ring.h"
+
+#ifndef kEXTI_REC_SIZE
+#define kEXTI_REC_SIZE        (1024u)   /*!< Bytes del búfer */
+#endif
+
+#if ((kEXTI_REC_SIZE & (kEXTI_REC_SIZE - 1u)) != 0u) || (kEXTI_REC_SIZE < 16u)
+#error "kEXTI_REC_SIZE debe ser potencia de 2 (>= 16)"
+#endif
+
+#define mEXTI_REC_INDEX       (kEXTI_REC_SIZE - 1u)
+#define kEXTI_REC_HDR         (4u)
+#define kEXTI_REC_MAX         (kEXTI_REC_SIZE / 2u - kEXTI_REC_HDR)   /*!< Carga útil máxima */
+#define kEXTI_REC_TAG_PAD     (0xFFFFu)                              /*!< Registro de relleno */
+
+/* Bytes que ocupa un registro con len bytes de carga útil */
+#define EXTI_REC_SPAN(len)    (kEXTI_REC_HDR + (((uint32_t) (len) + 3u) & ~3u))
+
+/**
+ * \brief  Vista de un registro en la cola (válida hasta EXTI_RecRelease()).
+ */
+typedef struct {
+  const uint8_t *data;
+  uint16_t       len;
+  uint16_t       tag;   /*!< Etiqueta del productor (p. ej. línea o tipo de trama) */
+} __EXTI_REC_VIEW_t;
+
+/**
+ * \brief  Cola SPSC de registros.
+ */
+typedef struct {
+  _Atomic uint32_t head;                              /*!< Escrito solo por el productor */
+  uint32_t         dropped;                           /*!< Reservas rechazadas por cola llena */
+  uint32_t         padded;                            /*!< Registros de relleno publicados */
+  uint8_t          _pad0[kEXTI_RING_PAD - 12u];
+  _Atomic uint32_t tail;                              /*!< Escrito solo por el consumidor */
+  uint8_t          _pad1[kEXTI_RING_PAD - 4u];
+  uint32_t         buf[kEXTI_REC_SIZE / 4u];          /*!< Cabeceras y cargas, alineado a palabra */
+} __EXTI_REC_t;
+
+/**
+ * \brief  Inicializa la cola vacía. No debe llamarse con productor o consumidor activos.
+ */
+static inline void EXTI_RecInit(__EXTI_REC_t *r)
+{
+  atomic_store_explicit(&r->head, 0u, memory_order_relaxed);
+  atomic_store_explicit(&r->tail, 0u, memory_order_relaxed);
+  r->dropped = 0u;
+  r->padded  = 0u;
+}
+
+/* Cabecera: longitud en los 16 bits bajos, etiqueta en los altos */
+static inline void EXTI_RecHeader(__EXTI_REC_t *r, uint32_t pos, uint32_t len, uint32_t tag)
+{
+  r->buf[(pos & mEXTI_REC_INDEX) / 4u] = (len & 0xFFFFu) | (tag << 16);
+}
+
+/**
+ * \brief  Reserva espacio contiguo para len bytes de carga útil (lado productor).
+ * \details Si el registro no cabe antes del final del búfer se publica un relleno hasta el
+ * final. La reserva no es visible para el consumidor hasta EXTI_RecCommit(); entre ambas
+ * llamadas no debe hacerse otra reserva.
+ * \return Puntero a la carga útil (alineado a 4), o NULL si no hay espacio (se cuenta en
+ *         dropped) o len > kEXTI_REC_MAX.
+ */
+static inline uint8_t *EXTI_RecReserve(__EXTI_REC_t *r, uint32_t len)
+{
+  uint32_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+  uint32_t tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+  uint32_t need = EXTI_REC_SPAN(len);
+  uint32_t room = kEXTI_REC_SIZE - (head & mEXTI_REC_INDEX);
+  uint32_t skip = (need > room) ? room : 0u;
+
+  if ((len > kEXTI_REC_MAX) || ((kEXTI_REC_SIZE - (head - tail)) < (skip + need))) {
+    r->dropped++;
+    return NULL;
+  }
+  if (skip != 0u) {
+    EXTI_RecHeader(r, head, room - kEXTI_REC_HDR, kEXTI_REC_TAG_PAD);
+    head += skip;
+    atomic_store_explicit(&r->head, head, memory_order_release);
+    r->padded++;
+  }
+  return (uint8_t *) &r->buf[((head & mEXTI_REC_INDEX) + kEXTI_REC_HDR) / 4u];
+}
+
+/**
+ * \brief  Publica la última reserva (lado productor).
+ * \param  len  Bytes escritos; no mayor que el len reservado.
+ */
+static inline void EXTI_RecCommit(__EXTI_REC_t *r, uint32_t len, uint32_t tag)
+{
+  uint32_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+
+  EXTI_RecHeader(r, head, len, tag);
+  atomic_store_explicit(&r->head, head + EXTI_REC_SPAN(len), memory_order_release);
+}
+
+/**
+ * \brief  Reserva, copia y publica (lado productor), para cargas ya construidas.
+ * \return 1 si se publicó, 0 si no había espacio.
+ */
+static inline uint32_t EXTI_RecPush(__EXTI_REC_t *r, const void *data, uint32_t len, uint32_t tag)
+{
+  uint8_t *p = EXTI_RecReserve(r, len);
+
+  if (p == NULL) {
+    return 0u;
+  }
+  for (uint32_t i = 0u; i < len; i++) {
+    p[i] = ((const uint8_t *) data)[i];
+  }
+  EXTI_RecCommit(r, len, tag);
+  return 1u;
+}
+
+/**
+ * \brief  Siguiente registro, sin sacarlo de la cola (lado consumidor). Salta los rellenos.
+ * \return 1 si había un registro (view apunta a él), 0 si la cola estaba vacía.
+ */
+static inline uint32_t EXTI_RecPeek(__EXTI_REC_t *r, __EXTI_REC_VIEW_t *view)
+{
+  uint32_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+  uint32_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+
+  while (head != tail) {
+    uint32_t hdr = r->buf[(tail & mEXTI_REC_INDEX) / 4u];
+
+    if ((hdr >> 16) != kEXTI_REC_TAG_PAD) {
+      view->data = (const uint8_t *) &r->buf[((tail & mEXTI_REC_INDEX) + kEXTI_REC_HDR) / 4u];
+      view->len  = (uint16_t) hdr;
+      view->tag  = (uint16_t) (hdr >> 16);
+      return 1u;
+    }
+    tail += EXTI_REC_SPAN(hdr & 0xFFFFu);
+    atomic_store_explicit(&r->tail, tail, memory_order_release);
+  }
+  return 0u;
+}
+
+/**
+ * \brief  Libera el registro obtenido con EXTI_RecPeek() (lado consumidor).
+ */
+static inline void EXTI_RecRelease(__EXTI_REC_t *r, const __EXTI_REC_VIEW_t *view)
+{
+  uint32_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+
+  atomic_store_explicit(&r->tail, tail + EXTI_REC_SPAN(view->len), memory_order_release);
+}
+
+/**
+ * \brief  Bytes ocupados, cabeceras y rellenos incluidos (aproximado si se llama
+ *         concurrentemente).
+ */
+static inline uint32_t EXTI_RecUsed(__EXTI_REC_t *r)
+{
+  return atomic_load_explicit(&r->head, memory_order_acquire)
+       - atomic_load_explicit(&r->tail, memory_order_acquire);
+}
+
+#endif /* EXTI_REC_H_ */
@@ -0,0 +1,116 @@
+/**
+ * \file EXTI_ring.h
+ * \brief Cola SPSC (un productor, un consumidor) de eventos de línea, sin bloqueos.
+ * \details El productor es una ISR (o el núcleo 0 del RP2040) y el consumidor el bucle
+ * principal (o el núcleo 1). Solo se usan cargas y almacenamientos de 32 bits con orden
+ * acquire/release, que en Cortex-M0+/M4 se traducen en LDR/STR + DMB, sin LDREX/STREX ni
+ * secciones críticas. Cada índice lo escribe un único lado y crece libremente; la posición
+ * se obtiene con una máscara, por lo que kEXTI_RING_SIZE debe ser potencia de 2.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_RING_H_
+#define EXTI_RING_H_
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#ifndef kEXTI_RING_SIZE
+#define kEXTI_RING_SIZE       (256u)
+#endif
+
+#if (kEXTI_RING_SIZE & (kEXTI_RING_SIZE - 1u)) != 0u
+#error "kEXTI_RING_SIZE debe ser potencia de 2"
+#endif
+
+#define mEXTI_RING_INDEX      (kEXTI_RING_SIZE - 1u)
+
+/* Separación de índices en líneas de caché distintas (solo relevante en el host) */
+#ifndef kEXTI_RING_PAD
+#define kEXTI_RING_PAD        (64u)
+#endif
+
+/**
+ * \brief  Evento de línea capturado en la ISR.
+ */
+typedef struct {
+  uint32_t ts;      /*!< Marca de tiempo EXTI_TIMESTAMP() */
+  uint16_t line;    /*!< Línea */
+  uint16_t events;  /*!< Eventos kEXTI_TRIG_* */
+} __EXTI_EVENT_t;
+
+/**
+ * \brief  Cola SPSC de eventos.
+ */
+typedef struct {
+  _Atomic uint32_t head;                              /*!< Escrito solo por el productor */
+  uint32_t         dropped;                           /*!< Eventos perdidos por cola llena */
+  uint8_t          _pad0[kEXTI_RING_PAD - 8u];
+  _Atomic uint32_t tail;                              /*!< Escrito solo por el consumidor */
+  uint8_t          _pad1[kEXTI_RING_PAD - 4u];
+  __EXTI_EVENT_t   buf[kEXTI_RING_SIZE];
+} __EXTI_RING_t;
+
+/**
+ * \brief  Inicializa la cola vacía. No debe llamarse con productor o consumidor activos.
+ */
+static inline void EXTI_RingInit(__EXTI_RING_t *r)
+{
+  atomic_store_explicit(&r->head, 0u, memory_order_relaxed);
+  atomic_store_explicit(&r->tail, 0u, memory_order_relaxed);
+  r->dropped = 0u;
+}
+
+/**
+ * \brief  Encola un evento (lado productor).
+ * \return 1 si se encoló, 0 si la cola estaba llena (el evento se cuenta en dropped).
+ */
+static inline uint32_t EXTI_RingPush(__EXTI_RING_t *r, uint32_t ts, uint32_t line, uint32_t events)
+{
+  uint32_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+  uint32_t tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+  __EXTI_EVENT_t *e;
+
+  if ((head - tail) >= kEXTI_RING_SIZE) {
+    r->dropped++;
+    return 0u;
+  }
+  e = &r->buf[head & mEXTI_RING_INDEX];
+  e->ts     = ts;
+  e->line   = (uint16_t) line;
+  e->events = (uint16_t) events;
+  atomic_store_explicit(&r->head, head + 1u, memory_order_release);
+  return 1u;
+}
+
+/**
+ * \brief  Desencola un evento (lado consumidor).
+ * \return 1 si había un evento, 0 si la cola estaba vacía.
+ */
+static inline uint32_t EXTI_RingPop(__EXTI_RING_t *r, __EXTI_EVENT_t *out)
+{
+  uint32_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+  uint32_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+
+  if (head == tail) {
+    return 0u;
+  }
+  *out = r->buf[tail & mEXTI_RING_INDEX];
+  atomic_store_explicit(&r->tail, tail + 1u, memory_order_release);
+  return 1u;
+}
+
+/**
+ * \brief  Número de eventos en cola (aproximado si se llama concurrentemente).
+ */
+static inline uint32_t EXTI_RingCount(__EXTI_RING_t *r)
+{
+  return atomic_load_explicit(&r->head, memory_order_acquire)
+       - atomic_load_explicit(&r->tail, memory_order_acquire);
+}
+
+#endif /* EXTI_RING_H_ */
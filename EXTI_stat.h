@@ -0,0 +1,252 @@
+/**
+ * \file EXTI_stat.h
+ * \brief Contadores de estadísticas compartidos entre ISRs de distinta prioridad y el bucle
+ * principal, sin enmascarar interrupciones.
+ * \details Suma, máximo, incremento de cubeta de histograma y contadores empaquetados de
+ * 4 x 8 bits con saturación (uno por línea, 32 líneas en 8 palabras). Cada operación es una
+ * lectura-modificación-escritura atómica de una palabra:
+ *
+ *  - Cortex-M4 (ARMv7-M): bucle LDREX/STREX. Toda entrada o salida de excepción borra el
+ *    monitor exclusivo, así que si una ISR más prioritaria modifica el contador entre LDREX y
+ *    STREX, la STREX falla y se reintenta. Los contadores empaquetados usan UQADD8.
+ *  - Cortex-M0+ (ARMv6-M, RP2040): no hay accesos exclusivos; se recurre a una sección
+ *    EXTI_crit.h de pocas instrucciones. PRIMASK no protege frente al otro núcleo: en RP2040
+ *    cada núcleo debe usar sus propios contadores.
+ *  - Host: operaciones atómicas C11 con orden relaxed.
+ *
+ * Los contadores no ordenan otros accesos a memoria: sirven para estadísticas, no para
+ * sincronizar. El máximo solo escribe cuando el valor nuevo es mayor.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_STAT_H_
+#define EXTI_STAT_H_
+
+#include <stdint.h>
+
+#if defined(__ARM_ARCH) && (__ARM_ARCH >= 7)
+#define EXTI_STAT_LDREX
+#elif defined(__ARM_ARCH)
+#include "EXTI_crit.h"
+#else
+#include <stdatomic.h>
+#endif
+
+#ifndef kEXTI_STAT_BUCKETS
+#define kEXTI_STAT_BUCKETS    (16u)   /*!< Cubetas log2 del histograma */
+#endif
+
+#define kEXTI_STAT_LANE8      (0x01010101u)   /*!< EXTI_StatAdd8(): +1 en los cuatro bytes */
+
+/**
+ * \brief  Contador de 32 bits (o 4 x 8 bits empaquetados).
+ */
+#if defined(__ARM_ARCH)
+typedef volatile uint32_t __EXTI_STAT_t;
+#else
+typedef _Atomic uint32_t __EXTI_STAT_t;
+#endif
+
+/**
+ * \brief  Histograma log2: la cubeta k cuenta los valores v con 2^(k-1) <= v < 2^k (v = 0 en
+ *         la cubeta 0); la última acumula el resto.
+ */
+typedef struct {
+  __EXTI_STAT_t bucket[kEXTI_STAT_BUCKETS];
+} __EXTI_STAT_HIST_t;
+
+/* Suma por bytes con saturación a 0xFF (equivalente portable de UQADD8) */
+static inline uint32_t EXTI_StatQadd8(uint32_t a, uint32_t b)
+{
+  uint32_t sum = ((a & 0x7F7F7F7Fu) + (b & 0x7F7F7F7Fu)) ^ ((a ^ b) & 0x80808080u);
+  uint32_t ovf = ((a & b) | ((a | b) & ~sum)) & 0x80808080u;
+
+  return sum | ((ovf >> 7) * 0xFFu);
+}
+
+#if defined(EXTI_STAT_LDREX)
+
+static inline uint32_t EXTI_StatLdrex(__EXTI_STAT_t *c)
+{
+  uint32_t v;
+
+  __asm volatile("ldrex %0, [%1]" : "=r"(v) : "r"(c) : "memory");
+  return v;
+}
+
+/* 0 si la escritura exclusiva tuvo éxito */
+static inline uint32_t EXTI_StatStrex(__EXTI_STAT_t *c, uint32_t v)
+{
+  uint32_t fail;
+
+  __asm volatile("strex %0, %2, [%1]" : "=&r"(fail) : "r"(c), "r"(v) : "memory");
+  return fail;
+}
+
+static inline void EXTI_StatAdd(__EXTI_STAT_t *c, uint32_t n)
+{
+  do {
+  } while (EXTI_StatStrex(c, EXTI_StatLdrex(c) + n) != 0u);
+}
+
+static inline void EXTI_StatMax(__EXTI_STAT_t *c, uint32_t v)
+{
+  do {
+    if (EXTI_StatLdrex(c) >= v) {
+      __asm volatile("clrex" ::: "memory");
+      return;
+    }
+  } while (EXTI_StatStrex(c, v) != 0u);
+}
+
+static inline void EXTI_StatAdd8(__EXTI_STAT_t *c, uint32_t inc)
+{
+  uint32_t v;
+
+  do {
+    v = EXTI_StatLdrex(c);
+#if defined(__ARM_FEATURE_SIMD32)
+    __asm("uqadd8 %0, %0, %1" : "+r"(v) : "r"(inc));
+#else
+    v = EXTI_StatQadd8(v, inc);
+#endif
+  } while (EXTI_StatStrex(c, v) != 0u);
+}
+
+static inline uint32_t EXTI_StatTake(__EXTI_STAT_t *c)
+{
+  uint32_t v;
+
+  do {
+    v = EXTI_StatLdrex(c);
+  } while (EXTI_StatStrex(c, 0u) != 0u);
+  return v;
+}
+
+#elif defined(__ARM_ARCH)
+
+static inline void EXTI_StatAdd(__EXTI_STAT_t *c, uint32_t n)
+{
+  uint32_t s = EXTI_CRIT_ENTER();
+
+  *c += n;
+  EXTI_CRIT_EXIT(s);
+}
+
+static inline void EXTI_StatMax(__EXTI_STAT_t *c, uint32_t v)
+{
+  uint32_t s;
+
+  if (*c >= v) {
+    return;
+  }
+  s = EXTI_CRIT_ENTER();
+  if (*c < v) {
+    *c = v;
+  }
+  EXTI_CRIT_EXIT(s);
+}
+
+static inline void EXTI_StatAdd8(__EXTI_STAT_t *c, uint32_t inc)
+{
+  uint32_t s = EXTI_CRIT_ENTER();
+
+  *c = EXTI_StatQadd8(*c, inc);
+  EXTI_CRIT_EXIT(s);
+}
+
+static inline uint32_t EXTI_StatTake(__EXTI_STAT_t *c)
+{
+  uint32_t s = EXTI_CRIT_ENTER();
+  uint32_t v = *c;
+
+  *c = 0u;
+  EXTI_CRIT_EXIT(s);
+  return v;
+}
+
+#else
+
+static inline void EXTI_StatAdd(__EXTI_STAT_t *c, uint32_t n)
+{
+  (void) atomic_fetch_add_explicit(c, n, memory_order_relaxed);
+}
+
+static inline void EXTI_StatMax(__EXTI_STAT_t *c, uint32_t v)
+{
+  uint32_t cur = atomic_load_explicit(c, memory_order_relaxed);
+
+  while ((cur < v)
+         && !atomic_compare_exchange_weak_explicit(c, &cur, v, memory_order_relaxed,
+                                                   memory_order_relaxed)) {
+  }
+}
+
+static inline void EXTI_StatAdd8(__EXTI_STAT_t *c, uint32_t inc)
+{
+  uint32_t cur = atomic_load_explicit(c, memory_order_relaxed);
+
+  while (!atomic_compare_exchange_weak_explicit(c, &cur, EXTI_StatQadd8(cur, inc),
+                                                memory_order_relaxed, memory_order_relaxed)) {
+  }
+}
+
+static inline uint32_t EXTI_StatTake(__EXTI_STAT_t *c)
+{
+  return atomic_exchange_explicit(c, 0u, memory_order_relaxed);
+}
+
+#endif
+
+/**
+ * \brief  Valor actual del contador.
+ */
+static inline uint32_t EXTI_StatRead(__EXTI_STAT_t *c)
+{
+#if defined(__ARM_ARCH)
+  return *c;
+#else
+  return atomic_load_explicit(c, memory_order_relaxed);
+#endif
+}
+
+/**
+ * \brief  Cubeta log2 de un valor (ver __EXTI_STAT_HIST_t).
+ */
+static inline uint32_t EXTI_StatBucket(uint32_t v)
+{
+  uint32_t k = (v == 0u) ? 0u : 32u - (uint32_t) __builtin_clz(v);
+
+  return (k < kEXTI_STAT_BUCKETS) ? k : (kEXTI_STAT_BUCKETS - 1u);
+}
+
+/**
+ * \brief  Cuenta un valor en su cubeta del histograma.
+ */
+static inline void EXTI_StatHist(__EXTI_STAT_HIST_t *h, uint32_t v)
+{
+  EXTI_StatAdd(&h->bucket[EXTI_StatBucket(v)], 1u);
+}
+
+/**
+ * \brief  Incrementa en 1 (con saturación a 255) el contador de 8 bits de una línea en un
+ *         array de (líneas + 3) / 4 palabras.
+ */
+static inline void EXTI_StatLine8(__EXTI_STAT_t *c, uint32_t line)
+{
+  EXTI_StatAdd8(&c[line >> 2], 1u << ((line & 3u) * 8u));
+}
+
+/**
+ * \brief  Contador de 8 bits de una línea en un array empaquetado.
+ */
+static inline uint32_t EXTI_StatLine8Read(__EXTI_STAT_t *c, uint32_t line)
+{
+  return (EXTI_StatRead(&c[line >> 2]) >> ((line & 3u) * 8u)) & 0xFFu;
+}
+
+#endif /* EXTI_STAT_H_ */
@@ -0,0 +1,161 @@
+/**
+ * \file EXTI_static.h
+ * \brief Despacho estático especializado en compilación para las líneas GPIO de STM32L4.
+ * \details La aplicación declara en un tipo las líneas que usa, su disparo y su manejador:
+ *
+ *   using app_exti = exti::static_dispatch<
+ *       exti::on<0, kEXTI_TRIG_EDGE_FALLING, button>,
+ *       exti::on<5, kEXTI_TRIG_EDGE_RISING,  drdy>,
+ *       exti::on<7, kEXTI_TRIG_EDGE_BOTH,    tach>>;
+ *   EXTI_STATIC_VECTORS(app_exti)
+ *
+ * y EXTI_STATIC_VECTORS() define las rutinas EXTIx_IRQHandler. Cada una se genera para su
+ * vector a partir de la tabla de tipos: solo comprueba las máscaras de las líneas usadas en
+ * ese vector, con constantes plegadas, y llama a los manejadores de forma directa (en línea
+ * con optimización), sin sEXTI_SLOTS ni llamadas indirectas. Un vector con una sola línea
+ * usada queda en el W1C de esa línea seguido del manejador: si el vector entra es que la
+ * línea está pendiente, porque es la única desenmascarada del grupo. Con varias, una lectura
+ * de PR1 & IMR1, un W1C y una comprobación por línea en el orden de declaración.
+ *
+ * Los manejadores tienen la firma de __EXTI_HANDLER_t y reciben los flancos configurados,
+ * como en EXTI_line; el contexto es un parámetro de plantilla (nullptr por defecto). La
+ * tabla se valida en compilación: líneas GPIO (0-15) presentes en la variante, sin repetir
+ * y con disparo de flanco.
+ *
+ * Con EXTI_STATIC definido, EXTI_port_stm32l4.c no define los vectores GPIO, que pasan a ser
+ * los de EXTI_STATIC_VECTORS(); las líneas 0-15 se configuran entonces solo a través de la
+ * tabla (init()). Las líneas internas (16-40) siguen en EXTI_line.
+ *
+ * Requiere C++17 (expresiones fold e if constexpr).
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_STATIC_H_
+#define EXTI_STATIC_H_
+
+#if !defined(__cplusplus) || (__cplusplus < 201703L)
+#error "EXTI_static.h requiere C++17"
+#endif
+
+#include <cstdint>
+
+#include "EXTI_line.h"
+
+#if EXTI_PORT != EXTI_PORT_STM32L4
+#error "EXTI_static.h: solo para el backend STM32L4"
+#endif
+
+/* NVIC_ISER: en el simulador de host no hay NVIC que habilitar */
+#ifdef EXTI_SIM
+#define EXTI_STATIC_NVIC_ENABLE(irqn)   ((void) (irqn))
+#else
+#define EXTI_STATIC_NVIC_ENABLE(irqn)   \
+  (((volatile uint32_t *) 0xE000E100UL)[(irqn) >> 5] = 1u << ((irqn) & 31u))
+#endif
+
+namespace exti {
+
+/**
+ * \brief  Una línea de la tabla: número, disparo (kEXTI_TRIG_EDGE_*), manejador y contexto.
+ */
+template <uint32_t Line, uint32_t Trigger, __EXTI_HANDLER_t Fn, void *Ctx = nullptr>
+struct on {
+  static_assert(Line < kEXTI_GPIO_LINES, "exti::on: solo líneas GPIO (0-15)");
+  static_assert(variant::configurable(Line), "exti::on: línea no disponible en esta variante");
+  static_assert(((Trigger & mEXTI_TRIG_LEVEL) == 0u) && ((Trigger & mEXTI_TRIG_EDGE) != 0u),
+                "exti::on: EXTI solo detecta flancos");
+  static_assert(Fn != nullptr, "exti::on: manejador nulo");
+
+  static constexpr uint32_t line    = Line;
+  static constexpr uint32_t bit     = 1u << Line;
+  static constexpr uint32_t rising  = (Trigger & kEXTI_TRIG_EDGE_RISING)  ? bit : 0u;
+  static constexpr uint32_t falling = (Trigger & kEXTI_TRIG_EDGE_FALLING) ? bit : 0u;
+
+  __attribute__((always_inline)) static inline void call()
+  {
+    Fn(Line, Trigger & mEXTI_TRIG_EDGE, Ctx);
+  }
+};
+
+/**
+ * \brief  Despachador especializado para un conjunto fijo de líneas.
+ */
+template <class... Lines>
+struct static_dispatch {
+  static_assert(sizeof...(Lines) != 0u, "exti::static_dispatch: tabla vacía");
+
+  static constexpr uint32_t lines   = (0u | ... | Lines::bit);
+  static constexpr uint32_t rising  = (0u | ... | Lines::rising);
+  static constexpr uint32_t falling = (0u | ... | Lines::falling);
+
+  static_assert(__builtin_popcount(lines) == sizeof...(Lines),
+                "exti::static_dispatch: línea declarada más de una vez");
+
+  /**
+   * \brief  Rutina de servicio del vector que agrupa las líneas de VectorMask.
+   */
+  template <uint32_t VectorMask>
+  __attribute__((always_inline)) static inline void service()
+  {
+    constexpr uint32_t used = lines & VectorMask;
+
+    if constexpr (used == 0u) {
+      return;
+    } else if constexpr ((used & (used - 1u)) == 0u) {
+      EXTI_PR1_CLEAR(used);
+      (call_if<Lines, used>(used), ...);
+    } else {
+      uint32_t pend = rEXTI_PR1 & rEXTI_IMR1 & used;
+
+      EXTI_PR1_CLEAR(pend);
+      (call_if<Lines, used>(pend), ...);
+    }
+  }
+
+  /**
+   * \brief  Configura los flancos de la tabla, limpia sus pendientes, las desenmascara y
+   *         habilita sus vectores. No toca el resto de líneas.
+   */
+  static void init()
+  {
+    rEXTI_RTSR1 = (rEXTI_RTSR1 & ~lines) | rising;
+    rEXTI_FTSR1 = (rEXTI_FTSR1 & ~lines) | falling;
+    EXTI_PR1_CLEAR(lines);
+    rEXTI_IMR1  = rEXTI_IMR1 | lines;
+    for (const gpio_vector &v : variant::vectors) {
+      if ((v.lines & lines) != 0u) {
+        EXTI_STATIC_NVIC_ENABLE(v.irqn);
+      }
+    }
+  }
+
+private:
+  template <class L, uint32_t Used>
+  __attribute__((always_inline)) static inline void call_if(uint32_t pend)
+  {
+    if constexpr ((L::bit & Used) != 0u) {
+      if ((Used & (Used - 1u)) == 0u || (pend & L::bit) != 0u) {
+        L::call();
+      }
+    }
+  }
+};
+
+} /* namespace exti */
+
+/* Vectores GPIO especializados para el despachador D */
+#define EXTI_STATIC_ISR_(name, irqn, mask)                           \
+  extern "C" void name##_IRQHandler(void)                            \
+  {                                                                  \
+    exti_static_vectors_::service<(mask)>();                         \
+  }
+
+#define EXTI_STATIC_VECTORS(D)                                       \
+  using exti_static_vectors_ = D;                                    \
+  EXTI_VAR_GPIO_VECTORS(EXTI_STATIC_ISR_)
+
+#endif /* EXTI_STATIC_H_ */
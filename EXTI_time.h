@@ -0,0 +1,70 @@
+/**
+ * \file EXTI_time.h
+ * \brief Fuente de marcas de tiempo para los eventos de línea.
+ * \details EXTI_TIMESTAMP() devuelve un contador libre de 32 bits que se lee con una sola
+ * carga desde la ISR:
+ *  - STM32L4: DWT->CYCCNT (ciclos de CPU, kEXTI_TIME_HZ = frecuencia del núcleo).
+ *  - RP2040:  TIMER TIMERAWL (microsegundos, kEXTI_TIME_HZ = 1 MHz).
+ *  - Host:    con EXTI_TIME_HOOK, la función EXTI_TIME_Now() que aporta el modelo o la
+ *             simulación (nanosegundos o ciclos simulados).
+ * Las diferencias se calculan en aritmética de 32 bits sin signo, por lo que el desborde
+ * del contador es transparente mientras los intervalos sean menores que 2^32 ticks.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_TIME_H_
+#define EXTI_TIME_H_
+
+#include <stdint.h>
+
+#include "EXTI_line.h"
+
+#if defined(EXTI_TIME_HOOK)
+
+#ifdef __cplusplus
+extern "C"
+#endif
+uint32_t EXTI_TIME_Now(void);
+#define EXTI_TIMESTAMP()      EXTI_TIME_Now()
+#ifndef kEXTI_TIME_HZ
+#define kEXTI_TIME_HZ         (1000000000u)
+#endif
+#define EXTI_TIME_Init()      ((void) 0)
+
+#elif EXTI_PORT == EXTI_PORT_RP2040
+
+#define rTIMER_TIMERAWL       (*(volatile uint32_t *) 0x40054028UL)
+#define EXTI_TIMESTAMP()      (rTIMER_TIMERAWL)
+#define kEXTI_TIME_HZ         (1000000u)
+#define EXTI_TIME_Init()      ((void) 0)
+
+#else
+
+#define rDWT_CTRL             (*(volatile uint32_t *) 0xE0001000UL)
+#define rDWT_CYCCNT           (*(volatile uint32_t *) 0xE0001004UL)
+#define rCoreDebug_DEMCR      (*(volatile uint32_t *) 0xE000EDFCUL)
+#define mDWT_CTRL_CYCCNTENA   (1u << 0)
+#define mCoreDebug_DEMCR_TRCENA (1u << 24)
+
+#define EXTI_TIMESTAMP()      (rDWT_CYCCNT)
+#ifndef kEXTI_TIME_HZ
+#define kEXTI_TIME_HZ         (120000000u)  /*!< HCLK máximo de STM32L4+; redefinir si difiere */
+#endif
+
+/**
+ * \brief  Arranca el contador de ciclos DWT (necesario una vez tras el reset).
+ */
+static inline void EXTI_TIME_Init(void)
+{
+  rCoreDebug_DEMCR |= mCoreDebug_DEMCR_TRCENA;
+  rDWT_CYCCNT = 0u;
+  rDWT_CTRL |= mDWT_CTRL_CYCCNTENA;
+}
+
+#endif
+
+#endif /* EXTI_TIME_H_ */
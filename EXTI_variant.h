@@ -0,0 +1,324 @@
+/**
+ * \file EXTI_variant.h
+ * \brief Tablas de variante de chip para el periférico EXTI de la familia STM32L4.
+ * \details Describen, en tiempo de compilación, qué líneas existen en cada parte, cuáles son
+ * configurables (con detector de flanco, SWIER y PR) y cuáles directas, qué periférico hay
+ * detrás de cada línea interna y a qué vector del NVIC llega. EXIT_lib.h deriva de aquí sus
+ * máscaras _VALID/_RESERVED, y los módulos de más alto nivel usan las macros kEXTI_VAR_* o,
+ * en C++, exti::variant_traits<>, por lo que cambiar de parte es cambiar EXTI_VARIANT.
+ *
+ * Variantes soportadas (seleccionar con -DEXTI_VARIANT=...):
+ *  - EXTI_VARIANT_L4P:  STM32L4R/L4S/L4P/L4Q (RM0432), líneas 0-40. Por defecto.
+ *  - EXTI_VARIANT_L4X6: STM32L476/L486 (RM0351), líneas 0-39, con SWPMI1 y LCD.
+ *  - EXTI_VARIANT_L43X: STM32L43x/L44x (RM0394), sin UART4/UART5 ni PVM2/PVM3.
+ *
+ * La nomenclatura sigue la de EXIT_lib.h:
+ *
+ * CONSTANTES DE VARIANTE       ==>   kEXTI_ + VARIANTname + _ + CONSTANTname
+ * TABLAS X-MACRO               ==>   EXTI_ + VARIANTname + _ + TABLEname(X)
+ * VARIANTE SELECCIONADA        ==>   kEXTI_VAR_ + CONSTANTname / EXTI_VAR_ + TABLEname
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_VARIANT_H_
+#define EXTI_VARIANT_H_
+
+#include <stdint.h>
+
+/************************************************************************************************
+ * 1. Identificadores de variante
+ ************************************************************************************************/
+
+#define EXTI_VARIANT_L4P     1  /*!< STM32L4+ (L4R/L4S/L4P/L4Q) */
+#define EXTI_VARIANT_L4X6    2  /*!< STM32L476/L486 */
+#define EXTI_VARIANT_L43X    3  /*!< STM32L43x/L44x */
+
+#ifndef EXTI_VARIANT
+#define EXTI_VARIANT         EXTI_VARIANT_L4P
+#endif
+
+
+/************************************************************************************************
+ * 2. Tablas por variante
+ ************************************************************************************************/
+
+/* a. Vectores de las líneas GPIO (comunes a toda la familia L4)
+ * X(nombre, IRQn, mascara de lineas en PR1) */
+#define EXTI_L4_GPIO_VECTORS(X)            \
+  X(EXTI0,      6,  0x00000001U)           \
+  X(EXTI1,      7,  0x00000002U)           \
+  X(EXTI2,      8,  0x00000004U)           \
+  X(EXTI3,      9,  0x00000008U)           \
+  X(EXTI4,      10, 0x00000010U)           \
+  X(EXTI9_5,    23, 0x000003E0U)           \
+  X(EXTI15_10,  40, 0x0000FC00U)
+
+/* b. STM32L4+ */
+#define kEXTI_L4P_LINES1     (0xFFFFFFFFU)  /*!< Líneas 0-31 implementadas */
+#define kEXTI_L4P_CONFIG1    (0x007DFFFFU)  /*!< Líneas 0-31 configurables */
+#define kEXTI_L4P_LINES2     (0x000001FFU)  /*!< Líneas 32-40 implementadas */
+#define kEXTI_L4P_CONFIG2    (0x00000078U)  /*!< Líneas 35-38 configurables */
+
+/* X(linea, fuente, IRQn) */
+#define EXTI_L4P_SOURCES(X)                \
+  X(16, PVD,        1)                     \
+  X(17, OTG_FS,     67)                    \
+  X(18, RTC_ALARM,  41)                    \
+  X(19, RTC_TAMP,   2)                     \
+  X(20, RTC_WKUP,   3)                     \
+  X(21, COMP1,      64)                    \
+  X(22, COMP2,      64)                    \
+  X(23, I2C1,       31)                    \
+  X(24, I2C2,       33)                    \
+  X(25, I2C3,       72)                    \
+  X(26, USART1,     37)                    \
+  X(27, USART2,     38)                    \
+  X(28, USART3,     39)                    \
+  X(29, UART4,      52)                    \
+  X(30, UART5,      53)                    \
+  X(31, LPUART1,    70)                    \
+  X(32, LPTIM1,     65)                    \
+  X(33, LPTIM2,     66)                    \
+  X(35, PVM1,       1)                     \
+  X(36, PVM2,       1)                     \
+  X(37, PVM3,       1)                     \
+  X(38, PVM4,       1)                     \
+  X(40, I2C4,       82)
+
+/* c. STM32L476/L486 */
+#define kEXTI_L4X6_LINES1    (0xFFFFFFFFU)
+#define kEXTI_L4X6_CONFIG1   (0x007DFFFFU)
+#define kEXTI_L4X6_LINES2    (0x000000FFU)  /*!< Líneas 32-39 (sin I2C4) */
+#define kEXTI_L4X6_CONFIG2   (0x00000078U)
+
+#define EXTI_L4X6_SOURCES(X)               \
+  X(16, PVD,        1)                     \
+  X(17, OTG_FS,     67)                    \
+  X(18, RTC_ALARM,  41)                    \
+  X(19, RTC_TAMP,   2)                     \
+  X(20, RTC_WKUP,   3)                     \
+  X(21, COMP1,      64)                    \
+  X(22, COMP2,      64)                    \
+  X(23, I2C1,       31)                    \
+  X(24, I2C2,       33)                    \
+  X(25, I2C3,       72)                    \
+  X(26, USART1,     37)                    \
+  X(27, USART2,     38)                    \
+  X(28, USART3,     39)                    \
+  X(29, UART4,      52)                    \
+  X(30, UART5,      53)                    \
+  X(31, LPUART1,    70)                    \
+  X(32, LPTIM1,     65)                    \
+  X(33, LPTIM2,     66)                    \
+  X(34, SWPMI1,     76)                    \
+  X(35, PVM1,       1)                     \
+  X(36, PVM2,       1)                     \
+  X(37, PVM3,       1)                     \
+  X(38, PVM4,       1)                     \
+  X(39, LCD,        78)
+
+/* d. STM32L43x/L44x */
+#define kEXTI_L43X_LINES1    (0x9FFFFFFFU)  /*!< Sin líneas 29-30 (UART4/UART5) */
+#define kEXTI_L43X_CONFIG1   (0x007DFFFFU)
+#define kEXTI_L43X_LINES2    (0x000000CFU)  /*!< Líneas 32-35 y 38-39 */
+#define kEXTI_L43X_CONFIG2   (0x00000048U)  /*!< Solo PVM1 (35) y PVM4 (38) */
+
+#define EXTI_L43X_SOURCES(X)               \
+  X(16, PVD,        1)                     \
+  X(17, USB_FS,     67)                    \
+  X(18, RTC_ALARM,  41)                    \
+  X(19, RTC_TAMP,   2)                     \
+  X(20, RTC_WKUP,   3)                     \
+  X(21, COMP1,      64)                    \
+  X(22, COMP2,      64)                    \
+  X(23, I2C1,       31)                    \
+  X(24, I2C2,       33)                    \
+  X(25, I2C3,       72)                    \
+  X(26, USART1,     37)                    \
+  X(27, USART2,     38)                    \
+  X(28, USART3,     39)                    \
+  X(31, LPUART1,    70)                    \
+  X(32, LPTIM1,     65)                    \
+  X(33, LPTIM2,     66)                    \
+  X(34, SWPMI1,     76)                    \
+  X(35, PVM1,       1)                     \
+  X(38, PVM4,       1)                     \
+  X(39, LCD,        78)
+
+
+/************************************************************************************************
+ * 3. Variante seleccionada
+ ************************************************************************************************/
+
+#if EXTI_VARIANT == EXTI_VARIANT_L4P
+#define kEXTI_VAR_LINES1     kEXTI_L4P_LINES1
+#define kEXTI_VAR_CONFIG1    kEXTI_L4P_CONFIG1
+#define kEXTI_VAR_LINES2     kEXTI_L4P_LINES2
+#define kEXTI_VAR_CONFIG2    kEXTI_L4P_CONFIG2
+#define EXTI_VAR_SOURCES     EXTI_L4P_SOURCES
+#elif EXTI_VARIANT == EXTI_VARIANT_L4X6
+#define kEXTI_VAR_LINES1     kEXTI_L4X6_LINES1
+#define kEXTI_VAR_CONFIG1    kEXTI_L4X6_CONFIG1
+#define kEXTI_VAR_LINES2     kEXTI_L4X6_LINES2
+#define kEXTI_VAR_CONFIG2    kEXTI_L4X6_CONFIG2
+#define EXTI_VAR_SOURCES     EXTI_L4X6_SOURCES
+#elif EXTI_VARIANT == EXTI_VARIANT_L43X
+#define kEXTI_VAR_LINES1     kEXTI_L43X_LINES1
+#define kEXTI_VAR_CONFIG1    kEXTI_L43X_CONFIG1
+#define kEXTI_VAR_LINES2     kEXTI_L43X_LINES2
+#define kEXTI_VAR_CONFIG2    kEXTI_L43X_CONFIG2
+#define EXTI_VAR_SOURCES     EXTI_L43X_SOURCES
+#else
+#error "EXTI_VARIANT desconocida"
+#endif
+
+#define EXTI_VAR_GPIO_VECTORS  EXTI_L4_GPIO_VECTORS
+
+/* Líneas directas: implementadas pero sin detector de flanco ni bit de pendiente */
+#define kEXTI_VAR_DIRECT1    (kEXTI_VAR_LINES1 & ~kEXTI_VAR_CONFIG1)
+#define kEXTI_VAR_DIRECT2    (kEXTI_VAR_LINES2 & ~kEXTI_VAR_CONFIG2)
+
+/* Número de líneas GPIO (0-15) y línea más alta posible del bloque */
+#define kEXTI_GPIO_LINES     (16u)
+#define kEXTI_MAX_LINE       (40u)
+
+
+/************************************************************************************************
+ * 4. Macros de consulta (expresiones constantes, coste nulo en tiempo de ejecución)
+ ************************************************************************************************/
+
+/* Bit de una línea dentro de su palabra (IMR1/IMR2, ...) */
+#define EXTI_LINE_BIT(line)         (1u << ((line) & 31u))
+
+/* 1 si la línea existe en la variante seleccionada */
+#define EXTI_VAR_LINE_VALID(line)                                            \
+  (((line) < 32u) ? ((kEXTI_VAR_LINES1 >> ((line) & 31u)) & 1u)             \
+  : ((line) <= kEXTI_MAX_LINE) ? ((kEXTI_VAR_LINES2 >> ((line) & 31u)) & 1u) \
+  : 0u)
+
+/* 1 si la línea tiene detector de flanco (RTSR/FTSR/SWIER/PR) */
+#define EXTI_VAR_LINE_CONFIGURABLE(line)                                      \
+  (((line) < 32u) ? ((kEXTI_VAR_CONFIG1 >> ((line) & 31u)) & 1u)              \
+  : ((line) <= kEXTI_MAX_LINE) ? ((kEXTI_VAR_CONFIG2 >> ((line) & 31u)) & 1u) \
+  : 0u)
+
+/* IRQn del vector que atiende una línea GPIO (0-15), deducido de EXTI_VAR_GPIO_VECTORS para
+ * que la tabla sea la única fuente. No es expresión constante en C (sí constexpr en C++);
+ * sus usuarios lo llaman en la inicialización. */
+#ifdef __cplusplus
+#define EXTI_VAR_CONSTEXPR_   constexpr
+#else
+#define EXTI_VAR_CONSTEXPR_
+#endif
+
+#define EXTI_VAR_GPIO_IRQN_(name, irqn, mask)                         \
+  if ((EXTI_LINE_BIT(line) & (mask)) != 0u) {                         \
+    return (irqn);                                                    \
+  }
+
+static inline EXTI_VAR_CONSTEXPR_ uint32_t EXTI_VAR_GpioIrqn(uint32_t line)
+{
+  if (line < kEXTI_GPIO_LINES) {
+    EXTI_VAR_GPIO_VECTORS(EXTI_VAR_GPIO_IRQN_)
+  }
+  return 0xFFFFFFFFu;
+}
+
+#define EXTI_VAR_GPIO_IRQN(line)    EXTI_VAR_GpioIrqn(line)
+
+/* Comprobación en compilación de que una línea existe en la variante */
+#define EXTI_VAR_ASSERT_LINE(line)                                    \
+  _Static_assert(EXTI_VAR_LINE_VALID(line), "linea EXTI no disponible en esta variante")
+
+/* Enumeración de fuentes internas de la variante: kEXTI_SRC_<fuente> = línea */
+#define EXTI_VAR_SRC_ENUM_(line, name, irqn)   kEXTI_SRC_##name = (line),
+typedef enum {
+  EXTI_VAR_SOURCES(EXTI_VAR_SRC_ENUM_)
+  kEXTI_SRC_NONE = 0xFF
+} __EXTI_SOURCE_t;
+
+
+/************************************************************************************************
+ * 5. Rasgos de variante en C++
+ ************************************************************************************************/
+
+#ifdef __cplusplus
+#undef EXTI_VAR_ASSERT_LINE
+#define EXTI_VAR_ASSERT_LINE(line)                                    \
+  static_assert(EXTI_VAR_LINE_VALID(line), "linea EXTI no disponible en esta variante")
+
+namespace exti {
+
+/** \brief Fuente interna conectada a una línea EXTI. */
+struct line_source {
+  uint8_t     line;
+  uint8_t     irqn;
+  const char *name;
+};
+
+/** \brief Vector del NVIC compartido por un grupo de líneas GPIO. */
+struct gpio_vector {
+  uint8_t     irqn;
+  uint32_t    lines;
+  const char *name;
+};
+
+#define EXTI_VAR_CXX_SRC_(line, name, irqn)   line_source{ line, irqn, #name },
+#define EXTI_VAR_CXX_VEC_(name, irqn, mask)   gpio_vector{ irqn, mask, #name },
+
+/**
+ * \brief  Rasgos EXTI de una variante. Todos los miembros son constexpr y se resuelven
+ * en compilación; las especializaciones se generan a partir de las mismas tablas X-macro
+ * que usa C.
+ */
+template <int V> struct variant_traits;
+
+#define EXTI_VAR_CXX_TRAITS_(ID, P)                                              \
+  template <> struct variant_traits<EXTI_VARIANT_##ID> {                         \
+    static constexpr uint32_t lines1  = kEXTI_##ID##_LINES1;                     \
+    static constexpr uint32_t config1 = kEXTI_##ID##_CONFIG1;                    \
+    static constexpr uint32_t lines2  = kEXTI_##ID##_LINES2;                     \
+    static constexpr uint32_t config2 = kEXTI_##ID##_CONFIG2;                    \
+    static constexpr uint32_t direct1 = lines1 & ~config1;                       \
+    static constexpr uint32_t direct2 = lines2 & ~config2;                       \
+    static constexpr line_source sources[] = { P(EXTI_VAR_CXX_SRC_) };          \
+    static constexpr gpio_vector vectors[] = {                                   \
+      EXTI_L4_GPIO_VECTORS(EXTI_VAR_CXX_VEC_) };                                 \
+    static constexpr bool valid(unsigned line) {                                 \
+      return line < 32u ? ((lines1 >> line) & 1u) != 0u                          \
+           : line <= kEXTI_MAX_LINE ? ((lines2 >> (line - 32u)) & 1u) != 0u      \
+           : false;                                                              \
+    }                                                                            \
+    static constexpr bool configurable(unsigned line) {                          \
+      return line < 32u ? ((config1 >> line) & 1u) != 0u                         \
+           : line <= kEXTI_MAX_LINE ? ((config2 >> (line - 32u)) & 1u) != 0u     \
+           : false;                                                              \
+    }                                                                            \
+    static constexpr int irqn(unsigned line) {                                   \
+      if (line < kEXTI_GPIO_LINES) {                                             \
+        return (int) EXTI_VAR_GPIO_IRQN(line);                                   \
+      }                                                                          \
+      for (const line_source &s : sources) {                                     \
+        if (s.line == line) {                                                    \
+          return s.irqn;                                                         \
+        }                                                                        \
+      }                                                                          \
+      return -1;                                                                 \
+    }                                                                            \
+  }
+
+EXTI_VAR_CXX_TRAITS_(L4P,  EXTI_L4P_SOURCES);
+EXTI_VAR_CXX_TRAITS_(L4X6, EXTI_L4X6_SOURCES);
+EXTI_VAR_CXX_TRAITS_(L43X, EXTI_L43X_SOURCES);
+
+/** \brief Rasgos de la variante seleccionada con EXTI_VARIANT. */
+using variant = variant_traits<EXTI_VARIANT>;
+
+} /* namespace exti */
+#endif /* __cplusplus */
+
+#endif /* EXTI_VARIANT_H_ */
@@ -0,0 +1,199 @@
+/**
+ * \file EXTI_wait.c
+ * \brief Esperas de flanco con plazo sobre la rueda compartida (EXTI_wait.h).
+ */
+
+#include <stddef.h>
+
+#include "EXTI_crit.h"
+#include "EXTI_time.h"
+#include "EXTI_wait.h"
+
+static __EXTI_WAIT_t *sEXTI_WAIT_HEAD[kEXTI_LINE_COUNT];
+
+/* Lista doble por línea. Se llama con la sección crítica tomada. */
+static void wait_link(__EXTI_WAIT_t *wt)
+{
+  __EXTI_WAIT_t **head = &sEXTI_WAIT_HEAD[wt->line];
+
+  wt->prev = NULL;
+  wt->next = *head;
+  if (*head != NULL) {
+    (*head)->prev = wt;
+  }
+  *head = wt;
+}
+
+static void wait_unlink(__EXTI_WAIT_t *wt)
+{
+  if (wt->prev != NULL) {
+    wt->prev->next = wt->next;
+  } else {
+    sEXTI_WAIT_HEAD[wt->line] = wt->next;
+  }
+  if (wt->next != NULL) {
+    wt->next->prev = wt->prev;
+  }
+  wt->next = NULL;
+  wt->prev = NULL;
+}
+
+static void wait_expired(__EXTI_TIMER_t *t, void *ctx)
+{
+  __EXTI_WAIT_t *wt = (__EXTI_WAIT_t *) ctx;
+  uint32_t       s  = EXTI_CRIT_ENTER();
+
+  (void) t;
+  if (wt->state != kEXTI_WAIT_PENDING) {
+    EXTI_CRIT_EXIT(s);
+    return;
+  }
+  wait_unlink(wt);
+  wt->events = 0u;
+  wt->state  = kEXTI_WAIT_TIMEOUT;
+  EXTI_CRIT_EXIT(s);
+
+  if (wt->done != NULL) {
+    wt->done(wt, wt->ctx);
+  }
+}
+
+void EXTI_WaitInit(uint32_t now)
+{
+  for (uint32_t line = 0u; line < kEXTI_LINE_COUNT; line++) {
+    sEXTI_WAIT_HEAD[line] = NULL;
+  }
+  EXTI_WheelInit(&sEXTI_WHEEL, now);
+}
+
+__EXTI_STATUS_t EXTI_WaitAttach(uint32_t line, uint32_t trigger)
+{
+  __EXTI_STATUS_t status = EXTI_LineConfig(line, trigger, EXTI_WaitDispatch, NULL);
+
+  if (status == kEXTI_OK) {
+    EXTI_LineEnable(line);
+  }
+  return status;
+}
+
+__EXTI_STATUS_t EXTI_WaitStart(__EXTI_WAIT_t *wt, uint32_t line, uint32_t mask, uint32_t timeout,
+                               __EXTI_WAIT_DONE_t done, void *ctx)
+{
+  uint32_t s;
+
+  if (line >= kEXTI_LINE_COUNT) {
+    return kEXTI_ERR_LINE;
+  }
+  if ((mask & mEXTI_TRIG_EDGE) == 0u) {
+    return kEXTI_ERR_TRIGGER;
+  }
+
+  EXTI_TimerInit(&wt->timer, wait_expired, wt);
+  wt->line   = line;
+  wt->mask   = mask;
+  wt->events = 0u;
+  wt->ts     = 0u;
+  wt->done   = done;
+  wt->ctx    = ctx;
+
+  s = EXTI_CRIT_ENTER();
+  wt->state = kEXTI_WAIT_PENDING;
+  wait_link(wt);
+  if (timeout != kEXTI_WAIT_FOREVER) {
+    EXTI_TimerStartIn(&sEXTI_WHEEL, &wt->timer, timeout);
+  }
+  EXTI_CRIT_EXIT(s);
+  return kEXTI_OK;
+}
+
+void EXTI_WaitCancel(__EXTI_WAIT_t *wt)
+{
+  uint32_t s = EXTI_CRIT_ENTER();
+
+  if (wt->state == kEXTI_WAIT_PENDING) {
+    wait_unlink(wt);
+    (void) EXTI_TimerCancel(&sEXTI_WHEEL, &wt->timer);
+  }
+  wt->state = kEXTI_WAIT_IDLE;
+  EXTI_CRIT_EXIT(s);
+}
+
+__EXTI_WAIT_STATE_t EXTI_WaitBlocking(uint32_t line, uint32_t mask, uint32_t timeout,
+                                      uint32_t *events)
+{
+  __EXTI_WAIT_t wt;
+
+  if (EXTI_WaitStart(&wt, line, mask, timeout, NULL, NULL) != kEXTI_OK) {
+    return kEXTI_WAIT_IDLE;
+  }
+  /* Comprobación y WFI con PRIMASK = 1: si el flanco llega entre ambos, la IRQ pendiente
+   * despierta el WFI y se atiende al salir de la sección, en lugar de dormir hasta otra */
+  for (;;) {
+    uint32_t deadline;
+    uint32_t armed;
+    uint32_t s;
+
+    /* Sin tick nadie más mueve la rueda mientras se espera: se avanza aquí, fuera de la
+     * sección crítica porque ejecuta callbacks */
+    if (sEXTI_WHEEL.sleep != NULL) {
+      (void) EXTI_WheelAdvance(&sEXTI_WHEEL, EXTI_WheelNow(&sEXTI_WHEEL));
+    }
+    s = EXTI_CRIT_ENTER();
+    if (wt.state != kEXTI_WAIT_PENDING) {
+      EXTI_CRIT_EXIT(s);
+      break;
+    }
+    if (sEXTI_WHEEL.sleep == NULL) {
+      EXTI_WAIT_IDLE();
+    } else {
+      armed = EXTI_WheelNextExpiry(&sEXTI_WHEEL, &deadline);
+      if (!armed || ((int32_t) (deadline - EXTI_WheelNow(&sEXTI_WHEEL)) > 0)) {
+        sEXTI_WHEEL.sleep(armed, deadline);
+      }
+    }
+    EXTI_CRIT_EXIT(s);
+  }
+  if (events != NULL) {
+    *events = wt.events;
+  }
+  return (__EXTI_WAIT_STATE_t) wt.state;
+}
+
+void EXTI_WaitDispatch(uint32_t line, uint32_t events, void *ctx)
+{
+  __EXTI_WAIT_t *done = NULL;
+  __EXTI_WAIT_t *wt;
+  uint32_t       ts = EXTI_TIMESTAMP();
+  uint32_t       s;
+
+  (void) ctx;
+
+  /* 1. Resolver las esperas de la línea bajo la sección crítica */
+  s  = EXTI_CRIT_ENTER();
+  wt = sEXTI_WAIT_HEAD[line];
+  while (wt != NULL) {
+    __EXTI_WAIT_t *next = wt->next;
+
+    if ((events & wt->mask) != 0u) {
+      wait_unlink(wt);
+      (void) EXTI_TimerCancel(&sEXTI_WHEEL, &wt->timer);
+      wt->events = events & wt->mask;
+      wt->ts     = ts;
+      wt->state  = kEXTI_WAIT_EDGE;
+      if (wt->done != NULL) {
+        wt->next = done;
+        done     = wt;
+      }
+    }
+    wt = next;
+  }
+  EXTI_CRIT_EXIT(s);
+
+  /* 2. Callbacks fuera de la sección crítica: pueden volver a armar su espera */
+  while (done != NULL) {
+    wt   = done;
+    done = wt->next;
+    wt->next = NULL;
+    wt->done(wt, wt->ctx);
+  }
+}
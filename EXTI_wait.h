@@ -0,0 +1,136 @@
+/**
+ * \file EXTI_wait.h
+ * \brief Espera de flanco con plazo: "flanco en la línea N o abandonar tras T ticks".
+ * \details Cada espera es un objeto del llamador (sin memoria dinámica) que combina:
+ *  - un nodo en la lista de esperas de su línea, que recorre el manejador EXTI_WaitDispatch()
+ *    registrado con EXTI_WaitAttach(), y
+ *  - un temporizador en la rueda compartida sEXTI_WHEEL (EXTI_wheel.h).
+ *
+ * Al llegar el flanco el despacho cancela el plazo en O(1). Al vencer el plazo, el callback
+ * de la rueda retira la espera de la lista de la línea, también en O(1). Con cientos de
+ * esperas simultáneas, cada tick solo cuesta las ranuras que expiran.
+ *
+ * Hay dos formas de uso:
+ *  - No bloqueante: EXTI_WaitStart() + EXTI_WaitState() o un callback done, que se ejecuta
+ *    en el contexto que resuelve la espera (ISR de la línea o del tick).
+ *  - Bloqueante: EXTI_WaitBlocking(), que duerme con EXTI_WAIT_IDLE() (WFI en el destino)
+ *    hasta el flanco o el plazo. El estado se comprueba y el WFI se ejecuta con PRIMASK = 1,
+ *    como en EXTI_LoopIdle(), para que un flanco entre ambos no se pierda. Con la rueda sin
+ *    tick (reposo registrado por EXTI_LoopInit()) no hay ISR que la avance: la espera la
+ *    avanza en cada despertar y duerme con el reposo registrado hasta la próxima expiración.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_WAIT_H_
+#define EXTI_WAIT_H_
+
+#include <stdint.h>
+
+#include "EXTI_line.h"
+#include "EXTI_wheel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define kEXTI_WAIT_FOREVER    (0u)
+
+/* Espera del modo bloqueante: WFI en Cortex-M, función de la simulación en el host */
+#if defined(EXTI_WAIT_IDLE_HOOK)
+void EXTI_WAIT_Idle(void);
+#define EXTI_WAIT_IDLE()      EXTI_WAIT_Idle()
+#elif defined(__ARM_ARCH)
+#define EXTI_WAIT_IDLE()      __asm volatile("wfi" ::: "memory")
+#else
+#define EXTI_WAIT_IDLE()      ((void) 0)
+#endif
+
+/**
+ * \brief  Estado de una espera.
+ */
+typedef enum {
+  kEXTI_WAIT_IDLE    = 0,  /*!< Sin armar */
+  kEXTI_WAIT_PENDING = 1,  /*!< Armada: ni flanco ni plazo todavía */
+  kEXTI_WAIT_EDGE    = 2,  /*!< Resuelta por flanco */
+  kEXTI_WAIT_TIMEOUT = 3   /*!< Resuelta por plazo */
+} __EXTI_WAIT_STATE_t;
+
+typedef struct __EXTI_WAIT_s __EXTI_WAIT_t;
+
+/**
+ * \brief  Callback de resolución (contexto de ISR). Puede volver a armar la espera.
+ */
+typedef void (*__EXTI_WAIT_DONE_t)(__EXTI_WAIT_t *wt, void *ctx);
+
+/**
+ * \brief  Espera de flanco con plazo.
+ */
+struct __EXTI_WAIT_s {
+  __EXTI_TIMER_t      timer;    /*!< Plazo en sEXTI_WHEEL */
+  __EXTI_WAIT_t      *next;     /*!< Lista de esperas de la línea */
+  __EXTI_WAIT_t      *prev;
+  uint32_t            line;
+  uint32_t            mask;     /*!< Eventos kEXTI_TRIG_* aceptados */
+  volatile uint32_t   state;    /*!< __EXTI_WAIT_STATE_t */
+  uint32_t            events;   /*!< Eventos observados (kEXTI_WAIT_EDGE) */
+  uint32_t            ts;       /*!< EXTI_TIMESTAMP() del flanco */
+  __EXTI_WAIT_DONE_t  done;
+  void               *ctx;
+};
+
+/**
+ * \brief  Vacía las listas de esperas e inicializa sEXTI_WHEEL con el tick now.
+ */
+void EXTI_WaitInit(uint32_t now);
+
+/**
+ * \brief  Configura la línea con el disparo dado, registra EXTI_WaitDispatch() y la habilita.
+ */
+__EXTI_STATUS_t EXTI_WaitAttach(uint32_t line, uint32_t trigger);
+
+/**
+ * \brief  Arma una espera no bloqueante.
+ * \param  wt       Espera del llamador, no pendiente (debe vivir hasta resolverse o cancelarse).
+ * \param  line     Línea asociada con EXTI_WaitAttach().
+ * \param  mask     Eventos aceptados (kEXTI_TRIG_EDGE_*).
+ * \param  timeout  Plazo en ticks de sEXTI_WHEEL, o kEXTI_WAIT_FOREVER.
+ * \param  done     Callback de resolución, o NULL para consultar con EXTI_WaitState().
+ */
+__EXTI_STATUS_t EXTI_WaitStart(__EXTI_WAIT_t *wt, uint32_t line, uint32_t mask, uint32_t timeout,
+                               __EXTI_WAIT_DONE_t done, void *ctx);
+
+/**
+ * \brief  Cancela una espera pendiente (queda kEXTI_WAIT_IDLE).
+ */
+void EXTI_WaitCancel(__EXTI_WAIT_t *wt);
+
+/**
+ * \brief  Estado actual de la espera.
+ */
+static inline __EXTI_WAIT_STATE_t EXTI_WaitState(const __EXTI_WAIT_t *wt)
+{
+  return (__EXTI_WAIT_STATE_t) wt->state;
+}
+
+/**
+ * \brief  Espera bloqueante.
+ * \param  events  Eventos observados (puede ser NULL).
+ * \return kEXTI_WAIT_EDGE, kEXTI_WAIT_TIMEOUT o kEXTI_WAIT_IDLE si la línea no es válida.
+ */
+__EXTI_WAIT_STATE_t EXTI_WaitBlocking(uint32_t line, uint32_t mask, uint32_t timeout,
+                                      uint32_t *events);
+
+/**
+ * \brief  Manejador de línea registrado por EXTI_WaitAttach() (contexto de ISR).
+ */
+void EXTI_WaitDispatch(uint32_t line, uint32_t events, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_WAIT_H_ */
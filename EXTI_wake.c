@@ -0,0 +1,134 @@
+/**
+ * \file EXTI_wake.c
+ * \brief Fuentes de despertar internas de STM32L4 (EXTI_wake.h).
+ */
+
+#include "EXTI_wake.h"
+
+/* NVIC_ISER/NVIC_ISPR: en el host, el modelo de EXTI_sim.h */
+#ifdef EXTI_SIM
+#include "EXTI_sim.h"
+#define EXTI_WAKE_ISER_SET(n, m)  (sEXTI_SIM_NVIC.ISER[n] |= (m))
+#define EXTI_WAKE_ISPR(n)         (sEXTI_SIM_NVIC.ISPR[n])
+#else
+#define EXTI_WAKE_ISER_SET(n, m)  (((volatile uint32_t *) 0xE000E100UL)[n] = (m))
+#define EXTI_WAKE_ISPR(n)         (((volatile uint32_t *) 0xE000E200UL)[n])
+#endif
+
+#define kEXTI_WAKE_NVIC_WORDS     (3u)   /*!< IRQn 0-95 */
+
+/* IRQn de cada línea interna */
+#define EXTI_WAKE_IRQN_(line, name, irqn)   [line] = (irqn),
+static const uint8_t kEXTI_WAKE_IRQN[kEXTI_LINE_COUNT] = {
+  EXTI_VAR_SOURCES(EXTI_WAKE_IRQN_)
+};
+
+static __EXTI_WAKE_SET_t sEXTI_WAKE_ARMED;
+
+__EXTI_STATUS_t EXTI_WakeArm(__EXTI_WAKE_SET_t set, uint32_t trigger)
+{
+  uint32_t iser[kEXTI_WAKE_NVIC_WORDS] = { 0u, 0u, 0u };
+  uint32_t cfg1 = (uint32_t) (set & kEXTI_WAKE_CONFIG);
+  uint32_t cfg2 = (uint32_t) ((set & kEXTI_WAKE_CONFIG) >> 32);
+
+  if ((set & ~kEXTI_WAKE_SOURCES) != 0u) {
+    return kEXTI_ERR_LINE;
+  }
+  if (((trigger & mEXTI_TRIG_LEVEL) != 0u) ||
+      (((cfg1 | cfg2) != 0u) && ((trigger & mEXTI_TRIG_EDGE) == 0u))) {
+    return kEXTI_ERR_TRIGGER;
+  }
+
+  for (__EXTI_WAKE_SET_t rest = set; rest != 0u; rest &= rest - 1u) {
+    uint32_t irqn = kEXTI_WAKE_IRQN[__builtin_ctzll(rest)];
+
+    iser[irqn >> 5] |= 1u << (irqn & 31u);
+  }
+
+  /* Flancos antes que máscaras: un pendiente viejo no debe despertar al desenmascarar */
+  if (cfg1 != 0u) {
+    EXTI_PR1_CLEAR(cfg1);
+    rEXTI_RTSR1 = (trigger & kEXTI_TRIG_EDGE_RISING)  ? (rEXTI_RTSR1 | cfg1) : (rEXTI_RTSR1 & ~cfg1);
+    rEXTI_FTSR1 = (trigger & kEXTI_TRIG_EDGE_FALLING) ? (rEXTI_FTSR1 | cfg1) : (rEXTI_FTSR1 & ~cfg1);
+  }
+  if (cfg2 != 0u) {
+    EXTI_PR2_CLEAR(cfg2);
+    rEXTI_RTSR2 = (trigger & kEXTI_TRIG_EDGE_RISING)  ? (rEXTI_RTSR2 | cfg2) : (rEXTI_RTSR2 & ~cfg2);
+    rEXTI_FTSR2 = (trigger & kEXTI_TRIG_EDGE_FALLING) ? (rEXTI_FTSR2 | cfg2) : (rEXTI_FTSR2 & ~cfg2);
+  }
+  if ((uint32_t) set != 0u) {
+    rEXTI_IMR1 |= (uint32_t) set;
+  }
+  if ((uint32_t) (set >> 32) != 0u) {
+    rEXTI_IMR2 |= (uint32_t) (set >> 32);
+  }
+  for (uint32_t n = 0u; n < kEXTI_WAKE_NVIC_WORDS; n++) {
+    if (iser[n] != 0u) {
+      EXTI_WAKE_ISER_SET(n, iser[n]);
+    }
+  }
+
+  sEXTI_WAKE_ARMED |= set;
+  return kEXTI_OK;
+}
+
+void EXTI_WakeDisarm(__EXTI_WAKE_SET_t set)
+{
+  uint32_t cfg1 = (uint32_t) (set & kEXTI_WAKE_CONFIG);
+  uint32_t cfg2 = (uint32_t) ((set & kEXTI_WAKE_CONFIG) >> 32);
+
+  set &= kEXTI_WAKE_SOURCES;
+  if ((uint32_t) set != 0u) {
+    rEXTI_IMR1 &= ~(uint32_t) set;
+  }
+  if ((uint32_t) (set >> 32) != 0u) {
+    rEXTI_IMR2 &= ~(uint32_t) (set >> 32);
+  }
+  if (cfg1 != 0u) {
+    rEXTI_RTSR1 &= ~cfg1;
+    rEXTI_FTSR1 &= ~cfg1;
+  }
+  if (cfg2 != 0u) {
+    rEXTI_RTSR2 &= ~cfg2;
+    rEXTI_FTSR2 &= ~cfg2;
+  }
+  sEXTI_WAKE_ARMED &= ~set;
+}
+
+__EXTI_WAKE_SET_t EXTI_WakeArmed(void)
+{
+  return sEXTI_WAKE_ARMED;
+}
+
+__EXTI_WAKE_SET_t EXTI_WakeReason(void)
+{
+  __EXTI_WAKE_SET_t armed  = sEXTI_WAKE_ARMED;
+  __EXTI_WAKE_SET_t direct = armed & kEXTI_WAKE_DIRECT;
+  uint32_t          pr1    = rEXTI_PR1 & (uint32_t) armed & mEXTI_PR1_VALID;
+  uint32_t          pr2    = rEXTI_PR2 & (uint32_t) (armed >> 32) & mEXTI_PR2_VALID;
+  __EXTI_WAKE_SET_t why    = ((__EXTI_WAKE_SET_t) pr2 << 32) | pr1;
+
+  if (pr1 != 0u) {
+    EXTI_PR1_CLEAR(pr1);
+  }
+  if (pr2 != 0u) {
+    EXTI_PR2_CLEAR(pr2);
+  }
+
+  if (direct != 0u) {
+    uint32_t ispr[kEXTI_WAKE_NVIC_WORDS];
+
+    for (uint32_t n = 0u; n < kEXTI_WAKE_NVIC_WORDS; n++) {
+      ispr[n] = EXTI_WAKE_ISPR(n);
+    }
+    for (; direct != 0u; direct &= direct - 1u) {
+      uint32_t line = (uint32_t) __builtin_ctzll(direct);
+      uint32_t irqn = kEXTI_WAKE_IRQN[line];
+
+      if ((ispr[irqn >> 5] >> (irqn & 31u)) & 1u) {
+        why |= EXTI_WAKE(line);
+      }
+    }
+  }
+  return why;
+}
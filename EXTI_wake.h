@@ -0,0 +1,114 @@
+/**
+ * \file EXTI_wake.h
+ * \brief Fuentes de despertar internas de STM32L4 (líneas EXTI 16-40) para STOP.
+ * \details Las líneas internas de IMR1/IMR2 las gobiernan periféricos (PVD/PVM, USB, RTC,
+ * comparadores, I2C, U(S)ART, LPUART, LPTIM...). Cada una se nombra con el
+ * __EXTI_SOURCE_t de la variante (kEXTI_SRC_<fuente> = línea, EXTI_variant.h) y un conjunto
+ * de fuentes es una palabra de 64 bits con el bit de cada línea (EXTI_WAKE()), de modo que
+ * cambiar de parte solo cambia qué fuentes existen.
+ *
+ * EXTI_WakeArm() arma un conjunto con una escritura por registro (PRx, RTSRx, FTSRx, IMRx y
+ * NVIC_ISERn), no una por línea. Tras salir de STOP, EXTI_WakeReason() devuelve qué fuentes
+ * armadas han despertado al núcleo:
+ *  - Líneas configurables (PVD, PVM, RTC, COMP): bit de PRx, que se reconoce con un W1C por
+ *    palabra.
+ *  - Líneas directas (I2C, U(S)ART, LPUART, LPTIM, USB...): no tienen bit de pendiente en
+ *    EXTI; se lee el pendiente de su vector en NVIC_ISPR. Requiere dormir en modo
+ *    interrupción con PRIMASK a 1 alrededor de WFI, para que el manejador aún no haya
+ *    corrido al decodificar; el pendiente del NVIC no se toca y el manejador del periférico
+ *    se ejecuta al bajar PRIMASK.
+ * Solo se recorren las líneas directas armadas, con exploración de bits, y el resultado se
+ * recorre igual con EXTI_WakeNext().
+ *
+ * Las escrituras en IMRx/RTSRx/FTSRx son lectura-modificación-escritura como en
+ * EXTI_port_stm32l4.c: armar y desarmar desde el hilo principal, antes de dormir. Llamar
+ * tras EXTI_LineInit(), que enmascara todas las líneas.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_WAKE_H_
+#define EXTI_WAKE_H_
+
+#include <stdint.h>
+
+#include "EXTI_line.h"
+
+#if EXTI_PORT != EXTI_PORT_STM32L4
+#error "EXTI_wake.h: solo para el backend STM32L4"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief  Conjunto de fuentes: bit n = línea n (= valor de __EXTI_SOURCE_t).
+ */
+typedef uint64_t __EXTI_WAKE_SET_t;
+
+#define EXTI_WAKE(src)        ((__EXTI_WAKE_SET_t) 1u << (src))
+
+#define EXTI_WAKE_BIT_(line, name, irqn)   | EXTI_WAKE(line)
+
+/* Fuentes internas de la variante; con EXTI_DEFER su línea está reservada */
+#ifdef EXTI_DEFER
+#define kEXTI_WAKE_SOURCES    \
+  (((__EXTI_WAKE_SET_t) 0u EXTI_VAR_SOURCES(EXTI_WAKE_BIT_)) & ~EXTI_WAKE(kEXTI_DEFER_LINE))
+#else
+#define kEXTI_WAKE_SOURCES    ((__EXTI_WAKE_SET_t) 0u EXTI_VAR_SOURCES(EXTI_WAKE_BIT_))
+#endif
+
+/* Fuentes con detector de flanco (PRx) y directas (pendiente en el NVIC) */
+#define kEXTI_WAKE_CONFIG     \
+  ((((__EXTI_WAKE_SET_t) kEXTI_VAR_CONFIG2 << 32) | kEXTI_VAR_CONFIG1) & kEXTI_WAKE_SOURCES)
+#define kEXTI_WAKE_DIRECT     (kEXTI_WAKE_SOURCES & ~kEXTI_WAKE_CONFIG)
+
+/**
+ * \brief  Arma un conjunto de fuentes: desenmascara sus líneas y habilita sus vectores.
+ * \param  trigger  Flancos (kEXTI_TRIG_EDGE_*) para las líneas configurables del conjunto;
+ *                  se ignora en las directas, cuyo evento lo define el periférico.
+ * \return kEXTI_ERR_LINE si el conjunto contiene líneas que no son fuentes internas de la
+ *         variante; kEXTI_ERR_TRIGGER si trigger pide nivel o no tiene flanco y el conjunto
+ *         incluye líneas configurables.
+ */
+__EXTI_STATUS_t EXTI_WakeArm(__EXTI_WAKE_SET_t set, uint32_t trigger);
+
+/**
+ * \brief  Enmascara un conjunto de fuentes (los vectores, compartidos, siguen habilitados).
+ */
+void EXTI_WakeDisarm(__EXTI_WAKE_SET_t set);
+
+/**
+ * \brief  Fuentes armadas.
+ */
+__EXTI_WAKE_SET_t EXTI_WakeArmed(void);
+
+/**
+ * \brief  Fuentes armadas que han despertado al núcleo; reconoce sus bits de PRx.
+ */
+__EXTI_WAKE_SET_t EXTI_WakeReason(void);
+
+/**
+ * \brief  Extrae la fuente de línea más baja de *set (kEXTI_SRC_NONE si está vacío).
+ */
+static inline __EXTI_SOURCE_t EXTI_WakeNext(__EXTI_WAKE_SET_t *set)
+{
+  __EXTI_SOURCE_t src;
+
+  if (*set == 0u) {
+    return kEXTI_SRC_NONE;
+  }
+  src   = (__EXTI_SOURCE_t) __builtin_ctzll(*set);
+  *set &= *set - 1u;
+  return src;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_WAKE_H_ */
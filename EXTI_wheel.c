@@ -0,0 +1,227 @@
+/**
+ * \file EXTI_wheel.c
+ * \brief Rueda de temporización jerárquica (EXTI_wheel.h).
+ */
+
+#include <stddef.h>
+
+#include "EXTI_crit.h"
+#include "EXTI_wheel.h"
+
+__EXTI_WHEEL_t sEXTI_WHEEL;
+
+static void wheel_link(__EXTI_TIMER_LINK_t *head, __EXTI_TIMER_t *t)
+{
+  t->link.next       = head;
+  t->link.prev       = head->prev;
+  head->prev->next   = &t->link;
+  head->prev         = &t->link;
+}
+
+static void wheel_unlink(__EXTI_TIMER_t *t)
+{
+  t->link.prev->next = t->link.next;
+  t->link.next->prev = t->link.prev;
+  t->link.next       = NULL;
+  t->link.prev       = NULL;
+}
+
+/* Coloca t según su distancia a w->now (>= 0). Se llama con la sección crítica tomada. */
+static void wheel_place(__EXTI_WHEEL_t *w, __EXTI_TIMER_t *t)
+{
+  uint32_t delta = t->expires - w->now;
+  uint32_t at    = t->expires;
+  uint32_t level = 0u;
+
+  if (delta > kEXTI_WHEEL_SPAN) {
+    /* Fuera de rango: se aparca en el último nivel y se recoloca al redistribuir */
+    delta = kEXTI_WHEEL_SPAN;
+    at    = w->now + kEXTI_WHEEL_SPAN;
+  }
+  while ((level + 1u < kEXTI_WHEEL_LEVELS) && (delta >> (kEXTI_WHEEL_BITS * (level + 1u))) != 0u) {
+    level++;
+  }
+  wheel_link(&w->slot[level][(at >> (kEXTI_WHEEL_BITS * level)) & mEXTI_WHEEL_SLOT], t);
+}
+
+void EXTI_WheelInit(__EXTI_WHEEL_t *w, uint32_t now)
+{
+  w->now = now;
+  for (uint32_t l = 0u; l < kEXTI_WHEEL_LEVELS; l++) {
+    for (uint32_t s = 0u; s < kEXTI_WHEEL_SLOTS; s++) {
+      w->slot[l][s].next = &w->slot[l][s];
+      w->slot[l][s].prev = &w->slot[l][s];
+    }
+  }
+}
+
+void EXTI_TimerInit(__EXTI_TIMER_t *t, __EXTI_TIMER_FN_t fn, void *ctx)
+{
+  t->link.next = NULL;
+  t->link.prev = NULL;
+  t->expires   = 0u;
+  t->fn        = fn;
+  t->ctx       = ctx;
+}
+
+void EXTI_TimerStart(__EXTI_WHEEL_t *w, __EXTI_TIMER_t *t, uint32_t expires)
+{
+  uint32_t s = EXTI_CRIT_ENTER();
+
+  if (t->link.next != NULL) {
+    wheel_unlink(t);
+  }
+  if ((int32_t) (expires - w->now) <= 0) {
+    expires = w->now + 1u;
+  }
+  t->expires = expires;
+  wheel_place(w, t);
+  EXTI_CRIT_EXIT(s);
+}
+
+uint32_t EXTI_TimerCancel(__EXTI_WHEEL_t *w, __EXTI_TIMER_t *t)
+{
+  uint32_t s = EXTI_CRIT_ENTER();
+  uint32_t armed = (t->link.next != NULL);
+
+  (void) w;
+  if (armed) {
+    wheel_unlink(t);
+  }
+  EXTI_CRIT_EXIT(s);
+  return armed;
+}
+
+/* Redistribuye la ranura idx del nivel l hacia niveles inferiores */
+static void wheel_cascade(__EXTI_WHEEL_t *w, uint32_t l, uint32_t idx)
+{
+  __EXTI_TIMER_LINK_t *head = &w->slot[l][idx];
+
+  while (head->next != head) {
+    __EXTI_TIMER_t *t = (__EXTI_TIMER_t *) head->next;
+
+    wheel_unlink(t);
+    wheel_place(w, t);
+  }
+}
+
+uint32_t EXTI_WheelTick(__EXTI_WHEEL_t *w)
+{
+  uint32_t             s = EXTI_CRIT_ENTER();
+  uint32_t             now = w->now + 1u;
+  uint32_t             fired = 0u;
+  __EXTI_TIMER_LINK_t *head = &w->slot[0][now & mEXTI_WHEEL_SLOT];
+
+  w->now = now;
+  for (uint32_t l = 1u; l < kEXTI_WHEEL_LEVELS; l++) {
+    if (((now >> (kEXTI_WHEEL_BITS * (l - 1u))) & mEXTI_WHEEL_SLOT) != 0u) {
+      break;
+    }
+    wheel_cascade(w, l, (now >> (kEXTI_WHEEL_BITS * l)) & mEXTI_WHEEL_SLOT);
+  }
+
+  /* El callback puede armar o cancelar temporizadores: se extrae de uno en uno */
+  while (head->next != head) {
+    __EXTI_TIMER_t *t = (__EXTI_TIMER_t *) head->next;
+
+    wheel_unlink(t);
+    EXTI_CRIT_EXIT(s);
+    t->fn(t, t->ctx);
+    fired++;
+    s = EXTI_CRIT_ENTER();
+  }
+  EXTI_CRIT_EXIT(s);
+  return fired;
+}
+
+/* Primera ranura ocupada del nivel l en orden circular tras la actual (k = 1..64), o 0 */
+static uint32_t wheel_first_slot(__EXTI_WHEEL_t *w, uint32_t l)
+{
+  uint32_t cur = (w->now >> (kEXTI_WHEEL_BITS * l)) & mEXTI_WHEEL_SLOT;
+
+  for (uint32_t k = 1u; k <= kEXTI_WHEEL_SLOTS; k++) {
+    __EXTI_TIMER_LINK_t *head = &w->slot[l][(cur + k) & mEXTI_WHEEL_SLOT];
+
+    if (head->next != head) {
+      return k;
+    }
+  }
+  return 0u;
+}
+
+/* Próximo instante con trabajo: expiración en el nivel 0 o redistribución de una ranura
+ * ocupada en los niveles superiores. Se llama con la sección crítica tomada. */
+static uint32_t wheel_next_event(__EXTI_WHEEL_t *w, uint32_t *at)
+{
+  uint32_t found = 0u;
+  uint32_t best  = 0u;
+
+  for (uint32_t l = 0u; l < kEXTI_WHEEL_LEVELS; l++) {
+    uint32_t k = wheel_first_slot(w, l);
+    uint32_t shift = kEXTI_WHEEL_BITS * l;
+    uint32_t t;
+
+    if (k == 0u) {
+      continue;
+    }
+    /* Frontera del nivel l en la que se atiende la ranura: unidad (now >> shift) + k */
+    t = (l == 0u) ? (w->now + k) : ((((w->now >> shift) + k) << shift));
+    if (!found || ((t - w->now) < best)) {
+      best  = t - w->now;
+      found = 1u;
+    }
+  }
+  *at = w->now + best;
+  return found;
+}
+
+uint32_t EXTI_WheelAdvance(__EXTI_WHEEL_t *w, uint32_t now)
+{
+  uint32_t fired = 0u;
+
+  while ((int32_t) (now - w->now) > 0) {
+    uint32_t s = EXTI_CRIT_ENTER();
+    uint32_t at;
+
+    if (!wheel_next_event(w, &at) || ((int32_t) (at - now) > 0)) {
+      /* Nada que hacer antes de now: salto directo */
+      w->now = now;
+      EXTI_CRIT_EXIT(s);
+      break;
+    }
+    w->now = at - 1u;
+    EXTI_CRIT_EXIT(s);
+    fired += EXTI_WheelTick(w);
+  }
+  return fired;
+}
+
+uint32_t EXTI_WheelNextExpiry(__EXTI_WHEEL_t *w, uint32_t *expires)
+{
+  uint32_t s     = EXTI_CRIT_ENTER();
+  uint32_t found = 0u;
+  uint32_t best  = 0u;
+
+  for (uint32_t l = 0u; l < kEXTI_WHEEL_LEVELS; l++) {
+    uint32_t             k = wheel_first_slot(w, l);
+    uint32_t             cur = (w->now >> (kEXTI_WHEEL_BITS * l)) & mEXTI_WHEEL_SLOT;
+    __EXTI_TIMER_LINK_t *head;
+
+    if (k == 0u) {
+      continue;
+    }
+    /* La primera ranura ocupada del nivel contiene sus expiraciones más cercanas */
+    head = &w->slot[l][(cur + k) & mEXTI_WHEEL_SLOT];
+    for (__EXTI_TIMER_LINK_t *n = head->next; n != head; n = n->next) {
+      uint32_t d = ((const __EXTI_TIMER_t *) n)->expires - w->now;
+
+      if (!found || (d < best)) {
+        best  = d;
+        found = 1u;
+      }
+    }
+  }
+  *expires = w->now + best;
+  EXTI_CRIT_EXIT(s);
+  return found;
+}
@@ -0,0 +1,181 @@
+/**
+ * \file EXTI_wheel.h
+ * \brief Rueda de temporización jerárquica compartida, movida por un único tick hardware.
+ * \details kEXTI_WHEEL_LEVELS niveles de kEXTI_WHEEL_SLOTS ranuras. El nivel l cubre plazos
+ * de hasta 64^(l+1) ticks; la ranura se elige con los bits del instante absoluto de
+ * expiración. Cuando el índice del nivel 0 vuelve a 0, la ranura en curso del nivel 1 se
+ * redistribuye hacia abajo (y así sucesivamente), de modo que cada tick solo cuesta la ranura
+ * que expira y, cada 64 ticks, una redistribución. El coste por tick no depende del número
+ * de temporizadores armados.
+ *
+ * Los temporizadores son nodos intrusivos de lista doble: armar y cancelar son O(1) y no
+ * hay memoria dinámica. Las funciones toman la sección crítica de EXTI_crit.h, por lo que se
+ * pueden llamar desde la ISR del tick, desde otras ISRs (p. ej. el despacho EXTI) y desde el
+ * bucle principal. Los callbacks se ejecutan en el contexto de EXTI_WheelTick(), fuera de la
+ * sección crítica, y pueden volver a armar su temporizador.
+ *
+ * sEXTI_WHEEL es la rueda compartida; su tick lo da la aplicación desde su temporizador
+ * hardware (SysTick_Handler, alarma del RP2040...) con EXTI_WheelTick(&sEXTI_WHEEL).
+ *
+ * En modo sin tick (EXTI_WheelAdvance()) now solo se actualiza al despertar y puede ir
+ * retrasado todo el reposo respecto al instante real. Quien avanza la rueda registra su reloj
+ * con EXTI_WheelClock() y EXTI_WheelNow() lo lee; EXTI_TimerStartIn() y quien marque o abra
+ * plazos desde un flanco o un manejador usan EXTI_WheelNow() y no now. Con EXTI_WheelSleep()
+ * registra además su reposo con despertar programado, para las esperas bloqueantes que deben
+ * mover la rueda por su cuenta (EXTI_WaitBlocking()).
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_WHEEL_H_
+#define EXTI_WHEEL_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define kEXTI_WHEEL_BITS      (6u)
+#define kEXTI_WHEEL_SLOTS     (1u << kEXTI_WHEEL_BITS)
+#define mEXTI_WHEEL_SLOT      (kEXTI_WHEEL_SLOTS - 1u)
+#ifndef kEXTI_WHEEL_LEVELS
+#define kEXTI_WHEEL_LEVELS    (4u)     /*!< 4 niveles: plazos hasta 2^24 ticks sin recolocar */
+#endif
+#define kEXTI_WHEEL_SPAN      ((1u << (kEXTI_WHEEL_BITS * kEXTI_WHEEL_LEVELS)) - 1u)
+
+typedef struct __EXTI_TIMER_LINK_s {
+  struct __EXTI_TIMER_LINK_s *next;
+  struct __EXTI_TIMER_LINK_s *prev;
+} __EXTI_TIMER_LINK_t;
+
+typedef struct __EXTI_TIMER_s __EXTI_TIMER_t;
+
+/**
+ * \brief  Callback de expiración (contexto de EXTI_WheelTick()).
+ */
+typedef void (*__EXTI_TIMER_FN_t)(__EXTI_TIMER_t *t, void *ctx);
+
+/**
+ * \brief  Temporizador. Debe inicializarse con EXTI_TimerInit() antes de armarlo.
+ */
+struct __EXTI_TIMER_s {
+  __EXTI_TIMER_LINK_t link;     /*!< Enlace en la ranura; next = NULL si no está armado */
+  uint32_t            expires;  /*!< Tick absoluto de expiración */
+  __EXTI_TIMER_FN_t   fn;
+  void               *ctx;
+};
+
+/**
+ * \brief  Reposo del modo sin tick (EXTI_WheelSleep()).
+ */
+typedef void (*__EXTI_WHEEL_SLEEP_t)(uint32_t armed, uint32_t deadline);
+
+/**
+ * \brief  Rueda de temporización.
+ */
+typedef struct {
+  volatile uint32_t    now;     /*!< Último tick procesado */
+  uint32_t           (*clock)(void); /*!< Reloj del modo sin tick (NULL: now es el actual) */
+  __EXTI_WHEEL_SLEEP_t sleep;   /*!< Reposo del modo sin tick (NULL: lo da la aplicación) */
+  __EXTI_TIMER_LINK_t  slot[kEXTI_WHEEL_LEVELS][kEXTI_WHEEL_SLOTS];
+} __EXTI_WHEEL_t;
+
+extern __EXTI_WHEEL_t sEXTI_WHEEL;
+
+/**
+ * \brief  Inicializa la rueda vacía con el tick actual now. No modifica el reloj ni el
+ * reposo registrados.
+ */
+void EXTI_WheelInit(__EXTI_WHEEL_t *w, uint32_t now);
+
+/**
+ * \brief  Registra el reloj con el que se avanza la rueda en modo sin tick (NULL: modo tick).
+ */
+static inline void EXTI_WheelClock(__EXTI_WHEEL_t *w, uint32_t (*clock)(void))
+{
+  w->clock = clock;
+}
+
+/**
+ * \brief  Registra el reposo del modo sin tick: duerme hasta una interrupción y, con
+ * armed != 0, programa antes el despertar en el tick deadline. Se llama con PRIMASK = 1.
+ */
+static inline void EXTI_WheelSleep(__EXTI_WHEEL_t *w, __EXTI_WHEEL_SLEEP_t sleep)
+{
+  w->sleep = sleep;
+}
+
+/**
+ * \brief  Tick actual: el reloj registrado o, en modo tick, el último tick procesado.
+ */
+static inline uint32_t EXTI_WheelNow(const __EXTI_WHEEL_t *w)
+{
+  return (w->clock != 0) ? w->clock() : w->now;
+}
+
+/**
+ * \brief  Avanza un tick y ejecuta los temporizadores que expiran.
+ * \return Número de callbacks ejecutados.
+ */
+uint32_t EXTI_WheelTick(__EXTI_WHEEL_t *w);
+
+/**
+ * \brief  Avanza la rueda hasta el tick now ejecutando en orden los temporizadores vencidos.
+ * \details Modo sin tick: en lugar de un tick por periodo, la aplicación llama a esta función
+ * al despertar. Solo se procesan los instantes con trabajo (expiraciones y redistribuciones
+ * de ranuras ocupadas); los tramos vacíos se saltan de una vez.
+ * \return Número de callbacks ejecutados.
+ */
+uint32_t EXTI_WheelAdvance(__EXTI_WHEEL_t *w, uint32_t now);
+
+/**
+ * \brief  Próxima expiración exacta.
+ * \param  expires  Tick absoluto de la expiración más cercana.
+ * \return 1 si hay algún temporizador armado, 0 si la rueda está vacía.
+ */
+uint32_t EXTI_WheelNextExpiry(__EXTI_WHEEL_t *w, uint32_t *expires);
+
+/**
+ * \brief  Prepara un temporizador desarmado.
+ */
+void EXTI_TimerInit(__EXTI_TIMER_t *t, __EXTI_TIMER_FN_t fn, void *ctx);
+
+/**
+ * \brief  Arma (o rearma) el temporizador para el tick absoluto expires. Un instante ya
+ * pasado expira en el siguiente tick.
+ */
+void EXTI_TimerStart(__EXTI_WHEEL_t *w, __EXTI_TIMER_t *t, uint32_t expires);
+
+/**
+ * \brief  Arma el temporizador para dentro de ticks ticks (mínimo 1), contados desde
+ * EXTI_WheelNow(): en modo sin tick un manejador que se ejecuta tras un reposo largo, antes
+ * de que la rueda avance, no obtiene un plazo ya vencido.
+ */
+static inline void EXTI_TimerStartIn(__EXTI_WHEEL_t *w, __EXTI_TIMER_t *t, uint32_t ticks)
+{
+  EXTI_TimerStart(w, t, EXTI_WheelNow(w) + ((ticks != 0u) ? ticks : 1u));
+}
+
+/**
+ * \brief  Cancela el temporizador en O(1).
+ * \return 1 si estaba armado, 0 si ya había expirado o no se armó.
+ */
+uint32_t EXTI_TimerCancel(__EXTI_WHEEL_t *w, __EXTI_TIMER_t *t);
+
+/**
+ * \brief  1 si el temporizador está armado.
+ */
+static inline uint32_t EXTI_TimerPending(const __EXTI_TIMER_t *t)
+{
+  return t->link.next != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_WHEEL_H_ */
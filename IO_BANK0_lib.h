@@ -0,0 +1,139 @@
+/**
+ * \file IO_BANK0_lib.h
+ * \brief Librería hardware para las interrupciones GPIO del bloque IO_BANK0 del RP2040.
+ * \details Declara únicamente la parte de IO_BANK0 que interviene en las interrupciones de
+ * pin (INTR, PROCx_INTE/INTF/INTS y DORMANT_WAKE_*). Sigue la misma nomenclatura que
+ * EXIT_lib.h para que ambos backends de EXTI_line se lean igual.
+ *
+ * Cada registro de interrupción agrupa 8 GPIO; cada GPIO ocupa un nibble con el orden
+ * LEVEL_LOW (bit 0), LEVEL_HIGH (bit 1), EDGE_LOW (bit 2), EDGE_HIGH (bit 3).
+ * Los bits EDGE de INTR se limpian escribiendo '1' (W1C); los bits LEVEL reflejan el pin.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ *
+ * La nomenclatura seguida es:
+ *
+ * ESTRUCTURA DE MODULO         ==>   s + MODULEname
+ * REGISTRO MMIO                ==>   r + MODULEname + _ + REGISTERname
+ * CONSTANTES DE BITFIELD       ==>   k + MODULEname + _ + BITFIELDname + _ + CONSTANTname
+ * MASCARAS DE REGISTRO         ==>   m + MODULEname + _ + REGISTERname + _ + BITFIELDname
+ * TIPO DE ESTRUCTURA           ==>   __ + MODULEname + _t
+ */
+
+#ifndef IO_BANK0_LIB_H_
+#define IO_BANK0_LIB_H_
+
+#include <stdint.h>
+
+/************************************************************************************************
+ * 1. Definicion de registros
+ ************************************************************************************************/
+
+/* c. Constantes */
+#define kIO_BANK0_NGPIO            (30u)  /*!< GPIO0-GPIO29 */
+#define kIO_BANK0_NREGS            (4u)   /*!< Registros de interrupción por grupo (8 GPIO c/u) */
+#define kIO_BANK0_GPIO_PER_REG     (8u)
+
+#define kIO_BANK0_INT_LEVEL_LOW    (1u << 0)  /*!< Nivel bajo en el pin */
+#define kIO_BANK0_INT_LEVEL_HIGH   (1u << 1)  /*!< Nivel alto en el pin */
+#define kIO_BANK0_INT_EDGE_LOW     (1u << 2)  /*!< Flanco de bajada (latcheado, W1C) */
+#define kIO_BANK0_INT_EDGE_HIGH    (1u << 3)  /*!< Flanco de subida (latcheado, W1C) */
+
+/* b. Mascaras */
+#define mIO_BANK0_INT_NIBBLE       (0xFu)
+#define mIO_BANK0_INT_EDGES        (0xCCCCCCCCU)  /*!< Bits EDGE de los 8 GPIO de un registro */
+#define mIO_BANK0_INT_LEVELS       (0x33333333U)  /*!< Bits LEVEL de los 8 GPIO de un registro */
+
+/* Registro y desplazamiento del nibble de un GPIO */
+#define IO_BANK0_INT_REG(gpio)     ((gpio) >> 3)
+#define IO_BANK0_INT_SHIFT(gpio)   (((gpio) & 7u) << 2)
+
+
+/************************************************************************************************
+ * 2. Definicion de estructura del modulo
+ ************************************************************************************************/
+
+/* a. Tipos */
+/**
+ * \brief  Registros STATUS/CTRL de un GPIO (no se usan desde EXTI_line, solo ocupan espacio).
+ */
+typedef struct {
+  volatile uint32_t STATUS;   /*!< Offset 0x00 */
+  volatile uint32_t CTRL;     /*!< Offset 0x04 */
+} __IO_BANK0_GPIO_t;
+
+/**
+ * \brief  Estructura del módulo IO_BANK0 (RP2040 datasheet, 2.19.6.1).
+ */
+typedef struct {
+  __IO_BANK0_GPIO_t GPIO[kIO_BANK0_NGPIO];          /*!< Offset 0x000-0x0EC */
+  volatile uint32_t INTR[kIO_BANK0_NREGS];          /*!< Offset 0x0F0: Raw interrupts */
+  volatile uint32_t PROC0_INTE[kIO_BANK0_NREGS];    /*!< Offset 0x100: Enable core 0 */
+  volatile uint32_t PROC0_INTF[kIO_BANK0_NREGS];    /*!< Offset 0x110: Force core 0 */
+  volatile uint32_t PROC0_INTS[kIO_BANK0_NREGS];    /*!< Offset 0x120: Status core 0 */
+  volatile uint32_t PROC1_INTE[kIO_BANK0_NREGS];    /*!< Offset 0x130: Enable core 1 */
+  volatile uint32_t PROC1_INTF[kIO_BANK0_NREGS];    /*!< Offset 0x140: Force core 1 */
+  volatile uint32_t PROC1_INTS[kIO_BANK0_NREGS];    /*!< Offset 0x150: Status core 1 */
+  volatile uint32_t DORMANT_WAKE_INTE[kIO_BANK0_NREGS]; /*!< Offset 0x160 */
+  volatile uint32_t DORMANT_WAKE_INTF[kIO_BANK0_NREGS]; /*!< Offset 0x170 */
+  volatile uint32_t DORMANT_WAKE_INTS[kIO_BANK0_NREGS]; /*!< Offset 0x180 */
+} __IO_BANK0_t;
+
+/* c. Macros de acceso */
+/**
+ * \brief  Dirección base y puntero al bloque IO_BANK0.
+ * \details Con IO_BANK0_SIM el bloque es una variable en RAM (sIO_BANK0_SIM) y las escrituras
+ * atómicas y W1C se emulan en software (host/IO_BANK0_sim.c).
+ */
+#ifndef IO_BANK0_BASE
+#define IO_BANK0_BASE              (0x40014000UL)
+#endif
+
+/* Alias atómicos del bus APB del RP2040 */
+#define kIO_BANK0_ALIAS_SET        (0x2000UL)
+#define kIO_BANK0_ALIAS_CLR        (0x3000UL)
+
+#ifndef sIO_BANK0
+#ifdef IO_BANK0_SIM
+extern __IO_BANK0_t sIO_BANK0_SIM;
+#define sIO_BANK0                  (&sIO_BANK0_SIM)
+#else
+#define sIO_BANK0                  ((__IO_BANK0_t *) IO_BANK0_BASE)
+#endif
+#endif
+
+
+/************************************************************************************************
+ * 3. Macros de acceso a registros
+ ************************************************************************************************/
+
+/* a. Acceso completo */
+#define rIO_BANK0_INTR(n)          (sIO_BANK0->INTR[(n)])
+#define rIO_BANK0_PROC0_INTE(n)    (sIO_BANK0->PROC0_INTE[(n)])
+#define rIO_BANK0_PROC0_INTF(n)    (sIO_BANK0->PROC0_INTF[(n)])
+#define rIO_BANK0_PROC0_INTS(n)    (sIO_BANK0->PROC0_INTS[(n)])
+#define rIO_BANK0_PROC1_INTE(n)    (sIO_BANK0->PROC1_INTE[(n)])
+#define rIO_BANK0_PROC1_INTF(n)    (sIO_BANK0->PROC1_INTF[(n)])
+#define rIO_BANK0_PROC1_INTS(n)    (sIO_BANK0->PROC1_INTS[(n)])
+
+/* b. Escrituras atómicas y W1C
+ * En el hardware se usan los alias SET/CLR (sin lectura-modificación-escritura) y una sola
+ * escritura en INTR para reconocer todos los flancos de un registro. */
+#ifdef IO_BANK0_SIM
+void IO_BANK0_SIM_ClearIntr(uint32_t n, uint32_t mask);
+void IO_BANK0_SIM_Update(void);
+#define IO_BANK0_INTR_CLEAR(n, m)  IO_BANK0_SIM_ClearIntr((n), (m))
+#define IO_BANK0_REG_SET(reg, m)   do { (reg) |= (m); IO_BANK0_SIM_Update(); } while (0)
+#define IO_BANK0_REG_CLR(reg, m)   do { (reg) &= ~(m); IO_BANK0_SIM_Update(); } while (0)
+#else
+#define IO_BANK0_INTR_CLEAR(n, m)  (rIO_BANK0_INTR(n) = (m))
+#define IO_BANK0_REG_SET(reg, m)   \
+  (*(volatile uint32_t *) ((uintptr_t) &(reg) + kIO_BANK0_ALIAS_SET) = (m))
+#define IO_BANK0_REG_CLR(reg, m)   \
+  (*(volatile uint32_t *) ((uintptr_t) &(reg) + kIO_BANK0_ALIAS_CLR) = (m))
+#endif
+
+#endif /* IO_BANK0_LIB_H_ */
@@ -0,0 +1,82 @@
+/**
+ * \file EXTI_energy.c
+ * \brief Modelo de energía y de despertares (EXTI_energy.h).
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "EXTI_energy.h"
+
+#define EXTI_ENERGY_CHIP_(id, name, mv, hz, run_ua, stop_na, wake_ns, irq, event) \
+  { #id, name, mv, hz, run_ua, stop_na, wake_ns, irq, event },
+
+const __EXTI_ENERGY_CHIP_t kEXTI_ENERGY_CHIP[] = {
+  EXTI_ENERGY_CHIPS(EXTI_ENERGY_CHIP_)
+};
+
+const uint32_t kEXTI_ENERGY_CHIP_COUNT = sizeof(kEXTI_ENERGY_CHIP) / sizeof(kEXTI_ENERGY_CHIP[0]);
+
+static uint64_t energy_ns(const __EXTI_ENERGY_CHIP_t *chip, uint64_t cycles)
+{
+  return (cycles * 1000000000u + chip->hz - 1u) / chip->hz;
+}
+
+const __EXTI_ENERGY_CHIP_t *EXTI_ENERGY_Chip(const char *id)
+{
+  for (uint32_t i = 0u; i < kEXTI_ENERGY_CHIP_COUNT; i++) {
+    if (strcmp(kEXTI_ENERGY_CHIP[i].id, id) == 0) {
+      return &kEXTI_ENERGY_CHIP[i];
+    }
+  }
+  return NULL;
+}
+
+void EXTI_ENERGY_Reset(__EXTI_ENERGY_t *e, const __EXTI_ENERGY_CHIP_t *chip)
+{
+  memset(e, 0, sizeof(*e));
+  e->chip = chip;
+}
+
+void EXTI_ENERGY_Enter(__EXTI_ENERGY_t *e, uint64_t t_ns, __EXTI_ENERGY_PATH_t path)
+{
+  uint64_t cycles = (path == kEXTI_ENERGY_EVENT) ? e->chip->event_cycles : e->chip->irq_cycles;
+  uint64_t start  = t_ns;
+
+  e->activations[path]++;
+  if (t_ns >= e->cursor) {
+    /* En STOP: transición de salida antes de la primera instrucción */
+    e->wakes[path]++;
+    e->wake_ns  += e->chip->wake_ns;
+    e->awake_ns += e->chip->wake_ns;
+    start       += e->chip->wake_ns;
+  } else {
+    /* Despierto: encadenada tras el trabajo en curso */
+    start = e->cursor;
+  }
+  e->cursor    = start + energy_ns(e->chip, cycles);
+  e->awake_ns += e->cursor - start;
+}
+
+void EXTI_ENERGY_Work(__EXTI_ENERGY_t *e, uint32_t cycles)
+{
+  uint64_t ns = energy_ns(e->chip, cycles);
+
+  e->work_cycles += cycles;
+  e->cursor      += ns;
+  e->awake_ns    += ns;
+}
+
+void EXTI_ENERGY_Report(const __EXTI_ENERGY_t *e, uint64_t span_ns, __EXTI_ENERGY_REPORT_t *r)
+{
+  const __EXTI_ENERGY_CHIP_t *chip  = e->chip;
+  double                      v     = chip->mv * 1e-3;
+  double                      scale = 3600e9 / (double) span_ns * 1e3;   /* J -> mJ/h */
+  uint64_t                    awake = (e->awake_ns < span_ns) ? e->awake_ns : span_ns;
+
+  r->stop     = v * chip->stop_na * 1e-9 * (double) (span_ns - awake) * 1e-9 * scale;
+  r->wake     = v * chip->run_ua * 1e-6 * (double) e->wake_ns * 1e-9 * scale;
+  r->run      = v * chip->run_ua * 1e-6 * (double) (e->awake_ns - e->wake_ns) * 1e-9 * scale;
+  r->total    = r->stop + r->wake + r->run;
+  r->stop_pct = 100.0 * (double) (span_ns - awake) / (double) span_ns;
+}
@@ -0,0 +1,123 @@
+/**
+ * \file EXTI_energy.h
+ * \brief Modelo de energía y de despertares para configuraciones EXTI en el simulador.
+ * \details El llamador marca cada activación del núcleo en tiempo virtual (EXTI_ENERGY_Enter,
+ * EXTI_ENERGY_Work) y el modelo acumula:
+ *  - Despertares desde STOP por camino: interrupción EXTI, evento EMR (WFE, sin entrada ni
+ *    salida de excepción) o temporizador de bajo consumo (LPTIM/RTC, para la rueda). Una
+ *    activación que llega con el núcleo despierto se encadena tras la anterior sin coste de
+ *    despertar.
+ *  - Tiempo despierto: transición de salida de STOP, sobrecoste de entrada/salida del camino
+ *    y ciclos de trabajo de los manejadores.
+ *  - Residencia en STOP: el resto del intervalo.
+ * La energía se estima con la tabla de parámetros de cada chip (tensión, corriente en
+ * ejecución a su frecuencia, corriente en STOP2, tiempo de salida de STOP contado a corriente
+ * de ejecución y ciclos por camino) y se expresa en mJ/hora. Los valores de la tabla son
+ * típicos de hoja de datos a 3 V y 25 °C; para comparar estrategias importa su proporción.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_ENERGY_H_
+#define EXTI_ENERGY_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* X(id, nombre, mV, Hz, uA en ejecución, nA en STOP2, ns de salida de STOP,
+ *   ciclos camino IRQ, ciclos camino evento) */
+#define EXTI_ENERGY_CHIPS(X)                                                                   \
+  X(L4P,     "STM32L4R5 120 MHz",      3000u, 120000000u, 13200u, 2800u, 6500u, 48u, 8u)       \
+  X(L4X6,    "STM32L476 80 MHz",       3000u,  80000000u,  8000u, 1400u, 5700u, 48u, 8u)       \
+  X(L43X,    "STM32L432 80 MHz",       3000u,  80000000u,  6700u, 1000u, 5000u, 48u, 8u)       \
+  X(L43X_LP, "STM32L432 16 MHz rng 2", 3000u,  16000000u,  1100u, 1000u, 8000u, 48u, 8u)
+
+/**
+ * \brief  Parámetros de un chip.
+ */
+typedef struct {
+  const char *id;
+  const char *name;
+  uint32_t    mv;           /*!< Tensión de alimentación */
+  uint32_t    hz;           /*!< Frecuencia del núcleo al despertar */
+  uint32_t    run_ua;       /*!< Corriente en ejecución a hz */
+  uint32_t    stop_na;      /*!< Corriente en STOP2 */
+  uint32_t    wake_ns;      /*!< Salida de STOP hasta la primera instrucción */
+  uint32_t    irq_cycles;   /*!< Entrada + salida de excepción y vuelta a WFI */
+  uint32_t    event_cycles; /*!< Vuelta de WFE y del bucle de espera */
+} __EXTI_ENERGY_CHIP_t;
+
+/**
+ * \brief  Camino por el que arranca una activación.
+ */
+typedef enum {
+  kEXTI_ENERGY_IRQ   = 0,   /*!< Interrupción EXTI (IMR) */
+  kEXTI_ENERGY_EVENT = 1,   /*!< Evento EXTI (EMR) con WFE */
+  kEXTI_ENERGY_TIMER = 2,   /*!< Temporizador de bajo consumo (interrupción) */
+  kEXTI_ENERGY_PATHS = 3
+} __EXTI_ENERGY_PATH_t;
+
+/**
+ * \brief  Acumulador de una ejecución.
+ */
+typedef struct {
+  const __EXTI_ENERGY_CHIP_t *chip;
+  uint64_t cursor;                            /*!< Fin del trabajo en curso [ns] */
+  uint64_t awake_ns;                          /*!< Tiempo fuera de STOP */
+  uint64_t wake_ns;                           /*!< Parte de awake_ns en transiciones */
+  uint64_t work_cycles;                       /*!< Ciclos de manejadores */
+  uint32_t wakes[kEXTI_ENERGY_PATHS];         /*!< Despertares desde STOP */
+  uint32_t activations[kEXTI_ENERGY_PATHS];   /*!< Activaciones (con y sin despertar) */
+} __EXTI_ENERGY_t;
+
+/**
+ * \brief  Desglose de la energía en mJ/hora.
+ */
+typedef struct {
+  double stop;      /*!< Residencia en STOP */
+  double wake;      /*!< Transiciones de salida de STOP */
+  double run;       /*!< Sobrecoste de camino y manejadores */
+  double total;
+  double stop_pct;  /*!< Residencia en STOP (% del intervalo) */
+} __EXTI_ENERGY_REPORT_t;
+
+extern const __EXTI_ENERGY_CHIP_t kEXTI_ENERGY_CHIP[];
+extern const uint32_t             kEXTI_ENERGY_CHIP_COUNT;
+
+/**
+ * \brief  Parámetros de un chip por id (NULL si no existe).
+ */
+const __EXTI_ENERGY_CHIP_t *EXTI_ENERGY_Chip(const char *id);
+
+/**
+ * \brief  Vacía el acumulador; el núcleo está en STOP desde t = 0.
+ */
+void EXTI_ENERGY_Reset(__EXTI_ENERGY_t *e, const __EXTI_ENERGY_CHIP_t *chip);
+
+/**
+ * \brief  Activación en el instante t_ns por el camino dado: despierta si el núcleo está en
+ *         STOP y suma el sobrecoste del camino.
+ */
+void EXTI_ENERGY_Enter(__EXTI_ENERGY_t *e, uint64_t t_ns, __EXTI_ENERGY_PATH_t path);
+
+/**
+ * \brief  Ciclos de trabajo de un manejador dentro de la activación en curso.
+ */
+void EXTI_ENERGY_Work(__EXTI_ENERGY_t *e, uint32_t cycles);
+
+/**
+ * \brief  Energía de los span_ns primeros nanosegundos.
+ */
+void EXTI_ENERGY_Report(const __EXTI_ENERGY_t *e, uint64_t span_ns, __EXTI_ENERGY_REPORT_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_ENERGY_H_ */
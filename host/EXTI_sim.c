@@ -0,0 +1,90 @@
+/**
+ * \file EXTI_sim.c
+ * \brief Implementación del modelo de host del periférico EXTI.
+ */
+
+#include <string.h>
+
+#include "EXTI_sim.h"
+
+__EXTI_t          sEXTI_SIM;
+__EXTI_SIM_NVIC_t sEXTI_SIM_NVIC;
+
+#define EXTI_SIM_IRQN_CASE_(line, name, irqn)   case (line): return (irqn);
+
+static uint32_t sim_irqn(uint32_t line)
+{
+  if (line < kEXTI_GPIO_LINES) {
+    return EXTI_VAR_GPIO_IRQN(line);
+  }
+  switch (line) {
+    EXTI_VAR_SOURCES(EXTI_SIM_IRQN_CASE_)
+    default: return 0xFFFFFFFFu;
+  }
+}
+
+static uint32_t sim_request(uint32_t line, uint32_t req)
+{
+  uint32_t irqn = sim_irqn(line);
+
+  if (req && (irqn != 0xFFFFFFFFu)) {
+    sEXTI_SIM_NVIC.ISPR[irqn >> 5] |= 1u << (irqn & 31u);
+  }
+  return req;
+}
+
+void EXTI_SIM_Reset(void)
+{
+  memset((void *) &sEXTI_SIM, 0, sizeof(sEXTI_SIM));
+  memset(&sEXTI_SIM_NVIC, 0, sizeof(sEXTI_SIM_NVIC));
+  rEXTI_IMR1 = kEXTI_SIM_IMR1_RESET;
+  rEXTI_IMR2 = kEXTI_SIM_IMR2_RESET;
+}
+
+uint32_t EXTI_SIM_Edge(uint32_t line, uint32_t rising)
+{
+  if (line < 32u) {
+    uint32_t bit = 1u << line;
+
+    /* Linea directa: sin deteccion de flanco ni bit de pendiente */
+    if ((bit & mEXTI_PR1_VALID) == 0u) {
+      return sim_request(line, (rEXTI_IMR1 & bit) != 0u);
+    }
+    if ((rising ? rEXTI_RTSR1 : rEXTI_FTSR1) & bit) {
+      rEXTI_PR1 |= bit;
+    }
+    return sim_request(line, (rEXTI_PR1 & rEXTI_IMR1 & bit) != 0u);
+  }
+
+  if (line <= 40u) {
+    uint32_t bit = 1u << (line - 32u);
+
+    if ((bit & mEXTI_PR2_VALID) == 0u) {
+      return sim_request(line, (rEXTI_IMR2 & bit) != 0u);
+    }
+    if ((rising ? rEXTI_RTSR2 : rEXTI_FTSR2) & bit) {
+      rEXTI_PR2 |= bit;
+    }
+    return sim_request(line, (rEXTI_PR2 & rEXTI_IMR2 & bit) != 0u);
+  }
+
+  return 0u;
+}
+
+void EXTI_SIM_ClearPending1(uint32_t mask)
+{
+  rEXTI_PR1    &= ~(mask & mEXTI_PR1_VALID);
+  rEXTI_SWIER1 &= ~(mask & mEXTI_SWIER1_VALID);
+}
+
+void EXTI_SIM_ClearPending2(uint32_t mask)
+{
+  rEXTI_PR2 &= ~(mask & mEXTI_PR2_VALID);
+}
+
+void EXTI_SIM_Software1(uint32_t mask)
+{
+  mask         &= mEXTI_SWIER1_VALID;
+  rEXTI_SWIER1 |= mask;
+  rEXTI_PR1    |= mask;
+}
@@ -0,0 +1,75 @@
+/**
+ * \file EXTI_sim.h
+ * \brief Modelo de host del periférico EXTI para pruebas y medidas sin hardware.
+ * \details El bloque simulado (sEXTI_SIM) tiene exactamente la misma disposición que
+ * __EXTI_t y se accede con las mismas macros rEXTI_* / bEXTI_* de EXIT_lib.h cuando se
+ * compila con EXTI_SIM. Las funciones de este módulo reproducen la lógica que el hardware
+ * aplica por su cuenta: valores de reset, detección de flanco y limpieza W1C de PRx.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef EXTI_SIM_H_
+#define EXTI_SIM_H_
+
+#include <stdint.h>
+
+#include "EXIT_lib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Valores de reset del bloque: las líneas directas de la variante salen desenmascaradas */
+#define kEXTI_SIM_IMR1_RESET   (kEXTI_VAR_DIRECT1)
+#define kEXTI_SIM_IMR2_RESET   (kEXTI_VAR_DIRECT2)
+
+/**
+ * \brief  Bits de habilitación y de pendiente del NVIC (IRQn 0-95) que ven los drivers que
+ * los consultan (EXTI_wake.c). Un flanco que genera petición marca el pendiente del vector
+ * de su línea; nada lo limpia salvo EXTI_SIM_Reset().
+ */
+typedef struct {
+  uint32_t ISER[3];
+  uint32_t ISPR[3];
+} __EXTI_SIM_NVIC_t;
+
+extern __EXTI_SIM_NVIC_t sEXTI_SIM_NVIC;
+
+/**
+ * \brief  Restaura el bloque simulado (y el NVIC simulado) a sus valores de reset.
+ */
+void EXTI_SIM_Reset(void);
+
+/**
+ * \brief  Aplica un flanco sobre una línea EXTI como lo haría el detector de flancos.
+ * \param  line    Número de línea (0-40).
+ * \param  rising  1 para flanco de subida, 0 para flanco de bajada.
+ * \return 1 si el flanco genera una petición de interrupción hacia el NVIC, 0 si no.
+ * \details En las líneas configurables el flanco se registra en PRx si está habilitado en
+ * RTSRx/FTSRx. Las líneas directas no tienen bit de pendiente: solo dependen de IMRx. Si hay
+ * petición se marca el pendiente del vector de la línea en sEXTI_SIM_NVIC.
+ */
+uint32_t EXTI_SIM_Edge(uint32_t line, uint32_t rising);
+
+/**
+ * \brief  Emula la escritura W1C (write-1-to-clear) sobre PR1 y PR2.
+ * \details En el hardware basta con escribir la máscara en PRx; sobre RAM esa escritura
+ * sobrescribiría el registro, por lo que el simulador limpia los bits explícitamente.
+ */
+void EXTI_SIM_ClearPending1(uint32_t mask);
+void EXTI_SIM_ClearPending2(uint32_t mask);
+
+/**
+ * \brief  Emula la escritura en SWIER1: marca SWIx y PIFx de las líneas configurables.
+ */
+void EXTI_SIM_Software1(uint32_t mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXTI_SIM_H_ */
@@ -0,0 +1,83 @@
+/**
+ * \file IO_BANK0_sim.c
+ * \brief Implementación del modelo de host de IO_BANK0.
+ */
+
+#include <string.h>
+
+#include "IO_BANK0_sim.h"
+
+__IO_BANK0_t sIO_BANK0_SIM;
+
+static uint32_t sIO_BANK0_SIM_PINS;  /*!< Nivel actual de GPIO0-GPIO29 */
+
+/* Bits LEVEL de un registro a partir del nivel de sus 8 pines */
+static uint32_t io_bank0_sim_levels(uint32_t n)
+{
+  uint32_t levels = 0u;
+
+  for (uint32_t i = 0u; i < kIO_BANK0_GPIO_PER_REG; i++) {
+    uint32_t gpio = n * kIO_BANK0_GPIO_PER_REG + i;
+
+    if (gpio >= kIO_BANK0_NGPIO) {
+      break;
+    }
+    levels |= (((sIO_BANK0_SIM_PINS >> gpio) & 1u) ? kIO_BANK0_INT_LEVEL_HIGH
+                                                    : kIO_BANK0_INT_LEVEL_LOW) << (i * 4u);
+  }
+  return levels;
+}
+
+void IO_BANK0_SIM_Update(void)
+{
+  for (uint32_t n = 0u; n < kIO_BANK0_NREGS; n++) {
+    uint32_t intr = (sIO_BANK0_SIM.INTR[n] & mIO_BANK0_INT_EDGES) | io_bank0_sim_levels(n);
+
+    sIO_BANK0_SIM.INTR[n]              = intr;
+    sIO_BANK0_SIM.PROC0_INTS[n]        = (intr | sIO_BANK0_SIM.PROC0_INTF[n]) & sIO_BANK0_SIM.PROC0_INTE[n];
+    sIO_BANK0_SIM.PROC1_INTS[n]        = (intr | sIO_BANK0_SIM.PROC1_INTF[n]) & sIO_BANK0_SIM.PROC1_INTE[n];
+    sIO_BANK0_SIM.DORMANT_WAKE_INTS[n] = (intr | sIO_BANK0_SIM.DORMANT_WAKE_INTF[n])
+                                         & sIO_BANK0_SIM.DORMANT_WAKE_INTE[n];
+  }
+}
+
+void IO_BANK0_SIM_Reset(void)
+{
+  memset((void *) &sIO_BANK0_SIM, 0, sizeof(sIO_BANK0_SIM));
+  sIO_BANK0_SIM_PINS = 0u;
+  IO_BANK0_SIM_Update();
+}
+
+void IO_BANK0_SIM_SetPin(uint32_t gpio, uint32_t level)
+{
+  uint32_t bit;
+
+  if (gpio >= kIO_BANK0_NGPIO) {
+    return;
+  }
+  bit = 1u << gpio;
+  if (((sIO_BANK0_SIM_PINS & bit) != 0u) == (level != 0u)) {
+    return;
+  }
+
+  sIO_BANK0_SIM_PINS ^= bit;
+  sIO_BANK0_SIM.INTR[IO_BANK0_INT_REG(gpio)] |=
+    (level ? kIO_BANK0_INT_EDGE_HIGH : kIO_BANK0_INT_EDGE_LOW) << IO_BANK0_INT_SHIFT(gpio);
+  IO_BANK0_SIM_Update();
+}
+
+void IO_BANK0_SIM_ClearIntr(uint32_t n, uint32_t mask)
+{
+  sIO_BANK0_SIM.INTR[n] &= ~(mask & mIO_BANK0_INT_EDGES);
+  IO_BANK0_SIM_Update();
+}
+
+uint32_t IO_BANK0_SIM_IrqPending(uint32_t core)
+{
+  for (uint32_t n = 0u; n < kIO_BANK0_NREGS; n++) {
+    if ((core ? sIO_BANK0_SIM.PROC1_INTS[n] : sIO_BANK0_SIM.PROC0_INTS[n]) != 0u) {
+      return 1u;
+    }
+  }
+  return 0u;
+}
@@ -0,0 +1,37 @@
+/**
+ * \file IO_BANK0_sim.h
+ * \brief Modelo de host de las interrupciones de pin de IO_BANK0 (RP2040).
+ * \details El bloque simulado (sIO_BANK0_SIM) tiene la disposición de __IO_BANK0_t y se
+ * accede con las macros de IO_BANK0_lib.h cuando se compila con IO_BANK0_SIM. El modelo
+ * mantiene el nivel de cada pin, latchea los flancos en INTR, deriva los bits de nivel del
+ * estado del pin y recalcula PROCx_INTS = (INTR | PROCx_INTF) & PROCx_INTE tras cada cambio.
+ *
+ * \author Luis Andrés Castillo Chicaiza
+ * \version 1.0
+ * \date 2025
+ * \copyright Unlicensed
+ */
+
+#ifndef IO_BANK0_SIM_H_
+#define IO_BANK0_SIM_H_
+
+#include <stdint.h>
+
+#include "IO_BANK0_lib.h"
+
+/**
+ * \brief  Restaura el bloque simulado: todos los pines a nivel bajo, sin flancos pendientes.
+ */
+void IO_BANK0_SIM_Reset(void);
+
+/**
+ * \brief  Cambia el nivel de un pin; latchea EDGE_HIGH / EDGE_LOW si hay flanco.
+ */
+void IO_BANK0_SIM_SetPin(uint32_t gpio, uint32_t level);
+
+/**
+ * \brief  Nivel de la línea IO_IRQ_BANK0 hacia un núcleo (1 si algún INTS es distinto de 0).
+ */
+uint32_t IO_BANK0_SIM_IrqPending(uint32_t core);
+
+#endif /* IO_BANK0_SIM_H_ */
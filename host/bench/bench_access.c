@@ -0,0 +1,98 @@
+/**
+ * \file bench_access.c
+ * \brief Micro-benchmark de los estilos de acceso a registros EXTI (word, mask, bitfield).
+ * \details Mide ns/op de cada operación contra el bloque simulado y contra el espejo sin
+ * volatile. Cada llamada indirecta ejecuta kBENCH_ACCESS_BATCH operaciones desenrolladas y el
+ * coste de la llamada (lote "baseline") se descuenta, repartido entre las operaciones del
+ * lote. Se toma la mediana de kBENCH_ACCESS_REPEAT pasadas y como ruido el rango
+ * intercuartílico de la operación más el de la base: una diferencia que no lo supera se
+ * imprime como "<ruido" en lugar de un valor (nunca negativo). El número de instrucciones
+ * generadas lo obtiene el objetivo bench_access_icount con objdump.
+ *
+ * Uso: bench_access [operaciones por pasada]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "EXTI_sim.h"
+#include "bench_access.h"
+#include "bench_util.h"
+
+#define kBENCH_ACCESS_REPEAT  (9u)
+
+typedef struct {
+  double median;   /*!< ns/op */
+  double noise;    /*!< Rango intercuartílico entre pasadas [ns/op] */
+} __BENCH_RESULT_t;
+
+static int bench_cmp(const void *a, const void *b)
+{
+  double x = *(const double *) a;
+  double y = *(const double *) b;
+
+  return (x > y) - (x < y);
+}
+
+static __BENCH_RESULT_t bench_run(__BENCH_OP_fn batch, uint32_t calls)
+{
+  volatile uint32_t sink = 0u;
+  double            ns[kBENCH_ACCESS_REPEAT];
+  __BENCH_RESULT_t  res;
+
+  for (uint32_t r = 0u; r < kBENCH_ACCESS_REPEAT; r++) {
+    uint64_t t0 = BENCH_NowNs();
+
+    for (uint32_t i = 0u; i < calls; i++) {
+      sink += batch();
+    }
+    ns[r] = (double) (BENCH_NowNs() - t0) / ((double) calls * kBENCH_ACCESS_BATCH);
+  }
+  (void) sink;
+  qsort(ns, kBENCH_ACCESS_REPEAT, sizeof(ns[0]), bench_cmp);
+  res.median = ns[kBENCH_ACCESS_REPEAT / 2u];
+  res.noise  = ns[(3u * kBENCH_ACCESS_REPEAT) / 4u] - ns[kBENCH_ACCESS_REPEAT / 4u];
+  return res;
+}
+
+/* Diferencia con la base, o "<ruido" si no lo supera */
+static void bench_print(__BENCH_RESULT_t op, __BENCH_RESULT_t base)
+{
+  double d     = op.median - base.median;
+  double noise = op.noise + base.noise;
+  char   buf[16];
+
+  if (d <= noise) {
+    snprintf(buf, sizeof(buf), "<%.2f", noise);
+  } else {
+    snprintf(buf, sizeof(buf), "%.2f", d);
+  }
+  printf(" %12s", buf);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t         ops   = BENCH_Iterations(argc, argv, 16000000u);
+  uint32_t         calls = (ops + kBENCH_ACCESS_BATCH - 1u) / kBENCH_ACCESS_BATCH;
+  __BENCH_RESULT_t base_sim, base_mirror;
+
+  EXTI_SIM_Reset();
+
+  base_sim    = bench_run(BENCH_ACCESS_OPS_sim[0].batch, calls);
+  base_mirror = bench_run(BENCH_ACCESS_OPS_mirror[0].batch, calls);
+
+  printf("EXTI access styles, %u ops x %u passes (median), %u ops per call "
+         "(call overhead %.3f / %.3f ns/op removed)\n",
+         calls * kBENCH_ACCESS_BATCH, kBENCH_ACCESS_REPEAT, kBENCH_ACCESS_BATCH,
+         base_sim.median, base_mirror.median);
+  printf("%-10s %-9s %12s %12s\n", "op", "style", "sim ns/op", "mirror ns/op");
+
+  for (uint32_t k = 1u; k < kBENCH_ACCESS_NOPS; k++) {
+    printf("%-10s %-9s", BENCH_ACCESS_OPS_sim[k].name, BENCH_ACCESS_OPS_sim[k].style);
+    bench_print(bench_run(BENCH_ACCESS_OPS_sim[k].batch, calls), base_sim);
+    bench_print(bench_run(BENCH_ACCESS_OPS_mirror[k].batch, calls), base_mirror);
+    printf("\n");
+  }
+  printf("\"<x\": difference within the run-to-run noise x (interquartile ranges)\n");
+  return 0;
+}
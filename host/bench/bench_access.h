@@ -0,0 +1,29 @@
+/**
+ * \file bench_access.h
+ * \brief Tabla de operaciones del micro-benchmark de estilos de acceso a EXTI.
+ * \details Cada operación se compila dos veces a partir de bench_access_ops.inc: una
+ * contra el bloque simulado (registros volatile) y otra contra un espejo en memoria
+ * normal (sin volatile), para separar el coste del estilo de acceso del coste de volatile.
+ */
+
+#ifndef BENCH_ACCESS_H_
+#define BENCH_ACCESS_H_
+
+#include <stdint.h>
+
+typedef uint32_t (*__BENCH_OP_fn)(void);
+
+typedef struct {
+  const char   *name;   /*!< Operación EXTI medida */
+  const char   *style;  /*!< Estilo de acceso: word, mask o bitfield */
+  __BENCH_OP_fn fn;     /*!< Una operación (noinline, la que cuenta objdump_report.py) */
+  __BENCH_OP_fn batch;  /*!< kBENCH_ACCESS_BATCH operaciones desenrolladas (la cronometrada) */
+} __BENCH_OP_t;
+
+#define kBENCH_ACCESS_NOPS    (13u)
+#define kBENCH_ACCESS_BATCH   (64u)
+
+extern const __BENCH_OP_t BENCH_ACCESS_OPS_sim[kBENCH_ACCESS_NOPS];
+extern const __BENCH_OP_t BENCH_ACCESS_OPS_mirror[kBENCH_ACCESS_NOPS];
+
+#endif /* BENCH_ACCESS_H_ */
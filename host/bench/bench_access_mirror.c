@@ -0,0 +1,36 @@
+/**
+ * \file bench_access_mirror.c
+ * \brief Operaciones de bench_access_ops.inc sobre un espejo del bloque sin volatile.
+ * \details El espejo usa las mismas uniones de registro que __EXTI_t, de modo que las
+ * macros rEXTI_* / bEXTI_* se expanden igual; solo cambia el calificador volatile.
+ */
+
+#include <stdint.h>
+
+#include "EXIT_lib.h"
+#include "bench_access.h"
+
+typedef struct {
+  __EXTI_IMR1_t    IMR1;
+  __EXTI_EMR1_t    EMR1;
+  __EXTI_RTSR1_t   RTSR1;
+  __EXTI_FTSR1_t   FTSR1;
+  __EXTI_SWIER1_t  SWIER1;
+  __EXTI_PR1_t     PR1;
+  uint32_t         _RESERVED_0x18;
+  uint32_t         _RESERVED_0x1C;
+  __EXTI_IMR2_t    IMR2;
+  __EXTI_EMR2_t    EMR2;
+  __EXTI_RTSR2_t   RTSR2;
+  __EXTI_FTSR2_t   FTSR2;
+  __EXTI_SWIER2_t  SWIER2;
+  __EXTI_PR2_t     PR2;
+} __EXTI_MIRROR_t;
+
+__EXTI_MIRROR_t sEXTI_MIRROR;
+
+#undef sEXTI
+#define sEXTI (&sEXTI_MIRROR)
+
+#define BENCH_TARGET mirror
+#include "bench_access_ops.inc"
@@ -0,0 +1,10 @@
+/**
+ * \file bench_access_sim.c
+ * \brief Operaciones de bench_access_ops.inc sobre el bloque EXTI simulado (volatile).
+ */
+
+#include "EXTI_sim.h"
+#include "bench_access.h"
+
+#define BENCH_TARGET sim
+#include "bench_access_ops.inc"
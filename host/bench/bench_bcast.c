@@ -0,0 +1,138 @@
+/**
+ * \file bench_bcast.c
+ * \brief Coste por evento de la cola de difusión frente a copiar el evento en N colas SPSC.
+ * \details Un solo hilo alterna productor y consumidores en lotes de kBENCH_BCAST_BATCH
+ * eventos sobre 16 líneas, con 1, 4 y 8 suscriptores y dos filtros:
+ *  - all:   todos los suscriptores reciben todas las líneas.
+ *  - split: el suscriptor k recibe las líneas con line % N == k.
+ * "bcast" publica una vez en EXTI_bcast.h y cada suscriptor avanza su cursor; "copy" encola
+ * el evento en la EXTI_ring.h de cada suscriptor interesado. Se mide por evento publicado el
+ * tiempo del productor (el que paga la ISR) y el total (publicar + consumir), y se comprueba
+ * el número de entregas.
+ *
+ * Uso: bench_bcast [eventos]
+ */
+
+#include <stdio.h>
+
+#include "EXTI_bcast.h"
+#include "EXTI_line.h"
+#include "bench_util.h"
+
+#define kBENCH_BCAST_BATCH    (32u)
+#define kBENCH_BCAST_LINES    (16u)
+
+static __EXTI_BCAST_t    sBENCH_BCAST;
+static __EXTI_RING_t     sBENCH_RINGS[kEXTI_BCAST_SUBS];
+static uint64_t          sBENCH_FILTER[kEXTI_BCAST_SUBS];
+static volatile uint32_t sBENCH_SINK;
+
+static void bench_filters(uint32_t n, uint32_t split)
+{
+  for (uint32_t k = 0u; k < n; k++) {
+    sBENCH_FILTER[k] = 0u;
+    for (uint32_t line = 0u; line < kBENCH_BCAST_LINES; line++) {
+      if (!split || ((line % n) == k)) {
+        sBENCH_FILTER[k] |= EXTI_BCAST_LINE(line);
+      }
+    }
+  }
+}
+
+typedef struct {
+  uint64_t producer;
+  uint64_t total;
+  uint64_t delivered;
+} __BENCH_BCAST_RESULT_t;
+
+static void bench_bcast(uint32_t n, uint32_t events, __BENCH_BCAST_RESULT_t *r)
+{
+  int32_t        id[kEXTI_BCAST_SUBS];
+  __EXTI_EVENT_t ev;
+  uint64_t       t0, t1;
+
+  EXTI_BcastInit(&sBENCH_BCAST, kEXTI_BCAST_BLOCK);
+  for (uint32_t k = 0u; k < n; k++) {
+    id[k] = EXTI_BcastSubscribe(&sBENCH_BCAST, sBENCH_FILTER[k]);
+  }
+
+  r->producer  = 0u;
+  r->delivered = 0u;
+  t0 = BENCH_NowNs();
+  for (uint32_t i = 0u; i < events; i += kBENCH_BCAST_BATCH) {
+    t1 = BENCH_NowNs();
+    for (uint32_t j = 0u; j < kBENCH_BCAST_BATCH; j++) {
+      (void) EXTI_BcastPublish(&sBENCH_BCAST, i + j, (i + j) % kBENCH_BCAST_LINES, kEXTI_TRIG_EDGE_RISING);
+    }
+    r->producer += BENCH_NowNs() - t1;
+    for (uint32_t k = 0u; k < n; k++) {
+      while (EXTI_BcastPoll(&sBENCH_BCAST, id[k], &ev)) {
+        sBENCH_SINK = ev.ts;
+        r->delivered++;
+      }
+    }
+  }
+  r->total = BENCH_NowNs() - t0;
+}
+
+static void bench_copy(uint32_t n, uint32_t events, __BENCH_BCAST_RESULT_t *r)
+{
+  __EXTI_EVENT_t ev;
+  uint64_t       t0, t1;
+
+  for (uint32_t k = 0u; k < n; k++) {
+    EXTI_RingInit(&sBENCH_RINGS[k]);
+  }
+
+  r->producer  = 0u;
+  r->delivered = 0u;
+  t0 = BENCH_NowNs();
+  for (uint32_t i = 0u; i < events; i += kBENCH_BCAST_BATCH) {
+    t1 = BENCH_NowNs();
+    for (uint32_t j = 0u; j < kBENCH_BCAST_BATCH; j++) {
+      uint32_t line = (i + j) % kBENCH_BCAST_LINES;
+
+      for (uint32_t k = 0u; k < n; k++) {
+        if ((sBENCH_FILTER[k] & EXTI_BCAST_LINE(line)) != 0u) {
+          (void) EXTI_RingPush(&sBENCH_RINGS[k], i + j, line, kEXTI_TRIG_EDGE_RISING);
+        }
+      }
+    }
+    r->producer += BENCH_NowNs() - t1;
+    for (uint32_t k = 0u; k < n; k++) {
+      while (EXTI_RingPop(&sBENCH_RINGS[k], &ev)) {
+        sBENCH_SINK = ev.ts;
+        r->delivered++;
+      }
+    }
+  }
+  r->total = BENCH_NowNs() - t0;
+}
+
+int main(int argc, char **argv)
+{
+  static const uint32_t kSUBS[] = { 1u, 4u, 8u };
+  uint32_t              events  = BENCH_Iterations(argc, argv, 4000000u) & ~(kBENCH_BCAST_BATCH - 1u);
+
+  printf("broadcast ring vs N SPSC copies, %u events on %u lines, batches of %u\n",
+         events, kBENCH_BCAST_LINES, kBENCH_BCAST_BATCH);
+  printf("%-6s %5s %12s %12s %12s %12s %12s\n", "filter", "subs", "bcast prod", "copy prod",
+         "bcast total", "copy total", "deliveries");
+
+  for (uint32_t split = 0u; split < 2u; split++) {
+    for (uint32_t s = 0u; s < sizeof(kSUBS) / sizeof(kSUBS[0]); s++) {
+      uint32_t               n = kSUBS[s];
+      __BENCH_BCAST_RESULT_t rb, rc;
+
+      bench_filters(n, split);
+      bench_bcast(n, events, &rb);
+      bench_copy(n, events, &rc);
+      printf("%-6s %5u %12.2f %12.2f %12.2f %12.2f %12llu%s\n", split ? "split" : "all", n,
+             (double) rb.producer / events, (double) rc.producer / events,
+             (double) rb.total / events, (double) rc.total / events,
+             (unsigned long long) rb.delivered, (rb.delivered == rc.delivered) ? "" : " MISMATCH");
+    }
+  }
+  printf("(ns per published event)\n");
+  return 0;
+}
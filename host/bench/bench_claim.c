@@ -0,0 +1,179 @@
+/**
+ * \file bench_claim.c
+ * \brief Arranque de EXTI con la imagen de líneas reclamadas (EXTI_claim.h) frente a la
+ * inicialización por módulo con EXTI_LineConfig() / EXTI_LineEnable().
+ * \details Sobre el backend STM32L4 simulado y con la composición de bench_claims_cfg.h
+ * (seis módulos, 14 líneas, GPIO e internas, interrupción y evento):
+ *  - Camino por módulo: EXTI_LineInit() y después una función de inicialización por módulo
+ *    que configura y habilita cada una de sus líneas (y su bit de EMRx a mano, que la API de
+ *    líneas no gestiona), como haría cada driver por su cuenta.
+ *  - Camino de imagen: EXTI_ClaimInit().
+ * Comprobación: ambos caminos dejan los mismos IMRx, EMRx, RTSRx y FTSRx y los mismos slots,
+ * y EXTI_ClaimOwner() devuelve el módulo de cada línea.
+ *
+ * En el simulador los registros son RAM y el W1C de PRx es una llamada a función: el tiempo
+ * compara el trabajo de CPU, no el coste de bus de cada acceso al periférico. Los accesos a
+ * registros se cuentan aparte a partir del código de cada camino.
+ *
+ * Uso: bench_claim [iteraciones]
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "EXTI_sim.h"
+#include "EXTI_claim.h"
+#include "bench_util.h"
+
+static volatile uint32_t sBENCH_CLAIM_SINK;
+
+/* Accesos a registros del camino por módulo (EXTI_port_stm32l4.c): lecturas y escrituras */
+static uint32_t sBENCH_CLAIM_RD;
+static uint32_t sBENCH_CLAIM_WR;
+
+void bench_claim_handler(uint32_t line, uint32_t events, void *ctx)
+{
+  (void) ctx;
+  sBENCH_CLAIM_SINK = sBENCH_CLAIM_SINK + line + events;
+}
+
+static void bench_module_line(uint32_t line, uint32_t trigger, uint32_t delivery,
+                              __EXTI_HANDLER_t fn, void *ctx)
+{
+  uint32_t bit = EXTI_LINE_BIT(line);
+
+  (void) EXTI_LineConfig(line, trigger, fn, ctx);
+  sBENCH_CLAIM_RD += 1u;                         /* IMRx &= ~bit */
+  sBENCH_CLAIM_WR += 1u;
+  if (EXTI_VAR_LINE_CONFIGURABLE(line)) {
+    sBENCH_CLAIM_RD += 2u;                       /* RTSRx, FTSRx, W1C de PRx */
+    sBENCH_CLAIM_WR += 3u;
+  }
+  if ((delivery & kEXTI_CLAIM_IRQ) != 0u) {
+    EXTI_LineEnable(line);
+    sBENCH_CLAIM_RD += 1u;                       /* IMRx |= bit, NVIC_ISERn */
+    sBENCH_CLAIM_WR += 2u;
+  }
+  if ((delivery & kEXTI_CLAIM_EVENT) != 0u) {
+    if (line < 32u) {
+      rEXTI_EMR1 |= bit;
+    } else {
+      rEXTI_EMR2 |= bit;
+    }
+    sBENCH_CLAIM_RD += 1u;
+    sBENCH_CLAIM_WR += 1u;
+  }
+}
+
+#define BENCH_CLAIM_LINE_(o, line, trig, dlv, fn, ctx)   \
+  bench_module_line((line), (trig), (dlv), (fn), (ctx));
+
+/* Una función de inicialización por módulo, como en el firmware sin composición */
+static void buttons_init(void) { BUTTONS_EXTI_CLAIMS(BENCH_CLAIM_LINE_) }
+static void imu_init(void)     { IMU_EXTI_CLAIMS(BENCH_CLAIM_LINE_) }
+static void radio_init(void)   { RADIO_EXTI_CLAIMS(BENCH_CLAIM_LINE_) }
+static void meter_init(void)   { METER_EXTI_CLAIMS(BENCH_CLAIM_LINE_) }
+static void power_init(void)   { POWER_EXTI_CLAIMS(BENCH_CLAIM_LINE_) }
+static void clock_init(void)   { CLOCK_EXTI_CLAIMS(BENCH_CLAIM_LINE_) }
+
+static void bench_boot_modules(void)
+{
+  EXTI_LineInit();
+  sBENCH_CLAIM_WR += 10u;                        /* EXTI_PORT_Init(): imagen vacía */
+  buttons_init();
+  imu_init();
+  radio_init();
+  meter_init();
+  power_init();
+  clock_init();
+}
+
+typedef struct {
+  uint32_t      reg[8];
+  __EXTI_SLOT_t slot[kEXTI_LINE_COUNT];
+} __BENCH_CLAIM_STATE_t;
+
+static void bench_capture(__BENCH_CLAIM_STATE_t *st)
+{
+  memset(st, 0, sizeof(*st));
+  st->reg[0] = rEXTI_IMR1;
+  st->reg[1] = rEXTI_EMR1;
+  st->reg[2] = rEXTI_RTSR1;
+  st->reg[3] = rEXTI_FTSR1;
+  st->reg[4] = rEXTI_IMR2;
+  st->reg[5] = rEXTI_EMR2;
+  st->reg[6] = rEXTI_RTSR2;
+  st->reg[7] = rEXTI_FTSR2;
+  for (uint32_t line = 0u; line < kEXTI_LINE_COUNT; line++) {
+    st->slot[line].fn      = sEXTI_SLOTS[line].fn;
+    st->slot[line].ctx     = sEXTI_SLOTS[line].ctx;
+    st->slot[line].trigger = sEXTI_SLOTS[line].trigger;
+  }
+}
+
+#define BENCH_CLAIM_OWNER_(o, line, trig, dlv, fn, ctx)   \
+  errors += (EXTI_ClaimOwner(line) == NULL) || (strcmp(EXTI_ClaimOwner(line), #o) != 0);
+
+int main(int argc, char **argv)
+{
+  uint32_t              n      = BENCH_Iterations(argc, argv, 200000u);
+  uint32_t              errors = 0u;
+  uint32_t              iser   = 0u;
+  __BENCH_CLAIM_STATE_t a, b;
+  uint64_t              t0, t_modules, t_image;
+
+  /* Comprobación: mismo estado final por ambos caminos */
+  EXTI_SIM_Reset();
+  bench_boot_modules();
+  bench_capture(&a);
+  EXTI_SIM_Reset();
+  EXTI_ClaimInit();
+  bench_capture(&b);
+  for (uint32_t i = 0u; i < 8u; i++) {
+    errors += (a.reg[i] != b.reg[i]);
+  }
+  for (uint32_t line = 0u; line < kEXTI_LINE_COUNT; line++) {
+    errors += (a.slot[line].fn != b.slot[line].fn) || (a.slot[line].ctx != b.slot[line].ctx) ||
+              (a.slot[line].trigger != b.slot[line].trigger);
+  }
+  EXTI_CLAIMS(BENCH_CLAIM_OWNER_)
+  errors += (EXTI_ClaimOwner(2u) != NULL);
+  errors += (sEXTI_SIM_NVIC.ISER[0] != kEXTI_CLAIM_ISER0) ||
+            (sEXTI_SIM_NVIC.ISER[1] != kEXTI_CLAIM_ISER1) ||
+            (sEXTI_SIM_NVIC.ISER[2] != kEXTI_CLAIM_ISER2);
+  printf("check: module init and claim image agree, %u mismatches\n", errors);
+  printf("image: IMR1 %08X EMR1 %08X RTSR1 %08X FTSR1 %08X\n", b.reg[0], b.reg[1], b.reg[2],
+         b.reg[3]);
+  printf("       IMR2 %08X EMR2 %08X RTSR2 %08X FTSR2 %08X\n", b.reg[4], b.reg[5], b.reg[6],
+         b.reg[7]);
+
+  /* Accesos a registros de cada camino */
+  sBENCH_CLAIM_RD = 0u;
+  sBENCH_CLAIM_WR = 0u;
+  EXTI_SIM_Reset();
+  bench_boot_modules();
+  iser = (kEXTI_CLAIM_ISER0 != 0u) + (kEXTI_CLAIM_ISER1 != 0u) + (kEXTI_CLAIM_ISER2 != 0u);
+  printf("\n%u lines claimed by 6 modules\n", kEXTI_CLAIM_COUNT);
+  printf("%-22s %8s %8s\n", "register accesses", "reads", "writes");
+  printf("%-22s %8u %8u\n", "per-module init", sBENCH_CLAIM_RD, sBENCH_CLAIM_WR);
+  /* EXTI_STM32L4_InitImage(): 10 escrituras; después una por palabra de NVIC_ISER usada */
+  printf("%-22s %8u %8u\n", "claim image", 0u, 10u + iser);
+
+  EXTI_SIM_Reset();
+  t0 = BENCH_NowNs();
+  for (uint32_t i = 0u; i < n; i++) {
+    bench_boot_modules();
+  }
+  t_modules = BENCH_NowNs() - t0;
+
+  t0 = BENCH_NowNs();
+  for (uint32_t i = 0u; i < n; i++) {
+    EXTI_ClaimInit();
+  }
+  t_image = BENCH_NowNs() - t0;
+
+  printf("\n%-22s %10s\n", "boot path", "ns/boot");
+  printf("%-22s %10.1f\n", "per-module init", (double) t_modules / n);
+  printf("%-22s %10.1f\n", "claim image", (double) t_image / n);
+  return (errors == 0u) ? 0 : 1;
+}
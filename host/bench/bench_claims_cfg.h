@@ -0,0 +1,46 @@
+/**
+ * \file bench_claims_cfg.h
+ * \brief Composición de líneas EXTI de bench_claim: seis módulos de un firmware típico.
+ */
+
+#ifndef BENCH_CLAIMS_CFG_H_
+#define BENCH_CLAIMS_CFG_H_
+
+void bench_claim_handler(uint32_t line, uint32_t events, void *ctx);
+
+#define BUTTONS_EXTI_CLAIMS(X)                                                              \
+  X(buttons, 0,  kEXTI_TRIG_EDGE_FALLING, kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)     \
+  X(buttons, 1,  kEXTI_TRIG_EDGE_FALLING, kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)     \
+  X(buttons, 13, kEXTI_TRIG_EDGE_BOTH,    kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)
+
+#define IMU_EXTI_CLAIMS(X)                                                                  \
+  X(imu,     5,  kEXTI_TRIG_EDGE_RISING,  kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)     \
+  X(imu,     6,  kEXTI_TRIG_EDGE_RISING,  kEXTI_CLAIM_EVENT, NULL,                NULL)
+
+#define RADIO_EXTI_CLAIMS(X)                                                                \
+  X(radio,   8,  kEXTI_TRIG_EDGE_RISING,  kEXTI_CLAIM_IRQ | kEXTI_CLAIM_EVENT,              \
+    bench_claim_handler, NULL)                                                              \
+  X(radio,   9,  kEXTI_TRIG_EDGE_FALLING, kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)
+
+#define METER_EXTI_CLAIMS(X)                                                                \
+  X(meter,   10, kEXTI_TRIG_EDGE_BOTH,    kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)     \
+  X(meter,   11, kEXTI_TRIG_EDGE_RISING,  kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)
+
+#define POWER_EXTI_CLAIMS(X)                                                                \
+  X(power,   16, kEXTI_TRIG_EDGE_BOTH,    kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)     \
+  X(power,   35, kEXTI_TRIG_EDGE_FALLING, kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)
+
+#define CLOCK_EXTI_CLAIMS(X)                                                                \
+  X(clock,   20, kEXTI_TRIG_EDGE_RISING,  kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)     \
+  X(clock,   31, 0u,                      kEXTI_CLAIM_EVENT, NULL,                NULL)     \
+  X(clock,   32, 0u,                      kEXTI_CLAIM_IRQ,   bench_claim_handler, NULL)
+
+#define EXTI_CLAIMS(X)                \
+  BUTTONS_EXTI_CLAIMS(X)              \
+  IMU_EXTI_CLAIMS(X)                  \
+  RADIO_EXTI_CLAIMS(X)                \
+  METER_EXTI_CLAIMS(X)                \
+  POWER_EXTI_CLAIMS(X)                \
+  CLOCK_EXTI_CLAIMS(X)
+
+#endif /* BENCH_CLAIMS_CFG_H_ */
@@ -0,0 +1,215 @@
+/**
+ * \file bench_coalesce.c
+ * \brief Presión sobre la cola de eventos con entradas ruidosas, con y sin agrupación.
+ * \details Simulación en tiempo virtual (1 tick = 1 us) sobre el backend STM32L4 simulado.
+ * Cuatro líneas, ambos flancos:
+ *  - 0 contacto de puerta:  cada ~2 s, ráfaga de rebotes de 30 flancos en 5 ms.
+ *  - 1 sensor de presencia: cada ~5 s, 1 s de parpadeo a 200 flancos/s.
+ *  - 2 entrada con ruido:   flancos de Poisson a 2000/s.
+ *  - 3 pulsador limpio:     cada ~3 s, pulsación de 100 ms (2 flancos).
+ * El consumidor vacía la cola EXTI_ring.h (kEXTI_RING_SIZE eventos) cada
+ * kBENCH_COAL_DRAIN_US. Sin agrupación la ISR encola cada flanco; con agrupación
+ * (EXTI_coalesce.h, ventana kBENCH_COAL_WINDOW_US) se encola un evento por ráfaga. Como en
+ * el bucle sin tick, la rutina de servicio corre antes de avanzar la rueda hasta el flanco.
+ *
+ * Uso: bench_coalesce [segundos simulados]
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "EXTI_coalesce.h"
+#include "EXTI_ring.h"
+#include "EXTI_sim.h"
+#include "bench_util.h"
+
+#define kBENCH_COAL_LINES       (4u)
+#define kBENCH_COAL_WINDOW_US   (10000u)
+#define kBENCH_COAL_DRAIN_US    (50000u)
+#define kBENCH_COAL_NEVER       (UINT32_MAX)
+
+typedef struct {
+  const char *name;
+  double      burst_hz;   /*!< Ráfagas por segundo (0: flujo continuo) */
+  uint32_t    edges;      /*!< Flancos por ráfaga */
+  double      edge_hz;    /*!< Tasa de flancos dentro de la ráfaga */
+} __BENCH_COAL_SRC_t;
+
+static const __BENCH_COAL_SRC_t kBENCH_COAL_SRC[kBENCH_COAL_LINES] = {
+  { "door",     0.5,   30u,  6000.0 },
+  { "presence", 0.2,  200u,   200.0 },
+  { "noise",    0.0,    0u,  2000.0 },
+  { "button",   1.0 / 3.0, 2u, 10.0 },
+};
+
+static struct {
+  uint32_t      now;
+  uint32_t      rng;
+  uint32_t      next_edge[kBENCH_COAL_LINES];
+  uint32_t      left[kBENCH_COAL_LINES];       /*!< Flancos que quedan de la ráfaga */
+  uint32_t      level[kBENCH_COAL_LINES];
+  uint32_t      edges[kBENCH_COAL_LINES];
+  uint32_t      pushed[kBENCH_COAL_LINES];
+  uint32_t      counted[kBENCH_COAL_LINES];    /*!< Suma de count de los eventos agrupados */
+  uint32_t      isr;
+  uint32_t      high_water;
+  __EXTI_RING_t ring;
+} sBENCH;
+
+uint32_t EXTI_TIME_Now(void)
+{
+  return sBENCH.now;
+}
+
+static double bench_uniform(void)
+{
+  uint32_t x = sBENCH.rng;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sBENCH.rng = x;
+  return ((double) x + 1.0) / 4294967297.0;
+}
+
+static uint32_t bench_exp_us(double hz)
+{
+  return 1u + (uint32_t) (-log(bench_uniform()) * 1e6 / hz);
+}
+
+static void bench_schedule(uint32_t line)
+{
+  const __BENCH_COAL_SRC_t *src = &kBENCH_COAL_SRC[line];
+
+  if (src->burst_hz == 0.0) {
+    sBENCH.next_edge[line] += bench_exp_us(src->edge_hz);
+  } else if (sBENCH.left[line] != 0u) {
+    sBENCH.next_edge[line] += bench_exp_us(src->edge_hz);
+    sBENCH.left[line]--;
+  } else {
+    sBENCH.next_edge[line] += bench_exp_us(src->burst_hz);
+    sBENCH.left[line]       = src->edges - 1u;
+  }
+}
+
+static void bench_push(uint32_t ts, uint32_t line, uint32_t events)
+{
+  if (EXTI_RingPush(&sBENCH.ring, ts, line, events)) {
+    uint32_t n = EXTI_RingCount(&sBENCH.ring);
+
+    sBENCH.pushed[line]++;
+    sBENCH.high_water = (n > sBENCH.high_water) ? n : sBENCH.high_water;
+  }
+}
+
+static void bench_raw(uint32_t line, uint32_t events, void *ctx)
+{
+  (void) ctx;
+  bench_push(sBENCH.now, line, events);
+}
+
+static void bench_coalesced(const __EXTI_COAL_EVENT_t *ev, void *ctx)
+{
+  (void) ctx;
+  sBENCH.counted[ev->line] += ev->count;
+  bench_push(ev->first, ev->line, ev->events);
+}
+
+static void bench_run(uint32_t coalesce, uint32_t seconds)
+{
+  static __EXTI_COAL_t coal[kBENCH_COAL_LINES];
+  __EXTI_EVENT_t       ev;
+  uint32_t             end   = seconds * 1000000u;
+  uint32_t             drain = kBENCH_COAL_DRAIN_US;
+  uint32_t             total[3] = { 0u, 0u, 0u };
+
+  sBENCH.now        = 0u;
+  sBENCH.rng        = 0xC0A1E5CEu;
+  sBENCH.isr        = 0u;
+  sBENCH.high_water = 0u;
+  EXTI_RingInit(&sBENCH.ring);
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  EXTI_WheelInit(&sEXTI_WHEEL, 0u);
+  EXTI_WheelClock(&sEXTI_WHEEL, EXTI_TIME_Now);
+
+  for (uint32_t line = 0u; line < kBENCH_COAL_LINES; line++) {
+    sBENCH.next_edge[line] = 0u;
+    sBENCH.left[line]      = 0u;
+    sBENCH.level[line]     = 0u;
+    sBENCH.edges[line]     = 0u;
+    sBENCH.pushed[line]    = 0u;
+    sBENCH.counted[line]   = 0u;
+    bench_schedule(line);
+    if (coalesce) {
+      EXTI_CoalesceAttach(&coal[line], line, kEXTI_TRIG_EDGE_BOTH, kBENCH_COAL_WINDOW_US,
+                          bench_coalesced, NULL);
+    } else {
+      EXTI_LineConfig(line, kEXTI_TRIG_EDGE_BOTH, bench_raw, NULL);
+      EXTI_LineEnable(line);
+    }
+  }
+
+  while (sBENCH.now < end) {
+    uint32_t next = drain;
+    uint32_t timer;
+    uint32_t src = kBENCH_COAL_LINES;
+
+    for (uint32_t line = 0u; line < kBENCH_COAL_LINES; line++) {
+      if (sBENCH.next_edge[line] < next) {
+        next = sBENCH.next_edge[line];
+        src  = line;
+      }
+    }
+    if (EXTI_WheelNextExpiry(&sEXTI_WHEEL, &timer) && (timer < next)) {
+      next = timer;
+      src  = kBENCH_COAL_LINES;
+    }
+    sBENCH.now = next;
+
+    if (src < kBENCH_COAL_LINES) {
+      sBENCH.level[src] ^= 1u;
+      sBENCH.edges[src]++;
+      if (EXTI_SIM_Edge(src, sBENCH.level[src])) {
+        sBENCH.isr++;
+        EXTI_STM32L4_Service(1u << src);
+      }
+      bench_schedule(src);
+    }
+    (void) EXTI_WheelAdvance(&sEXTI_WHEEL, sBENCH.now);
+    if (sBENCH.now >= drain) {
+      while (EXTI_RingPop(&sBENCH.ring, &ev)) {
+      }
+      drain += kBENCH_COAL_DRAIN_US;
+    }
+  }
+
+  printf("\n%s: %u ISR entries, ring high water %u / %u, dropped %u\n",
+         coalesce ? "coalesce 10 ms" : "raw", sBENCH.isr, sBENCH.high_water, kEXTI_RING_SIZE,
+         sBENCH.ring.dropped);
+  printf("%-10s %10s %10s %12s\n", "line", "edges", "events", "edges seen");
+  for (uint32_t line = 0u; line < kBENCH_COAL_LINES; line++) {
+    printf("%-10s %10u %10u %12u\n", kBENCH_COAL_SRC[line].name, sBENCH.edges[line],
+           sBENCH.pushed[line], coalesce ? sBENCH.counted[line] : sBENCH.pushed[line]);
+    total[0] += sBENCH.edges[line];
+    total[1] += sBENCH.pushed[line];
+    total[2] += coalesce ? sBENCH.counted[line] : sBENCH.pushed[line];
+  }
+  printf("%-10s %10u %10u %12u\n", "total", total[0], total[1], total[2]);
+
+  if (coalesce) {
+    for (uint32_t line = 0u; line < kBENCH_COAL_LINES; line++) {
+      EXTI_CoalesceDetach(&coal[line]);
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seconds = BENCH_Iterations(argc, argv, 60u);
+
+  printf("noisy inputs, %u s simulated, ring drained every %u us\n", seconds, kBENCH_COAL_DRAIN_US);
+  bench_run(0u, seconds);
+  bench_run(1u, seconds);
+  return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * \file bench_coro.cpp
+ * \brief Latencia de reanudación de corrutinas (EXTI_co.h) frente a la ruta de callback.
+ * \details Sobre el backend STM32L4 simulado, en cada pasada se inyecta un flanco y se
+ * ejecuta la rutina de servicio. En la ruta de callback el manejador de EXTI_line es el
+ * código de usuario. En la ruta de corrutina el manejador anota el evento y
+ * exti::scheduler::run() reanuda la corrutina que esperaba con co_await exti::edge().
+ * Se mide el coste total por evento y la latencia desde la entrada a la rutina de servicio
+ * hasta la primera instrucción del código de usuario.
+ *
+ * Uso: bench_coro [pasadas]
+ */
+
+#include <cstdio>
+
+#include "EXTI_co.h"
+#include "EXTI_sim.h"
+#include "bench_util.h"
+
+#define kBENCH_CB_LINE        (3u)
+#define kBENCH_CO_LINE        (4u)
+#define kBENCH_TIMEOUT_LINE   (5u)
+
+extern "C" uint32_t EXTI_TIME_Now(void)
+{
+  return static_cast<uint32_t>(BENCH_NowNs());
+}
+
+static uint64_t          sBENCH_T0;
+static uint64_t          sBENCH_LATENCY;
+static uint32_t          sBENCH_EVENTS;
+static uint32_t          sBENCH_TIMEOUTS;
+
+static void bench_callback(uint32_t line, uint32_t events, void *ctx)
+{
+  (void) line;
+  (void) ctx;
+  sBENCH_LATENCY += BENCH_NowNs() - sBENCH_T0;
+  sBENCH_EVENTS  += events;
+}
+
+static exti::task bench_edge_task()
+{
+  for (;;) {
+    exti::edge_result r = co_await exti::edge(kBENCH_CO_LINE, exti::Edge::Rising);
+
+    sBENCH_LATENCY += BENCH_NowNs() - sBENCH_T0;
+    sBENCH_EVENTS  += r.events;
+  }
+}
+
+static exti::task bench_timeout_task()
+{
+  for (;;) {
+    exti::edge_result r = co_await exti::edge(kBENCH_TIMEOUT_LINE, exti::Edge::Rising, 1000u);
+
+    sBENCH_TIMEOUTS += r.timed_out();
+  }
+}
+
+template <typename F>
+static void bench_run(const char *name, uint32_t passes, uint32_t line, F service)
+{
+  uint64_t t_total;
+
+  sBENCH_LATENCY = 0u;
+  sBENCH_EVENTS  = 0u;
+  t_total = BENCH_NowNs();
+  for (uint32_t p = 0u; p < passes; p++) {
+    (void) EXTI_SIM_Edge(line, 1u);
+    sBENCH_T0 = BENCH_NowNs();
+    service();
+  }
+  t_total = BENCH_NowNs() - t_total;
+
+  std::printf("%-12s %14.2f %14.2f %10u\n", name,
+              static_cast<double>(t_total) / passes,
+              static_cast<double>(sBENCH_LATENCY) / passes,
+              sBENCH_EVENTS / kEXTI_TRIG_EDGE_RISING);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t passes = BENCH_Iterations(argc, argv, 1000000u);
+
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  EXTI_LineConfig(kBENCH_CB_LINE, kEXTI_TRIG_EDGE_RISING, bench_callback, nullptr);
+  EXTI_LineEnable(kBENCH_CB_LINE);
+  exti::scheduler::attach(kBENCH_CO_LINE, kEXTI_TRIG_EDGE_RISING);
+  exti::scheduler::attach(kBENCH_TIMEOUT_LINE, kEXTI_TRIG_EDGE_RISING);
+
+  if (!bench_edge_task().valid() || !bench_timeout_task().valid()) {
+    std::fprintf(stderr, "bench_coro: pool de marcos insuficiente (%u x %u bytes)\n",
+                 kEXTI_CO_FRAMES, kEXTI_CO_FRAME_SIZE);
+    return 1;
+  }
+
+  std::printf("EXTI edge delivery, %u passes, %u/%u frames of %u bytes, %u waiters\n", passes,
+              exti::scheduler::frames(), kEXTI_CO_FRAMES, kEXTI_CO_FRAME_SIZE, kEXTI_CO_WAITERS);
+  std::printf("%-12s %14s %14s %10s\n", "path", "ns/event", "latency ns", "events");
+
+  bench_run("callback", passes, kBENCH_CB_LINE, [] {
+    EXTI_STM32L4_Service(1u << kBENCH_CB_LINE);
+  });
+  bench_run("coroutine", passes, kBENCH_CO_LINE, [] {
+    EXTI_STM32L4_Service(1u << kBENCH_CO_LINE);
+    (void) exti::scheduler::run();
+  });
+
+  std::printf("timeouts on idle line %u: %u\n", kBENCH_TIMEOUT_LINE, sBENCH_TIMEOUTS);
+  return 0;
+}
@@ -0,0 +1,242 @@
+/**
+ * \file bench_defer.c
+ * \brief Jitter de una ISR de tiempo real bajo ráfagas EXTI, con y sin despacho diferido.
+ * \details Simulación en tiempo virtual (ns) con un modelo de NVIC con expulsión sobre el
+ * bloque EXTI simulado y la rutina de servicio real. Tres niveles de prioridad:
+ *
+ *  1. EXTI15_10: ráfagas de flancos en las líneas 10-15 (una cada ~1 ms, fase aleatoria).
+ *  2. ISR de tiempo real periódica (kBENCH_DEFER_RT_PERIOD_NS), que mide su latencia de
+ *     arranque respecto a su instante de disparo.
+ *  3. Vector diferido (kEXTI_DEFER_LINE lanzado por SWIER1), solo con EXTI_DEFER.
+ *
+ * Los manejadores consumen su coste en tiempo virtual y pueden ser expulsados por un nivel
+ * más prioritario; cada activación cuesta kBENCH_DEFER_ENTRY_NS. Se compila dos veces:
+ * bench_defer_stm32 (todo en la ISR) y bench_defer_stm32_defer (EXTI_DEFER con el
+ * presupuesto kEXTI_DEFER_BUDGET en ns).
+ *
+ * Uso: bench_defer_<modo> [milisegundos simulados]
+ */
+
+#include <stdio.h>
+
+#include "EXTI_line.h"
+#include "EXTI_sim.h"
+#include "EXTI_time.h"
+#include "bench_util.h"
+
+#define kBENCH_DEFER_ENTRY_NS       (200u)
+#define kBENCH_DEFER_RT_PERIOD_NS   (50000u)    /* 20 kHz */
+#define kBENCH_DEFER_RT_COST_NS     (1000u)
+#define kBENCH_DEFER_BURST_NS       (1000000u)  /* Periodo medio entre ráfagas */
+#define kBENCH_DEFER_HANDLER_NS     (2000u)
+#define kBENCH_DEFER_FIRST          (10u)
+#define kBENCH_DEFER_NLINES         (6u)
+#define mBENCH_DEFER_V15_10         (0x0000FC00u)
+
+typedef enum {
+  kBENCH_LVL_GPIO = 1,
+  kBENCH_LVL_RT,
+  kBENCH_LVL_DEFER,
+  kBENCH_LVL_THREAD
+} __BENCH_LEVEL_t;
+
+static struct {
+  uint64_t        now;
+  uint32_t        rng;
+  __BENCH_LEVEL_t level;
+  uint64_t        rt_release;
+  uint64_t        burst_at;
+  uint32_t        burst_next;     /*!< Siguiente línea de la ráfaga en curso */
+  uint64_t        burst_start;
+  uint32_t        burst_left;     /*!< Manejadores pendientes de la ráfaga */
+  uint64_t        rt_min, rt_max, rt_sum;
+  uint32_t        rt_runs;
+  uint64_t        burst_max, burst_sum;
+  uint32_t        bursts;
+  uint32_t        merged;
+  uint32_t        deferred;
+} sBENCH;
+
+uint32_t EXTI_TIME_Now(void)
+{
+  return (uint32_t) sBENCH.now;
+}
+
+static uint32_t bench_rand(void)
+{
+  uint32_t x = sBENCH.rng;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sBENCH.rng = x;
+  return x;
+}
+
+/* Flancos de la ráfaga: uno cada 100 ns a partir de burst_at */
+static uint64_t bench_next_edge(void)
+{
+  return sBENCH.burst_at + 100u * sBENCH.burst_next;
+}
+
+static void bench_inject(void)
+{
+  while (bench_next_edge() <= sBENCH.now) {
+    uint32_t line = kBENCH_DEFER_FIRST + sBENCH.burst_next;
+
+    if (sBENCH.burst_next == 0u) {
+      sBENCH.burst_start = sBENCH.burst_at;
+      sBENCH.burst_left  = kBENCH_DEFER_NLINES;
+    }
+    if ((rEXTI_PR1 & (1u << line)) != 0u) {
+      sBENCH.merged++;
+    }
+    (void) EXTI_SIM_Edge(line, 1u);
+    if (++sBENCH.burst_next == kBENCH_DEFER_NLINES) {
+      sBENCH.burst_next = 0u;
+      sBENCH.burst_at  += kBENCH_DEFER_BURST_NS / 2u + bench_rand() % kBENCH_DEFER_BURST_NS;
+    }
+  }
+}
+
+static void bench_work(uint64_t cost);
+
+static void bench_activate(__BENCH_LEVEL_t level, void (*fn)(void))
+{
+  __BENCH_LEVEL_t saved = sBENCH.level;
+
+  sBENCH.level = level;
+  bench_work(kBENCH_DEFER_ENTRY_NS);
+  fn();
+  sBENCH.level = saved;
+}
+
+static void bench_gpio_isr(void)
+{
+  EXTI_STM32L4_Service(mBENCH_DEFER_V15_10);
+}
+
+static void bench_rt_isr(void)
+{
+  uint64_t lat = sBENCH.now - sBENCH.rt_release;
+
+  sBENCH.rt_min  = (lat < sBENCH.rt_min) ? lat : sBENCH.rt_min;
+  sBENCH.rt_max  = (lat > sBENCH.rt_max) ? lat : sBENCH.rt_max;
+  sBENCH.rt_sum += lat;
+  sBENCH.rt_runs++;
+  sBENCH.rt_release += kBENCH_DEFER_RT_PERIOD_NS;
+  bench_work(kBENCH_DEFER_RT_COST_NS);
+}
+
+#ifdef EXTI_DEFER
+static void bench_defer_isr(void)
+{
+  sBENCH.deferred += (uint32_t) __builtin_popcount(EXTI_STM32L4_Deferred());
+  EXTI_STM32L4_DeferService();
+}
+#endif
+
+/* Atiende, en orden de prioridad, las activaciones capaces de expulsar al nivel actual */
+static void bench_preempt(void)
+{
+  for (;;) {
+    bench_inject();
+    if ((sBENCH.level > kBENCH_LVL_GPIO) && ((rEXTI_PR1 & rEXTI_IMR1 & mBENCH_DEFER_V15_10) != 0u)) {
+      bench_activate(kBENCH_LVL_GPIO, bench_gpio_isr);
+    } else if ((sBENCH.level > kBENCH_LVL_RT) && (sBENCH.rt_release <= sBENCH.now)) {
+      bench_activate(kBENCH_LVL_RT, bench_rt_isr);
+#ifdef EXTI_DEFER
+    } else if ((sBENCH.level > kBENCH_LVL_DEFER)
+               && ((rEXTI_PR1 & rEXTI_IMR1 & EXTI_LINE_BIT(kEXTI_DEFER_LINE)) != 0u)) {
+      bench_activate(kBENCH_LVL_DEFER, bench_defer_isr);
+#endif
+    } else {
+      break;
+    }
+  }
+}
+
+/* Próximo instante en que un nivel más prioritario que el actual puede expulsarlo */
+static uint64_t bench_next_event(void)
+{
+  uint64_t next = UINT64_MAX;
+
+  if (sBENCH.level > kBENCH_LVL_GPIO) {
+    next = bench_next_edge();
+  }
+  if ((sBENCH.level > kBENCH_LVL_RT) && (sBENCH.rt_release < next)) {
+    next = sBENCH.rt_release;
+  }
+  return next;
+}
+
+/* Consume cost ns en el nivel actual, cediendo a los niveles más prioritarios */
+static void bench_work(uint64_t cost)
+{
+  while (cost != 0u) {
+    uint64_t next;
+    uint64_t step;
+
+    bench_preempt();
+    next = bench_next_event();
+    step = (next - sBENCH.now < cost) ? next - sBENCH.now : cost;
+    sBENCH.now += step;
+    cost       -= step;
+  }
+  bench_inject();
+}
+
+static void bench_handler(uint32_t line, uint32_t events, void *ctx)
+{
+  (void) line;
+  (void) events;
+  (void) ctx;
+  bench_work(kBENCH_DEFER_HANDLER_NS);
+  if ((sBENCH.burst_left != 0u) && (--sBENCH.burst_left == 0u)) {
+    uint64_t t = sBENCH.now - sBENCH.burst_start;
+
+    sBENCH.burst_max  = (t > sBENCH.burst_max) ? t : sBENCH.burst_max;
+    sBENCH.burst_sum += t;
+    sBENCH.bursts++;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t ms  = BENCH_Iterations(argc, argv, 1000u);
+  uint64_t end = (uint64_t) ms * 1000000u;
+
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  for (uint32_t i = 0u; i < kBENCH_DEFER_NLINES; i++) {
+    EXTI_LineConfig(kBENCH_DEFER_FIRST + i, kEXTI_TRIG_EDGE_RISING, bench_handler, NULL);
+    EXTI_LineEnable(kBENCH_DEFER_FIRST + i);
+  }
+
+  sBENCH.rng        = 0x0BADC0DEu;
+  sBENCH.level      = kBENCH_LVL_THREAD;
+  sBENCH.rt_release = kBENCH_DEFER_RT_PERIOD_NS;
+  sBENCH.burst_at   = bench_rand() % kBENCH_DEFER_BURST_NS;
+  sBENCH.rt_min     = UINT64_MAX;
+
+  while (sBENCH.now < end) {
+    bench_preempt();
+    sBENCH.now = bench_next_event();
+  }
+
+#ifdef EXTI_DEFER
+  printf("EXTI_DEFER, budget %u ns, %u ms simulated\n", kEXTI_DEFER_BUDGET, ms);
+#else
+  printf("dispatch in ISR, %u ms simulated\n", ms);
+#endif
+  printf("bursts of %u lines x %u ns, RT ISR every %u ns (%u ns)\n",
+         kBENCH_DEFER_NLINES, kBENCH_DEFER_HANDLER_NS, kBENCH_DEFER_RT_PERIOD_NS, kBENCH_DEFER_RT_COST_NS);
+  printf("%-28s %10.2f / %.2f / %.2f us (min / mean / max)\n", "RT ISR start latency",
+         sBENCH.rt_min / 1000.0, (double) sBENCH.rt_sum / sBENCH.rt_runs / 1000.0, sBENCH.rt_max / 1000.0);
+  printf("%-28s %10.2f us\n", "RT ISR jitter", (sBENCH.rt_max - sBENCH.rt_min) / 1000.0);
+  printf("%-28s %10.2f / %.2f us (mean / max)\n", "burst completion",
+         (double) sBENCH.burst_sum / sBENCH.bursts / 1000.0, sBENCH.burst_max / 1000.0);
+  printf("%-28s %10u / %u\n", "bursts / merged edges", sBENCH.bursts, sBENCH.merged);
+  printf("%-28s %10u\n", "lines deferred", sBENCH.deferred);
+  return 0;
+}
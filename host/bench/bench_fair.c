@@ -0,0 +1,213 @@
+/**
+ * \file bench_fair.c
+ * \brief Peor latencia por línea con el vector EXTI15_10 saturado, con y sin turno rotativo.
+ * \details Simulación en tiempo virtual (ns) sobre el bloque EXTI simulado y la rutina de
+ * servicio real (EXTI_STM32L4_Service). Las líneas 10-13 reciben una tormenta de flancos de
+ * Poisson, 14-15 (el enclavamiento) y la línea 5 del vector vecino EXTI9_5, de igual
+ * prioridad, una tasa baja. Cada manejador consume su coste en tiempo virtual y cada
+ * activación del vector kBENCH_FAIR_ENTRY_NS; el NVIC elige entre vectores pendientes por
+ * número de IRQ, como en un tail-chaining de igual prioridad. Un flanco sobre un PR ya activo
+ * se fusiona (flanco perdido). La latencia va del flanco más antiguo no atendido de la línea
+ * al inicio de su manejador.
+ *
+ * Se compila contra cada modo de despacho:
+ *  - bench_fair_stm32:       "rescan" (referencia: bucle que relee PR1 y atiende la línea más
+ *                            baja, el patrón clásico) y "bitscan" (EXTI_DISPATCH_BITSCAN).
+ *  - bench_fair_stm32_fair:  "fair" (EXTI_DISPATCH_FAIR, kEXTI_DISPATCH_BUDGET líneas).
+ *
+ * Uso: bench_fair_<modo> [milisegundos simulados]
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "EXTI_line.h"
+#include "EXTI_sim.h"
+#include "bench_util.h"
+
+#define kBENCH_FAIR_ENTRY_NS    (200u)          /* Entrada + salida + prólogo del servicio */
+#define kBENCH_FAIR_NONE        (UINT64_MAX)
+#define mBENCH_FAIR_V9_5        (0x000003E0u)
+#define mBENCH_FAIR_V15_10      (0x0000FC00u)
+
+typedef struct {
+  uint32_t line;
+  double   rate_hz;
+  uint32_t cost_ns;
+} __BENCH_FAIR_LINE_t;
+
+static const __BENCH_FAIR_LINE_t kBENCH_FAIR_LINES[] = {
+  {  5u,   1000.0, 2000u },
+  { 10u, 120000.0, 2000u },
+  { 11u, 120000.0, 2000u },
+  { 12u, 120000.0, 2000u },
+  { 13u, 120000.0, 2000u },
+  { 14u,   1000.0, 2000u },
+  { 15u,   1000.0, 2000u },
+};
+
+#define kBENCH_FAIR_NLINES      (sizeof(kBENCH_FAIR_LINES) / sizeof(kBENCH_FAIR_LINES[0]))
+
+static struct {
+  uint64_t now;
+  uint32_t rng;
+  uint64_t next_edge[kBENCH_FAIR_NLINES];
+  uint64_t since[kBENCH_FAIR_NLINES];
+  uint64_t lat_max[kBENCH_FAIR_NLINES];
+  uint64_t lat_sum[kBENCH_FAIR_NLINES];
+  uint32_t served[kBENCH_FAIR_NLINES];
+  uint32_t merged[kBENCH_FAIR_NLINES];
+  uint32_t passes;
+} sBENCH;
+
+static double bench_uniform(void)
+{
+  uint32_t x = sBENCH.rng;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sBENCH.rng = x;
+  return ((double) x + 1.0) / 4294967297.0;
+}
+
+static void bench_schedule(uint32_t i)
+{
+  sBENCH.next_edge[i] += 1u + (uint64_t) (-log(bench_uniform()) * 1e9 / kBENCH_FAIR_LINES[i].rate_hz);
+}
+
+/* Aplica los flancos con instante <= now */
+static void bench_inject(void)
+{
+  for (uint32_t i = 0u; i < kBENCH_FAIR_NLINES; i++) {
+    while (sBENCH.next_edge[i] <= sBENCH.now) {
+      uint32_t line = kBENCH_FAIR_LINES[i].line;
+
+      if ((rEXTI_PR1 & (1u << line)) != 0u) {
+        sBENCH.merged[i]++;
+      } else {
+        (void) EXTI_SIM_Edge(line, 1u);
+        if (sBENCH.since[i] == kBENCH_FAIR_NONE) {
+          sBENCH.since[i] = sBENCH.next_edge[i];
+        }
+      }
+      bench_schedule(i);
+    }
+  }
+}
+
+static void bench_handler(uint32_t line, uint32_t events, void *ctx)
+{
+  uint32_t i = (uint32_t) (uintptr_t) ctx;
+
+  (void) line;
+  (void) events;
+  bench_inject();
+  if (sBENCH.since[i] != kBENCH_FAIR_NONE) {
+    uint64_t lat = sBENCH.now - sBENCH.since[i];
+
+    sBENCH.lat_sum[i] += lat;
+    if (lat > sBENCH.lat_max[i]) {
+      sBENCH.lat_max[i] = lat;
+    }
+    sBENCH.served[i]++;
+    sBENCH.since[i] = kBENCH_FAIR_NONE;
+  }
+  sBENCH.now += kBENCH_FAIR_LINES[i].cost_ns;
+  bench_inject();
+}
+
+#if EXTI_DISPATCH == EXTI_DISPATCH_BITSCAN
+/* Referencia: atiende siempre la línea pendiente más baja y vuelve a leer PR1 */
+static void bench_rescan_service(uint32_t lines)
+{
+  uint32_t pend;
+
+  while ((pend = rEXTI_PR1 & rEXTI_IMR1 & lines) != 0u) {
+    uint32_t line = (uint32_t) __builtin_ctz(pend);
+
+    EXTI_PR1_CLEAR(1u << line);
+    EXTI_DispatchLine(line, sEXTI_SLOTS[line].trigger & mEXTI_TRIG_EDGE);
+  }
+}
+#endif
+
+static void bench_run(const char *name, void (*service)(uint32_t), uint64_t end)
+{
+  sBENCH.now    = 0u;
+  sBENCH.rng    = 0x13579BDFu;
+  sBENCH.passes = 0u;
+  EXTI_SIM_ClearPending1(0xFFFFFFFFu);
+  for (uint32_t i = 0u; i < kBENCH_FAIR_NLINES; i++) {
+    sBENCH.next_edge[i] = 0u;
+    sBENCH.since[i]     = kBENCH_FAIR_NONE;
+    sBENCH.lat_max[i]   = 0u;
+    sBENCH.lat_sum[i]   = 0u;
+    sBENCH.served[i]    = 0u;
+    sBENCH.merged[i]    = 0u;
+    bench_schedule(i);
+  }
+
+  while (sBENCH.now < end) {
+    uint32_t pend;
+
+    bench_inject();
+    pend = rEXTI_PR1 & rEXTI_IMR1;
+    if ((pend & mBENCH_FAIR_V9_5) != 0u) {
+      sBENCH.now += kBENCH_FAIR_ENTRY_NS;     /* EXTI9_5 (IRQ 23) antes que EXTI15_10 (IRQ 40) */
+      service(mBENCH_FAIR_V9_5);
+    } else if ((pend & mBENCH_FAIR_V15_10) != 0u) {
+      sBENCH.now += kBENCH_FAIR_ENTRY_NS;
+      service(mBENCH_FAIR_V15_10);
+    } else {
+      uint64_t next = sBENCH.next_edge[0];
+
+      for (uint32_t i = 1u; i < kBENCH_FAIR_NLINES; i++) {
+        next = (sBENCH.next_edge[i] < next) ? sBENCH.next_edge[i] : next;
+      }
+      sBENCH.now = next;
+      continue;
+    }
+    sBENCH.passes++;
+  }
+
+  printf("\n%s: %u activations\n", name, sBENCH.passes);
+  printf("%-6s %10s %10s %10s %12s %12s\n", "line", "rate/s", "served", "merged", "mean us", "max us");
+  for (uint32_t i = 0u; i < kBENCH_FAIR_NLINES; i++) {
+    printf("%-6u %10.0f %10u %10u %12.2f %12.2f\n", kBENCH_FAIR_LINES[i].line,
+           kBENCH_FAIR_LINES[i].rate_hz, sBENCH.served[i], sBENCH.merged[i],
+           (sBENCH.served[i] != 0u) ? (double) sBENCH.lat_sum[i] / sBENCH.served[i] / 1000.0 : 0.0,
+           (double) sBENCH.lat_max[i] / 1000.0);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t ms   = BENCH_Iterations(argc, argv, 1000u);
+  double   load = 0.0;
+
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  for (uint32_t i = 0u; i < kBENCH_FAIR_NLINES; i++) {
+    EXTI_LineConfig(kBENCH_FAIR_LINES[i].line, kEXTI_TRIG_EDGE_RISING, bench_handler,
+                    (void *) (uintptr_t) i);
+    EXTI_LineEnable(kBENCH_FAIR_LINES[i].line);
+    load += kBENCH_FAIR_LINES[i].rate_hz * kBENCH_FAIR_LINES[i].cost_ns * 1e-9;
+  }
+
+  printf("EXTI15_10 storm, %u ms simulated, handler load %.0f %% + %u ns per activation\n",
+         ms, load * 100.0, kBENCH_FAIR_ENTRY_NS);
+
+#if EXTI_DISPATCH == EXTI_DISPATCH_FAIR
+  {
+    char name[32];
+
+    snprintf(name, sizeof(name), "fair (budget %u)", kEXTI_DISPATCH_BUDGET);
+    bench_run(name, EXTI_STM32L4_Service, (uint64_t) ms * 1000000u);
+  }
+#else
+  bench_run("rescan", bench_rescan_service, (uint64_t) ms * 1000000u);
+  bench_run("bitscan", EXTI_STM32L4_Service, (uint64_t) ms * 1000000u);
+#endif
+  return 0;
+}
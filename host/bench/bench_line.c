@@ -0,0 +1,149 @@
+/**
+ * \file bench_line.c
+ * \brief Coste por evento del motor de despacho de EXTI_line sobre cada backend simulado.
+ * \details Se compila una vez por backend (bench_line_stm32, bench_line_rp2040). Se inyectan
+ * flancos en k líneas del mismo vector/registro y se guarda una instantánea del bloque
+ * simulado; cada pasada restaura la instantánea y ejecuta la rutina de servicio una vez, de
+ * modo que el reconocimiento por palabra se amortiza entre las k líneas. Al tiempo total se
+ * le descuenta el de restaurar la instantánea.
+ *
+ * Los ejecutables *_prio usan EXTI_DISPATCH_PRIORITY con prioridades inversas al número de
+ * línea (la más alta primero), para comparar la permutación con el orden de bitscan; se
+ * imprime el orden observado de la primera pasada.
+ *
+ * Los ejecutables *_fair usan EXTI_DISPATCH_FAIR: cada pasada atiende como mucho
+ * kEXTI_DISPATCH_BUDGET líneas, así que la rutina de servicio se repite mientras quede
+ * petición activa, como haría el tail-chaining, y ns/evento cubre todas las entradas.
+ *
+ * Uso: bench_line_<backend>[_prio|_fair] [pasadas]
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "EXTI_line.h"
+#include "bench_util.h"
+
+#if EXTI_PORT == EXTI_PORT_STM32L4
+#include "EXTI_sim.h"
+#define kBENCH_LINE_FIRST   (10u)   /* Grupo EXTI15_10 */
+#define kBENCH_LINE_MAXK    (6u)
+#define BENCH_LINE_NAME     "stm32l4 (EXTI15_10)"
+#define sBENCH_LINE_BLOCK   sEXTI_SIM
+#else
+#include "IO_BANK0_sim.h"
+#define kBENCH_LINE_FIRST   (0u)    /* Registro INTR0: GPIO0-7 */
+#define kBENCH_LINE_MAXK    (8u)
+#define BENCH_LINE_NAME     "rp2040 (INTR0)"
+#define sBENCH_LINE_BLOCK   sIO_BANK0_SIM
+#endif
+
+#if EXTI_DISPATCH == EXTI_DISPATCH_PRIORITY
+#define BENCH_LINE_ORDER    "priority"
+#elif EXTI_DISPATCH == EXTI_DISPATCH_FAIR
+#define BENCH_LINE_ORDER    "fair"
+#else
+#define BENCH_LINE_ORDER    "bitscan"
+#endif
+
+static volatile uint32_t sBENCH_LINE_CALLS;
+static uint8_t           sBENCH_LINE_ORDER[kBENCH_LINE_MAXK];
+
+static void bench_line_handler(uint32_t line, uint32_t events, void *ctx)
+{
+  (void) events;
+  (void) ctx;
+  if (sBENCH_LINE_CALLS < kBENCH_LINE_MAXK) {
+    sBENCH_LINE_ORDER[sBENCH_LINE_CALLS] = (uint8_t) line;
+  }
+  sBENCH_LINE_CALLS++;
+}
+
+static void bench_line_inject(uint32_t k)
+{
+  for (uint32_t i = 0u; i < k; i++) {
+#if EXTI_PORT == EXTI_PORT_STM32L4
+    (void) EXTI_SIM_Edge(kBENCH_LINE_FIRST + i, 1u);
+#else
+    IO_BANK0_SIM_SetPin(kBENCH_LINE_FIRST + i, 1u);
+    IO_BANK0_SIM_SetPin(kBENCH_LINE_FIRST + i, 0u);
+#endif
+  }
+}
+
+/* Petición aún activa hacia el NVIC tras una pasada */
+static uint32_t bench_line_pending(void)
+{
+#if EXTI_PORT == EXTI_PORT_STM32L4
+  return (rEXTI_PR1 & rEXTI_IMR1 & 0x0000FC00u) != 0u;
+#else
+  return IO_BANK0_SIM_IrqPending(0u);
+#endif
+}
+
+static void bench_line_service(void)
+{
+  do {
+#if EXTI_PORT == EXTI_PORT_STM32L4
+    EXTI_STM32L4_Service(0x0000FC00u);
+#else
+    EXTI_RP2040_Service();
+#endif
+  } while ((EXTI_DISPATCH == EXTI_DISPATCH_FAIR) && bench_line_pending());
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t passes = BENCH_Iterations(argc, argv, 1000000u);
+
+#if EXTI_PORT == EXTI_PORT_STM32L4
+  EXTI_SIM_Reset();
+#else
+  IO_BANK0_SIM_Reset();
+#endif
+  EXTI_LineInit();
+
+  for (uint32_t i = 0u; i < kBENCH_LINE_MAXK; i++) {
+    EXTI_LineConfig(kBENCH_LINE_FIRST + i, kEXTI_TRIG_EDGE_RISING, bench_line_handler, NULL);
+#if EXTI_DISPATCH == EXTI_DISPATCH_PRIORITY
+    EXTI_LinePriority(kBENCH_LINE_FIRST + i, (uint8_t) (kBENCH_LINE_MAXK - i));
+#endif
+    EXTI_LineEnable(kBENCH_LINE_FIRST + i);
+  }
+
+  printf("EXTI_line dispatch, backend %s, %s order, %u passes\n",
+         BENCH_LINE_NAME, BENCH_LINE_ORDER, passes);
+  printf("%-8s %14s %14s   %s\n", "lines", "ns/event", "handler calls", "order");
+
+  for (uint32_t k = 1u; k <= kBENCH_LINE_MAXK; k *= 2u) {
+    static __typeof__(sBENCH_LINE_BLOCK) snapshot;
+    uint64_t t0, t_restore, t_total;
+
+    bench_line_inject(k);
+    memcpy((void *) &snapshot, (const void *) &sBENCH_LINE_BLOCK, sizeof(snapshot));
+
+    t0 = BENCH_NowNs();
+    for (uint32_t p = 0u; p < passes; p++) {
+      memcpy((void *) &sBENCH_LINE_BLOCK, (const void *) &snapshot, sizeof(snapshot));
+      __asm__ volatile("" ::: "memory");
+    }
+    t_restore = BENCH_NowNs() - t0;
+
+    sBENCH_LINE_CALLS = 0u;
+    t0 = BENCH_NowNs();
+    for (uint32_t p = 0u; p < passes; p++) {
+      memcpy((void *) &sBENCH_LINE_BLOCK, (const void *) &snapshot, sizeof(snapshot));
+      bench_line_service();
+    }
+    t_total = BENCH_NowNs() - t0;
+
+    printf("%-8u %14.2f %14u  ", k,
+           (double) (int64_t) (t_total - t_restore) / ((double) passes * k),
+           sBENCH_LINE_CALLS);
+    for (uint32_t i = 0u; i < k; i++) {
+      printf(" %u", sBENCH_LINE_ORDER[i]);
+    }
+    printf("\n");
+  }
+  return 0;
+}
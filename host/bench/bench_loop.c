@@ -0,0 +1,227 @@
+/**
+ * \file bench_loop.c
+ * \brief Despertares por segundo y latencia de eventos del bucle sin tick (EXTI_loop.h).
+ * \details Simulación en tiempo virtual (1 tick = 1 us) sobre el backend STM32L4 simulado:
+ * un temporizador de 1 s (el "Hello, world!" de main), otro de 100 ms y flancos en la línea 3
+ * con llegadas de Poisson de media 20/s. Se comparan tres políticas de reposo:
+ *  - tickless:  EXTI_LoopIdle() programa el despertar en la próxima expiración; la IRQ de la
+ *               línea también despierta.
+ *  - tick 1ms:  el núcleo despierta en cada tick periódico de 1 ms y en cada IRQ de línea.
+ *  - sleep 1s:  el sondeo actual de main (sleep_ms(1000)): la ISR captura el flanco, pero el
+ *               bucle solo lo procesa al despertar cada segundo.
+ * Se cuentan los despertares del núcleo (salidas de WFI, incluidas las de las ISRs).
+ *
+ * Al final, en modo tickless y sin temporizadores, un único flanco llega tras
+ * kBENCH_LOOP_GAP_US de reposo y su manejador arma un plazo de kBENCH_LOOP_GAP_TIMEOUT_US con
+ * EXTI_TimerStartIn(): el plazo debe contarse desde el flanco y no desde el último avance de
+ * la rueda, que quedó al principio del reposo. A continuación el manejador espera con
+ * EXTI_WaitBlocking() kBENCH_LOOP_GAP_WAIT_US un flanco que no llega: sin tick, la espera
+ * tiene que avanzar la rueda y programar el despertar por sí misma para vencer.
+ *
+ * Uso: bench_loop [segundos simulados]
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "EXTI_loop.h"
+#include "EXTI_wait.h"
+#include "EXTI_sim.h"
+#include "bench_util.h"
+
+#define kBENCH_LOOP_LINE      (3u)
+#define kBENCH_LOOP_EDGE_HZ   (20.0)
+#define kBENCH_LOOP_GAP_US    (10000000u)
+#define kBENCH_LOOP_GAP_TIMEOUT_US (50000u)
+#define kBENCH_LOOP_GAP_WAIT_US    (20000u)
+#define kBENCH_LOOP_WAIT_LINE (4u)
+
+typedef enum {
+  kBENCH_TICKLESS = 0,
+  kBENCH_TICK_1MS,
+  kBENCH_SLEEP_1S
+} __BENCH_MODE_t;
+
+static const char *const kBENCH_MODE_NAME[] = { "tickless", "tick 1ms", "sleep 1s" };
+
+static struct {
+  __BENCH_MODE_t mode;
+  uint32_t       now;
+  uint32_t       end;
+  uint32_t       next_edge;
+  uint32_t       rng;
+  uint32_t       cpu_wakeups;
+  uint32_t       edges;
+} sBENCH;
+
+uint32_t EXTI_TIME_Now(void)
+{
+  return sBENCH.now;
+}
+
+uint32_t EXTI_LOOP_Now(void)
+{
+  return sBENCH.now;
+}
+
+static double bench_uniform(void)
+{
+  uint32_t x = sBENCH.rng;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sBENCH.rng = x;
+  return ((double) x + 1.0) / 4294967297.0;
+}
+
+static void bench_schedule_edge(void)
+{
+  sBENCH.next_edge = sBENCH.now + 1u + (uint32_t) (-log(bench_uniform()) * 1e6 / kBENCH_LOOP_EDGE_HZ);
+}
+
+/* IRQ de la línea: despierta el núcleo, captura y vuelve al código interrumpido */
+static void bench_fire_edge(void)
+{
+  sBENCH.now = sBENCH.next_edge;
+  sBENCH.cpu_wakeups++;
+  sBENCH.edges++;
+  (void) EXTI_SIM_Edge(kBENCH_LOOP_LINE, 1u);
+  EXTI_STM32L4_Service(1u << kBENCH_LOOP_LINE);
+  bench_schedule_edge();
+}
+
+void EXTI_LOOP_Sleep(uint32_t armed, uint32_t deadline)
+{
+  uint32_t wake;
+
+  switch (sBENCH.mode) {
+    case kBENCH_TICKLESS:
+      wake = armed ? deadline : sBENCH.end;
+      break;
+    case kBENCH_TICK_1MS:
+      wake = (sBENCH.now / 1000u + 1u) * 1000u;
+      break;
+    default:
+      wake = (sBENCH.now / 1000000u + 1u) * 1000000u;
+      break;
+  }
+
+  while ((int32_t) (sBENCH.next_edge - wake) < 0) {
+    bench_fire_edge();
+    if (sBENCH.mode != kBENCH_SLEEP_1S) {
+      return;   /* La ISR deja trabajo en la cola: el bucle sale de WFI */
+    }
+  }
+  sBENCH.now = wake;
+  sBENCH.cpu_wakeups++;
+}
+
+static void bench_periodic(__EXTI_TIMER_t *t, void *ctx)
+{
+  EXTI_TimerStart(&sEXTI_WHEEL, t, t->expires + (uint32_t) (uintptr_t) ctx);
+}
+
+static struct {
+  __EXTI_TIMER_t timer;
+  uint32_t       edge;      /*!< Marca del flanco */
+  uint32_t       fired;     /*!< Instante del vencimiento del plazo */
+  uint32_t       waited;    /*!< Duración de la espera bloqueante */
+  uint32_t       state;     /*!< Resultado de la espera bloqueante */
+} sBENCH_GAP;
+
+static void bench_gap_expired(__EXTI_TIMER_t *t, void *ctx)
+{
+  (void) t;
+  (void) ctx;
+  sBENCH_GAP.fired = sBENCH.now;
+}
+
+static void bench_gap_edge(const __EXTI_EVENT_t *ev, void *ctx)
+{
+  (void) ctx;
+  sBENCH_GAP.edge  = ev->ts;
+  sBENCH.next_edge = sBENCH.end + 1u;   /* Un solo flanco */
+  EXTI_TimerStartIn(&sEXTI_WHEEL, &sBENCH_GAP.timer, kBENCH_LOOP_GAP_TIMEOUT_US);
+
+  sBENCH_GAP.state  = EXTI_WaitBlocking(kBENCH_LOOP_WAIT_LINE, kEXTI_TRIG_EDGE_RISING,
+                                        kBENCH_LOOP_GAP_WAIT_US, NULL);
+  sBENCH_GAP.waited = sBENCH.now - ev->ts;
+}
+
+/* Plazo relativo armado por un manejador tras un reposo largo */
+static void bench_gap(void)
+{
+  static __EXTI_LOOP_t lp;
+
+  sBENCH.mode      = kBENCH_TICKLESS;
+  sBENCH.now       = 0u;
+  sBENCH.end       = kBENCH_LOOP_GAP_US + 1000000u;
+  sBENCH.next_edge = kBENCH_LOOP_GAP_US;
+  sBENCH_GAP.fired = 0u;
+  sBENCH_GAP.state = kEXTI_WAIT_IDLE;
+
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  EXTI_LoopInit(&lp);
+  EXTI_LoopLineConfig(&lp, kBENCH_LOOP_LINE, kEXTI_TRIG_EDGE_RISING, bench_gap_edge, NULL);
+  EXTI_TimerInit(&sBENCH_GAP.timer, bench_gap_expired, NULL);
+  (void) EXTI_WaitAttach(kBENCH_LOOP_WAIT_LINE, kEXTI_TRIG_EDGE_RISING);
+
+  while ((int32_t) (sBENCH.now - sBENCH.end) < 0) {
+    (void) EXTI_LoopRunOnce(&lp);
+    EXTI_LoopIdle(&lp);
+  }
+  printf("\nhandler timeout after %u s idle: armed %u us, fired %u us after the edge\n",
+         kBENCH_LOOP_GAP_US / 1000000u, kBENCH_LOOP_GAP_TIMEOUT_US,
+         sBENCH_GAP.fired - sBENCH_GAP.edge);
+  printf("blocking wait in the handler: %u us, %s after %u us\n", kBENCH_LOOP_GAP_WAIT_US,
+         (sBENCH_GAP.state == kEXTI_WAIT_TIMEOUT) ? "timeout" : "no timeout", sBENCH_GAP.waited);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seconds = BENCH_Iterations(argc, argv, 600u);
+
+  printf("event loop, %u s simulated, timers 1 s + 100 ms, %.0f edges/s on line %u\n",
+         seconds, kBENCH_LOOP_EDGE_HZ, kBENCH_LOOP_LINE);
+  printf("%-10s %12s %10s %14s %14s %10s\n",
+         "mode", "wakeups/s", "events", "latency us", "max us", "timers");
+
+  for (uint32_t m = kBENCH_TICKLESS; m <= kBENCH_SLEEP_1S; m++) {
+    static __EXTI_LOOP_t lp;
+    __EXTI_TIMER_t       t1, t2;
+
+    sBENCH.mode        = (__BENCH_MODE_t) m;
+    sBENCH.now         = 0u;
+    sBENCH.end         = seconds * 1000000u;
+    sBENCH.rng         = 0x2468ACEu;
+    sBENCH.cpu_wakeups = 0u;
+    sBENCH.edges       = 0u;
+    bench_schedule_edge();
+
+    EXTI_SIM_Reset();
+    EXTI_LineInit();
+    EXTI_LoopInit(&lp);
+    EXTI_LoopLineConfig(&lp, kBENCH_LOOP_LINE, kEXTI_TRIG_EDGE_RISING, NULL, NULL);
+    EXTI_TimerInit(&t1, bench_periodic, (void *) (uintptr_t) 1000000u);
+    EXTI_TimerInit(&t2, bench_periodic, (void *) (uintptr_t) 100000u);
+    EXTI_TimerStartIn(&sEXTI_WHEEL, &t1, 1000000u);
+    EXTI_TimerStartIn(&sEXTI_WHEEL, &t2, 100000u);
+
+    while ((int32_t) (sBENCH.now - sBENCH.end) < 0) {
+      (void) EXTI_LoopRunOnce(&lp);
+      EXTI_LoopIdle(&lp);
+    }
+    (void) EXTI_LoopRunOnce(&lp);
+
+    printf("%-10s %12.1f %10u %14.1f %14u %10u\n", kBENCH_MODE_NAME[m],
+           (double) sBENCH.cpu_wakeups / seconds, lp.events,
+           (lp.events != 0u) ? (double) lp.latency_sum / lp.events : 0.0,
+           lp.latency_max, lp.timers);
+    EXTI_TimerCancel(&sEXTI_WHEEL, &t1);
+    EXTI_TimerCancel(&sEXTI_WHEEL, &t2);
+  }
+  bench_gap();
+  return 0;
+}
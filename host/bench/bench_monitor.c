@@ -0,0 +1,275 @@
+/**
+ * \file bench_monitor.c
+ * \brief Vigilancia de 16 señales periódicas con EXTI_monitor.h frente a un temporizador por
+ * línea.
+ * \details Simulación en tiempo virtual (1 tick = 1 us, mismo tick para la rueda y para
+ * EXTI_TIMESTAMP()) sobre el backend STM32L4 simulado. Línea 0: PPS de 1 Hz; líneas 1..15:
+ * periodos de 2..30 ms. Fluctuación del 1 %, plazo de 1,5 periodos y banda del 5 %. Fallos:
+ *  - PPS sin pulsos de 20 a 23 s.
+ *  - Línea 5 parada desde 10 s.
+ *  - Línea 9 un 10 % más lenta desde 30 s.
+ *  - Línea 13 un 10 % más rápida desde 40 s.
+ * "monitor" usa un único temporizador de sEXTI_WHEEL para las 16 líneas (con y sin banda);
+ * "per-line" rearma un temporizador propio de cada línea en cada flanco (sin banda). Se listan
+ * las alarmas con el retraso del latido perdido respecto a último flanco + plazo, y se cuentan
+ * flancos, rearmes de temporizador hechos desde la rutina de servicio y callbacks de la rueda.
+ * Como en el bucle sin tick (EXTI_loop.h), los flancos se inyectan con la rueda dormida: la
+ * rutina de servicio corre antes de avanzar la rueda hasta el instante del flanco, por lo que
+ * los plazos se miden con el reloj registrado (EXTI_WheelClock()) y no con el now de la rueda.
+ * Al final se mide el coste de host de la actualización por flanco de cada variante
+ * (EXTI_MonitorEdge() frente a rearmar el temporizador de la línea) en un bucle cerrado.
+ *
+ * Uso: bench_monitor [segundos simulados]
+ */
+
+#include <stdio.h>
+
+#include "EXTI_monitor.h"
+#include "EXTI_sim.h"
+#include "bench_util.h"
+
+#define kBENCH_MON_LINES      (16u)
+#define kBENCH_MON_NEVER      (UINT32_MAX)
+
+static const char *const kBENCH_MON_STATE[] = { "ok", "MISSED", "FAST", "SLOW" };
+
+static struct {
+  uint32_t       now;
+  uint32_t       rng;
+  uint32_t       period[kBENCH_MON_LINES];
+  uint32_t       next_edge[kBENCH_MON_LINES];
+  uint32_t       last_edge[kBENCH_MON_LINES];
+  uint32_t       level[kBENCH_MON_LINES];
+  uint32_t       edges;
+  uint32_t       callbacks;
+  uint32_t       alarms;
+  uint32_t       rearms;
+  __EXTI_TIMER_t timer[kBENCH_MON_LINES];    /*!< Variante per-line */
+} sBENCH;
+
+static __EXTI_MON_t sBENCH_MON;
+
+uint32_t EXTI_TIME_Now(void)
+{
+  return sBENCH.now;
+}
+
+static uint32_t bench_rand(void)
+{
+  uint32_t x = sBENCH.rng;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sBENCH.rng = x;
+  return x;
+}
+
+static uint32_t bench_nominal(uint32_t line)
+{
+  return (line == 0u) ? 1000000u : 2000u * line;
+}
+
+/* Periodo efectivo de la línea en el instante t (kBENCH_MON_NEVER si no hay flanco) */
+static uint32_t bench_period(uint32_t line, uint32_t t)
+{
+  uint32_t p = bench_nominal(line);
+
+  if ((line == 5u) && (t >= 10000000u)) {
+    return kBENCH_MON_NEVER;
+  }
+  if ((line == 9u) && (t >= 30000000u)) {
+    return p + p / 10u;
+  }
+  if ((line == 13u) && (t >= 40000000u)) {
+    return p - p / 10u;
+  }
+  return p;
+}
+
+static void bench_schedule(uint32_t line)
+{
+  uint32_t t = sBENCH.next_edge[line];
+  uint32_t p;
+
+  do {
+    p = bench_period(line, t);
+    if (p == kBENCH_MON_NEVER) {
+      sBENCH.next_edge[line] = kBENCH_MON_NEVER;
+      return;
+    }
+    /* +-1 % */
+    t += p - p / 100u + bench_rand() % (p / 50u + 1u);
+  } while ((line == 0u) && (t >= 20000000u) && (t < 23000000u));
+  sBENCH.next_edge[line] = t;
+}
+
+static void bench_alarm(uint32_t line, __EXTI_MON_STATE_t state, void *ctx)
+{
+  (void) ctx;
+  sBENCH.alarms++;
+  if (state == kEXTI_MON_MISSED) {
+    printf("  %9.3f s  line %2u  %-6s  %d us after last edge + timeout\n", sBENCH.now / 1e6,
+           line, kBENCH_MON_STATE[state],
+           (int32_t) (sBENCH.now - sBENCH.last_edge[line] - bench_nominal(line) * 3u / 2u));
+  } else {
+    printf("  %9.3f s  line %2u  %-6s\n", sBENCH.now / 1e6, line, kBENCH_MON_STATE[state]);
+  }
+}
+
+static void bench_line_timeout(__EXTI_TIMER_t *t, void *ctx)
+{
+  (void) t;
+  bench_alarm((uint32_t) (uintptr_t) ctx, kEXTI_MON_MISSED, NULL);
+}
+
+static void bench_line_edge(uint32_t line, uint32_t events, void *ctx)
+{
+  (void) events;
+  (void) ctx;
+  sBENCH.rearms++;
+  EXTI_TimerStartIn(&sEXTI_WHEEL, &sBENCH.timer[line], bench_nominal(line) * 3u / 2u);
+}
+
+typedef enum {
+  kBENCH_MON_BAND,
+  kBENCH_MON_NOBAND,
+  kBENCH_MON_PERLINE
+} __BENCH_MON_MODE_t;
+
+static void bench_run(__BENCH_MON_MODE_t mode, uint32_t seconds)
+{
+  static const char *const kNAME[] = {
+    "monitor, one wheel timer, band 5 %", "monitor, one wheel timer, no band",
+    "per-line wheel timers, no band"
+  };
+  uint32_t end = seconds * 1000000u;
+
+  sBENCH.now       = 0u;
+  sBENCH.rng       = 0x0B5E55EDu;
+  sBENCH.edges     = 0u;
+  sBENCH.callbacks = 0u;
+  sBENCH.alarms    = 0u;
+  sBENCH.rearms    = 0u;
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  EXTI_WheelInit(&sEXTI_WHEEL, 0u);
+  EXTI_WheelClock(&sEXTI_WHEEL, EXTI_TIME_Now);
+  EXTI_MonitorInit(&sBENCH_MON, bench_alarm, NULL);
+
+  printf("\n%s:\n", kNAME[mode]);
+  for (uint32_t line = 0u; line < kBENCH_MON_LINES; line++) {
+    uint32_t p = bench_nominal(line);
+
+    sBENCH.next_edge[line] = 0u;
+    sBENCH.last_edge[line] = 0u;
+    sBENCH.level[line]     = 0u;
+    bench_schedule(line);
+    if (mode == kBENCH_MON_BAND) {
+      /* EXTI_TIMESTAMP() también en us: la banda es el periodo +-5 % */
+      EXTI_MonitorAttach(&sBENCH_MON, line, kEXTI_TRIG_EDGE_RISING, p * 3u / 2u,
+                         p - p / 20u, p + p / 20u);
+    } else if (mode == kBENCH_MON_NOBAND) {
+      EXTI_MonitorAttach(&sBENCH_MON, line, kEXTI_TRIG_EDGE_RISING, p * 3u / 2u, 0u, 0u);
+    } else {
+      EXTI_TimerInit(&sBENCH.timer[line], bench_line_timeout, (void *) (uintptr_t) line);
+      EXTI_LineConfig(line, kEXTI_TRIG_EDGE_RISING, bench_line_edge, NULL);
+      EXTI_LineEnable(line);
+      EXTI_TimerStartIn(&sEXTI_WHEEL, &sBENCH.timer[line], p * 3u / 2u);
+    }
+  }
+
+  while (sBENCH.now < end) {
+    uint32_t next = end;
+    uint32_t timer;
+    uint32_t src  = kBENCH_MON_LINES;
+
+    for (uint32_t line = 0u; line < kBENCH_MON_LINES; line++) {
+      if (sBENCH.next_edge[line] < next) {
+        next = sBENCH.next_edge[line];
+        src  = line;
+      }
+    }
+    if (EXTI_WheelNextExpiry(&sEXTI_WHEEL, &timer) && (timer <= next)) {
+      next = timer;
+      src  = kBENCH_MON_LINES;
+    }
+    sBENCH.now = next;
+
+    if (src < kBENCH_MON_LINES) {
+      /* Pulso: flanco de subida despachado y bajada inmediata */
+      sBENCH.edges++;
+      sBENCH.last_edge[src] = sBENCH.now;
+      if (EXTI_SIM_Edge(src, 1u)) {
+        EXTI_STM32L4_Service(1u << src);
+      }
+      (void) EXTI_SIM_Edge(src, 0u);
+      bench_schedule(src);
+    }
+    /* Despertar del bucle: la rueda alcanza el instante después de la rutina de servicio */
+    sBENCH.callbacks += EXTI_WheelAdvance(&sEXTI_WHEEL, sBENCH.now);
+  }
+
+  printf("  %u edges, %u wheel callbacks, %u alarms", sBENCH.edges, sBENCH.callbacks,
+         sBENCH.alarms);
+  if (mode == kBENCH_MON_PERLINE) {
+    printf(", %u timer re-arms in the service routine", sBENCH.rearms);
+  }
+  printf("\n");
+  if (mode != kBENCH_MON_PERLINE) {
+    for (uint32_t line = 0u; line < kBENCH_MON_LINES; line++) {
+      EXTI_MonitorDetach(&sBENCH_MON, line);
+    }
+  }
+}
+
+/* Coste de la actualización por flanco, sin simulador ni despacho */
+static void bench_edge_cost(void)
+{
+  const uint32_t kN = 16000000u;
+  uint64_t       t_mon, t_timer;
+
+  EXTI_WheelInit(&sEXTI_WHEEL, 0u);
+  EXTI_WheelClock(&sEXTI_WHEEL, EXTI_TIME_Now);
+  EXTI_MonitorInit(&sBENCH_MON, NULL, NULL);
+  for (uint32_t line = 0u; line < kBENCH_MON_LINES; line++) {
+    uint32_t p = bench_nominal(line);
+
+    EXTI_MonitorAttach(&sBENCH_MON, line, kEXTI_TRIG_EDGE_RISING, 4000000u, p - p / 20u,
+                       p + p / 20u);
+    EXTI_TimerInit(&sBENCH.timer[line], bench_line_timeout, (void *) (uintptr_t) line);
+  }
+
+  sBENCH.now = 0u;
+  t_mon      = BENCH_NowNs();
+  for (uint32_t i = 0u; i < kN; i++) {
+    uint32_t line = i & (kBENCH_MON_LINES - 1u);
+
+    sBENCH.now += 10u;
+    EXTI_MonitorEdge(line, kEXTI_TRIG_EDGE_RISING, sEXTI_SLOTS[line].ctx);
+  }
+  t_mon = BENCH_NowNs() - t_mon;
+
+  t_timer = BENCH_NowNs();
+  for (uint32_t i = 0u; i < kN; i++) {
+    uint32_t line = i & (kBENCH_MON_LINES - 1u);
+
+    EXTI_TimerStartIn(&sEXTI_WHEEL, &sBENCH.timer[line], bench_nominal(line) * 3u / 2u);
+  }
+  t_timer = BENCH_NowNs() - t_timer;
+
+  printf("\nper-edge update: EXTI_MonitorEdge %.2f ns (band check included), "
+         "timer re-arm %.2f ns\n", (double) t_mon / kN, (double) t_timer / kN);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seconds = BENCH_Iterations(argc, argv, 60u);
+
+  printf("16 periodic lines, %u s simulated\n", seconds);
+  bench_run(kBENCH_MON_BAND, seconds);
+  bench_run(kBENCH_MON_NOBAND, seconds);
+  bench_run(kBENCH_MON_PERLINE, seconds);
+  bench_edge_cost();
+  return 0;
+}
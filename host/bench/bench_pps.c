@@ -0,0 +1,219 @@
+/**
+ * \file bench_pps.c
+ * \brief Correlación entre dos placas con la base de tiempo disciplinada por PPS (EXTI_pps.h).
+ * \details Tiempo verdadero continuo (GPS) y, para cada placa, un contador de 80 MHz con
+ * error de frecuencia fijo y una deriva térmica senoidal:
+ *  - A: +32 ppm, 0,5 ppm de amplitud con periodo de 300 s.
+ *  - B: -47 ppm, 0,8 ppm de amplitud con periodo de 170 s.
+ * El PPS llega a las dos placas en cada segundo entero con +-20 ns de fluctuación de la
+ * fuente y se captura a través del simulador STM32L4 con 40 + (0..16) ticks de latencia de
+ * ISR (kEXTI_PPS_LATENCY = 40 en este objetivo). Tras el primer pulso se etiqueta su segundo
+ * con EXTI_PpsSetSecond(), como haría la trama NMEA. Faltan los pulsos de 200 a 204 s
+ * (holdover) y a 300,5 s llega un pulso espurio.
+ *
+ * 100 eventos por segundo en instantes verdaderos comunes a ambas placas: cada placa guarda
+ * su marca cruda y la convierte en el momento con EXTI_PpsNs(). Se informa, desde el segundo
+ * 30, del error máximo y RMS de cada placa frente al tiempo verdadero, del desacuerdo máximo
+ * entre placas para el mismo evento, del error en el hueco de PPS y del error del contador
+ * libre (frecuencia nominal, fase alineada al primer pulso). Al final, el coste de
+ * EXTI_PpsNs().
+ *
+ * Uso: bench_pps [segundos simulados]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "EXTI_pps.h"
+#include "EXTI_sim.h"
+#include "bench_util.h"
+
+#define kBENCH_PPS_HZ         (80000000u)
+#define kBENCH_PPS_LINE       (2u)
+#define kBENCH_PPS_EVENTS     (100u)      /*!< Eventos por segundo */
+#define kBENCH_PPS_SETTLE     (30u)       /*!< Segundos excluidos de las estadísticas */
+#define kBENCH_PPS_GAP_FROM   (200u)
+#define kBENCH_PPS_GAP_TO     (204u)
+#define kBENCH_PPS_GLITCH     (300u)
+#define kBENCH_PPS_PI         (3.14159265358979323846)
+
+typedef struct {
+  const char *name;
+  double      ppm;        /*!< Error de frecuencia fijo */
+  double      wander;     /*!< Amplitud de la deriva (ppm) */
+  double      period;     /*!< Periodo de la deriva (s) */
+  double      offset;     /*!< Valor del contador en t = 0 (ticks) */
+  uint32_t    seed;
+} __BENCH_PPS_BOARD_t;
+
+static const __BENCH_PPS_BOARD_t kBENCH_PPS_BOARD[2] = {
+  { "A", +32.0, 0.5, 300.0, 1.0e9, 0x1234567u },
+  { "B", -47.0, 0.8, 170.0, 3.7e9, 0x7654321u },
+};
+
+static struct {
+  uint32_t     now;
+  uint32_t     rng;
+  __EXTI_PPS_t pps;
+} sBENCH;
+
+uint32_t EXTI_TIME_Now(void)
+{
+  return sBENCH.now;
+}
+
+static uint32_t bench_rand(uint32_t *state)
+{
+  uint32_t x = *state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+static double bench_uniform(uint32_t *state)
+{
+  return ((double) bench_rand(state) + 1.0) / 4294967297.0;
+}
+
+/* Contador sin desbordar de la placa en el instante verdadero t (s): integral de la frecuencia */
+static double bench_count(const __BENCH_PPS_BOARD_t *b, double t)
+{
+  double w = 2.0 * kBENCH_PPS_PI / b->period;
+  double x = t + 1e-6 * (b->ppm * t + b->wander * (1.0 - cos(w * t)) / w);
+
+  return floor(b->offset + kBENCH_PPS_HZ * x);
+}
+
+static uint32_t bench_ticks(const __BENCH_PPS_BOARD_t *b, double t)
+{
+  return (uint32_t) (uint64_t) bench_count(b, t);
+}
+
+static void bench_pulse(const __BENCH_PPS_BOARD_t *b, double t)
+{
+  double src = t + (bench_uniform(&sBENCH.rng) - 0.5) * 40e-9;
+
+  sBENCH.now = bench_ticks(b, src) + 40u + bench_rand(&sBENCH.rng) % 17u;
+  if (EXTI_SIM_Edge(kBENCH_PPS_LINE, 1u)) {
+    EXTI_STM32L4_Service(1u << kBENCH_PPS_LINE);
+  }
+  (void) EXTI_SIM_Edge(kBENCH_PPS_LINE, 0u);
+}
+
+/* Error de cada evento (ns) con la base disciplinada y con el contador libre */
+static void bench_board(const __BENCH_PPS_BOARD_t *b, const double *ev, uint32_t seconds,
+                        double *err, double *err_free)
+{
+  double   free_ref = 0.0;
+  uint32_t lock     = 0u;
+
+  sBENCH.rng = b->seed;
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  EXTI_PpsInit(&sBENCH.pps, kBENCH_PPS_HZ);
+  EXTI_PpsAttach(&sBENCH.pps, kBENCH_PPS_LINE, kEXTI_TRIG_EDGE_RISING);
+
+  for (uint32_t k = 0u; k < seconds; k++) {
+    for (uint32_t i = 0u; i < kBENCH_PPS_EVENTS; i++) {
+      uint32_t j = k * kBENCH_PPS_EVENTS + i;
+      uint32_t t = bench_ticks(b, ev[j]);
+
+      err[j]      = (double) EXTI_PpsNs(&sBENCH.pps, t) - ev[j] * 1e9;
+      err_free[j] = 1e9 + (bench_count(b, ev[j]) - free_ref) * 1e9 / kBENCH_PPS_HZ
+                    - ev[j] * 1e9;
+    }
+
+    if ((k + 1u >= kBENCH_PPS_GAP_FROM) && (k + 1u <= kBENCH_PPS_GAP_TO)) {
+      continue;
+    }
+    bench_pulse(b, k + 1.0);
+    if (k == 0u) {
+      EXTI_PpsSetSecond(&sBENCH.pps, 1u);
+      free_ref = bench_count(b, 1.0);
+    }
+    if ((lock == 0u) && EXTI_PpsLocked(&sBENCH.pps)) {
+      lock = k + 1u;
+    }
+    if (k + 1u == kBENCH_PPS_GLITCH) {
+      bench_pulse(b, k + 1.5);
+    }
+  }
+
+  printf("  board %s: %+.0f ppm +- %.1f ppm, locked at %u s, %u pulses, %u steps, "
+         "%u glitches rejected\n", b->name, b->ppm, b->wander, lock, sBENCH.pps.pulses,
+         sBENCH.pps.steps, sBENCH.pps.glitches);
+}
+
+static void bench_stats(const char *name, const double *e, const double *ev, uint32_t n)
+{
+  double   max = 0.0, gap = 0.0, sum = 0.0;
+  uint32_t cnt = 0u;
+
+  for (uint32_t j = 0u; j < n; j++) {
+    double a = fabs(e[j]);
+
+    if (ev[j] < kBENCH_PPS_SETTLE) {
+      continue;
+    }
+    if ((ev[j] >= kBENCH_PPS_GAP_FROM - 1u) && (ev[j] < kBENCH_PPS_GAP_TO + 1u)) {
+      gap = (a > gap) ? a : gap;
+    }
+    max  = (a > max) ? a : max;
+    sum += a * a;
+    cnt++;
+  }
+  printf("  %-28s max %10.1f ns  rms %8.1f ns  (PPS gap: max %8.1f ns)\n", name, max,
+         sqrt(sum / cnt), gap);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seconds = BENCH_Iterations(argc, argv, 600u);
+  uint32_t n       = seconds * kBENCH_PPS_EVENTS;
+  double  *ev      = malloc(sizeof(double) * n);
+  double  *err[2], *err_free[2], *cross = malloc(sizeof(double) * n);
+  uint32_t rng     = 0x0E7E575Eu;
+  uint64_t t0;
+  uint32_t sink    = 0u;
+
+  for (uint32_t j = 0u; j < n; j++) {
+    ev[j] = (j / kBENCH_PPS_EVENTS) + bench_uniform(&rng);
+  }
+
+  printf("PPS-disciplined timebase, %u Hz counter, Kp = 1/%u, Ki = 1/%u, %u s simulated\n",
+         kBENCH_PPS_HZ, 1u << kEXTI_PPS_KP_SHIFT, 1u << kEXTI_PPS_KI_SHIFT, seconds);
+  for (uint32_t b = 0u; b < 2u; b++) {
+    err[b]      = malloc(sizeof(double) * n);
+    err_free[b] = malloc(sizeof(double) * n);
+    bench_board(&kBENCH_PPS_BOARD[b], ev, seconds, err[b], err_free[b]);
+  }
+  for (uint32_t j = 0u; j < n; j++) {
+    cross[j] = err[0][j] - err[1][j];
+  }
+
+  printf("event timestamps vs true time, from %u s:\n", kBENCH_PPS_SETTLE);
+  bench_stats("A disciplined", err[0], ev, n);
+  bench_stats("B disciplined", err[1], ev, n);
+  bench_stats("A - B (same event)", cross, ev, n);
+  bench_stats("A free-running", err_free[0], ev, n);
+  bench_stats("B free-running", err_free[1], ev, n);
+
+  t0 = BENCH_NowNs();
+  for (uint32_t i = 0u; i < 10000000u; i++) {
+    sink += (uint32_t) EXTI_PpsNs(&sBENCH.pps, sBENCH.now + i * 97u);
+  }
+  t0 = BENCH_NowNs() - t0;
+  printf("EXTI_PpsNs: %.2f ns per conversion (sink %u)\n", t0 / 1e7, sink & 1u);
+
+  for (uint32_t b = 0u; b < 2u; b++) {
+    free(err[b]);
+    free(err_free[b]);
+  }
+  free(cross);
+  free(ev);
+  return 0;
+}
@@ -0,0 +1,229 @@
+/**
+ * \file bench_rec.c
+ * \brief Cola de registros variables sin copias frente a una cola de ranuras fijas con copia.
+ * \details Mezcla de tramas de decodificadores sobre la misma memoria (~1 KiB):
+ *  - 40 % IR NEC:          4 bytes.
+ *  - 20 % Wiegand 34 bits: 5 bytes.
+ *  - 40 % línea UART:      8..64 bytes, longitud conocida solo al final (se reserva el máximo).
+ * "slots" es una cola SPSC de ranuras de kBENCH_REC_MAX bytes: el decodificador construye la
+ * trama en un búfer local, se copia en la ranura y el consumidor la copia de nuevo a su búfer.
+ * "rec" es EXTI_rec.h: el decodificador escribe en la reserva y el consumidor lee en sitio.
+ * Se mide el tiempo por trama (lotes de kBENCH_REC_BATCH) y cuántas tramas caben en la cola.
+ *
+ * Uso: bench_rec [tramas]
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "EXTI_rec.h"
+#include "bench_util.h"
+
+#define kBENCH_REC_MAX        (64u)
+#define kBENCH_REC_BATCH      (8u)
+#define kBENCH_REC_SLOTS      (kEXTI_REC_SIZE / sizeof(__BENCH_SLOT_t))
+
+typedef struct {
+  uint16_t len;
+  uint16_t tag;
+  uint8_t  data[kBENCH_REC_MAX];
+} __BENCH_SLOT_t;
+
+/* Cola de ranuras fijas con el mismo protocolo que EXTI_ring.h */
+typedef struct {
+  _Atomic uint32_t head;
+  uint8_t          _pad0[kEXTI_RING_PAD - 4u];
+  _Atomic uint32_t tail;
+  uint8_t          _pad1[kEXTI_RING_PAD - 4u];
+  __BENCH_SLOT_t   slot[kBENCH_REC_SLOTS];
+} __BENCH_SLOTS_t;
+
+static __EXTI_REC_t    sBENCH_REC;
+static __BENCH_SLOTS_t sBENCH_SLOTS;
+static uint32_t        sBENCH_RNG;
+
+static uint32_t bench_rand(void)
+{
+  uint32_t x = sBENCH_RNG;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sBENCH_RNG = x;
+  return x;
+}
+
+/* Tipo y longitud de la siguiente trama */
+static uint32_t bench_frame(uint32_t *tag)
+{
+  uint32_t r = bench_rand() % 10u;
+
+  if (r < 4u) {
+    *tag = 0u;
+    return 4u;
+  }
+  if (r < 6u) {
+    *tag = 1u;
+    return 5u;
+  }
+  *tag = 2u;
+  return 8u + bench_rand() % (kBENCH_REC_MAX - 8u + 1u);
+}
+
+/* Decodificador: genera los bytes de la trama uno a uno, como al ensamblar bits */
+static void bench_decode(uint8_t *dst, uint32_t len, uint32_t seed)
+{
+  for (uint32_t i = 0u; i < len; i++) {
+    dst[i] = (uint8_t) (seed + i * 131u);
+  }
+}
+
+static uint32_t bench_consume(const uint8_t *p, uint32_t len)
+{
+  uint32_t sum = 0u;
+
+  for (uint32_t i = 0u; i < len; i++) {
+    sum = sum * 31u + p[i];
+  }
+  return sum;
+}
+
+static uint32_t bench_slots_push(__BENCH_SLOTS_t *q, const uint8_t *data, uint32_t len, uint32_t tag)
+{
+  uint32_t        head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  uint32_t        tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+  __BENCH_SLOT_t *s;
+
+  if ((head - tail) >= kBENCH_REC_SLOTS) {
+    return 0u;
+  }
+  s = &q->slot[head % kBENCH_REC_SLOTS];
+  s->len = (uint16_t) len;
+  s->tag = (uint16_t) tag;
+  memcpy(s->data, data, len);
+  atomic_store_explicit(&q->head, head + 1u, memory_order_release);
+  return 1u;
+}
+
+static uint32_t bench_slots_pop(__BENCH_SLOTS_t *q, uint8_t *data, uint32_t *len)
+{
+  uint32_t              tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  uint32_t              head = atomic_load_explicit(&q->head, memory_order_acquire);
+  const __BENCH_SLOT_t *s;
+
+  if (head == tail) {
+    return 0u;
+  }
+  s    = &q->slot[tail % kBENCH_REC_SLOTS];
+  *len = s->len;
+  memcpy(data, s->data, s->len);
+  atomic_store_explicit(&q->tail, tail + 1u, memory_order_release);
+  return 1u;
+}
+
+static uint64_t bench_run_slots(uint32_t frames, uint32_t *sum)
+{
+  uint8_t  frame[kBENCH_REC_MAX];
+  uint8_t  out[kBENCH_REC_MAX];
+  uint32_t len, tag;
+  uint64_t t0;
+
+  atomic_store_explicit(&sBENCH_SLOTS.head, 0u, memory_order_relaxed);
+  atomic_store_explicit(&sBENCH_SLOTS.tail, 0u, memory_order_relaxed);
+  sBENCH_RNG = 0x5EC0DE5u;
+  *sum       = 0u;
+
+  t0 = BENCH_NowNs();
+  for (uint32_t i = 0u; i < frames; i += kBENCH_REC_BATCH) {
+    for (uint32_t j = 0u; j < kBENCH_REC_BATCH; j++) {
+      len = bench_frame(&tag);
+      bench_decode(frame, len, i + j);
+      (void) bench_slots_push(&sBENCH_SLOTS, frame, len, tag);
+    }
+    while (bench_slots_pop(&sBENCH_SLOTS, out, &len)) {
+      *sum += bench_consume(out, len);
+    }
+  }
+  return BENCH_NowNs() - t0;
+}
+
+static uint64_t bench_run_rec(uint32_t frames, uint32_t *sum)
+{
+  __EXTI_REC_VIEW_t v;
+  uint32_t          len, tag;
+  uint64_t          t0;
+
+  EXTI_RecInit(&sBENCH_REC);
+  sBENCH_RNG = 0x5EC0DE5u;
+  *sum       = 0u;
+
+  t0 = BENCH_NowNs();
+  for (uint32_t i = 0u; i < frames; i += kBENCH_REC_BATCH) {
+    for (uint32_t j = 0u; j < kBENCH_REC_BATCH; j++) {
+      uint8_t *p;
+
+      len = bench_frame(&tag);
+      p   = EXTI_RecReserve(&sBENCH_REC, (tag == 2u) ? kBENCH_REC_MAX : len);
+      if (p != NULL) {
+        bench_decode(p, len, i + j);
+        EXTI_RecCommit(&sBENCH_REC, len, tag);
+      }
+    }
+    while (EXTI_RecPeek(&sBENCH_REC, &v)) {
+      *sum += bench_consume(v.data, v.len);
+      EXTI_RecRelease(&sBENCH_REC, &v);
+    }
+  }
+  return BENCH_NowNs() - t0;
+}
+
+/* Tramas que caben en cada cola llenándola desde vacía, promedio de varias pasadas */
+static void bench_capacity(double *slots, double *rec)
+{
+  const uint32_t kPASSES = 1000u;
+  uint64_t       n_rec   = 0u;
+  uint32_t       len, tag;
+
+  sBENCH_RNG = 0xCA9AC17u;
+  for (uint32_t pass = 0u; pass < kPASSES; pass++) {
+    EXTI_RecInit(&sBENCH_REC);
+    for (;;) {
+      uint8_t *p;
+
+      len = bench_frame(&tag);
+      p   = EXTI_RecReserve(&sBENCH_REC, len);
+      if (p == NULL) {
+        break;
+      }
+      bench_decode(p, len, pass);
+      EXTI_RecCommit(&sBENCH_REC, len, tag);
+      n_rec++;
+    }
+  }
+  *slots = (double) kBENCH_REC_SLOTS;
+  *rec   = (double) n_rec / kPASSES;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t frames = BENCH_Iterations(argc, argv, 4000000u) & ~(kBENCH_REC_BATCH - 1u);
+  uint32_t sum_slots, sum_rec;
+  uint64_t t_slots, t_rec;
+  uint32_t padded;
+  double   cap_slots, cap_rec;
+
+  printf("variable-length frames: %u frames, batches of %u, %u-byte queues\n", frames,
+         kBENCH_REC_BATCH, kEXTI_REC_SIZE);
+
+  t_slots = bench_run_slots(frames, &sum_slots);
+  t_rec   = bench_run_rec(frames, &sum_rec);
+  padded  = sBENCH_REC.padded;
+  bench_capacity(&cap_slots, &cap_rec);
+
+  printf("%-8s %12s %14s\n", "queue", "ns/frame", "frames queued");
+  printf("%-8s %12.2f %14.1f\n", "slots", (double) t_slots / frames, cap_slots);
+  printf("%-8s %12.2f %14.1f\n", "rec", (double) t_rec / frames, cap_rec);
+  printf("checksums %s, rec padding records %u\n", (sum_slots == sum_rec) ? "match" : "MISMATCH",
+         padded);
+  return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * \file bench_stat.c
+ * \brief Contadores EXTI_stat.h frente a una sección crítica global, con contención.
+ * \details Modelo de host: cada hilo hace de una ISR (o del bucle principal) que, por evento,
+ * suma el contador de eventos, actualiza la latencia máxima, cuenta la latencia en el
+ * histograma log2 e incrementa el contador empaquetado de 8 bits de su línea. Todos los hilos
+ * comparten los mismos contadores.
+ *  - lock:   las cuatro actualizaciones dentro de un único mutex, el equivalente de host de
+ *            enmascarar interrupciones alrededor de la actualización.
+ *  - atomic: cada actualización con EXTI_stat.h (atómicas relaxed; LDREX/STREX en Cortex-M4).
+ * Se mide ns por evento con 1, 2 y 4 hilos y se comprueban los totales. Con una sola CPU los
+ * hilos solo compiten cuando el planificador expulsa a uno a mitad de la actualización.
+ *
+ * Uso: bench_stat [eventos_por_hilo]
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include "EXTI_stat.h"
+#include "bench_util.h"
+
+#define kBENCH_STAT_THREADS   (4u)
+#define kBENCH_STAT_LINES     (16u)
+
+typedef struct {
+  __EXTI_STAT_t      events;
+  __EXTI_STAT_t      lat_max;
+  __EXTI_STAT_HIST_t hist;
+  __EXTI_STAT_t      line8[kBENCH_STAT_LINES / 4u];
+} __BENCH_STAT_t;
+
+typedef struct {
+  uint32_t id;
+  uint32_t lock;
+} __BENCH_STAT_ARG_t;
+
+static __BENCH_STAT_t   sBENCH_STAT;
+static pthread_mutex_t  sBENCH_STAT_MUTEX = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t         sBENCH_STAT_N;
+
+/* Latencia sintética del evento i del hilo id */
+static uint32_t bench_latency(uint32_t id, uint32_t i)
+{
+  return ((i * 2654435761u) >> (20u + id)) + id;
+}
+
+static void *bench_stat_thread(void *p)
+{
+  const __BENCH_STAT_ARG_t *arg = (const __BENCH_STAT_ARG_t *) p;
+  __BENCH_STAT_t           *s   = &sBENCH_STAT;
+
+  for (uint32_t i = 0u; i < sBENCH_STAT_N; i++) {
+    uint32_t lat  = bench_latency(arg->id, i);
+    uint32_t line = (i + arg->id) % kBENCH_STAT_LINES;
+
+    if (arg->lock) {
+      uint32_t k = EXTI_StatBucket(lat);
+      uint32_t w;
+
+      pthread_mutex_lock(&sBENCH_STAT_MUTEX);
+      atomic_store_explicit(&s->events, atomic_load_explicit(&s->events, memory_order_relaxed) + 1u,
+                            memory_order_relaxed);
+      if (atomic_load_explicit(&s->lat_max, memory_order_relaxed) < lat) {
+        atomic_store_explicit(&s->lat_max, lat, memory_order_relaxed);
+      }
+      atomic_store_explicit(&s->hist.bucket[k],
+                            atomic_load_explicit(&s->hist.bucket[k], memory_order_relaxed) + 1u,
+                            memory_order_relaxed);
+      w = atomic_load_explicit(&s->line8[line >> 2], memory_order_relaxed);
+      atomic_store_explicit(&s->line8[line >> 2], EXTI_StatQadd8(w, 1u << ((line & 3u) * 8u)),
+                            memory_order_relaxed);
+      pthread_mutex_unlock(&sBENCH_STAT_MUTEX);
+    } else {
+      EXTI_StatAdd(&s->events, 1u);
+      EXTI_StatMax(&s->lat_max, lat);
+      EXTI_StatHist(&s->hist, lat);
+      EXTI_StatLine8(s->line8, line);
+    }
+  }
+  return NULL;
+}
+
+static void bench_reset(void)
+{
+  atomic_store_explicit(&sBENCH_STAT.events, 0u, memory_order_relaxed);
+  atomic_store_explicit(&sBENCH_STAT.lat_max, 0u, memory_order_relaxed);
+  for (uint32_t k = 0u; k < kEXTI_STAT_BUCKETS; k++) {
+    atomic_store_explicit(&sBENCH_STAT.hist.bucket[k], 0u, memory_order_relaxed);
+  }
+  for (uint32_t w = 0u; w < kBENCH_STAT_LINES / 4u; w++) {
+    atomic_store_explicit(&sBENCH_STAT.line8[w], 0u, memory_order_relaxed);
+  }
+}
+
+/* Totales esperados: eventos, suma del histograma, máximo y saturación de las líneas */
+static uint32_t bench_check(uint32_t threads)
+{
+  uint32_t max  = 0u;
+  uint32_t hist = 0u;
+  uint32_t ok   = 1u;
+
+  for (uint32_t t = 0u; t < threads; t++) {
+    for (uint32_t i = 0u; i < sBENCH_STAT_N; i++) {
+      uint32_t lat = bench_latency(t, i);
+
+      max = (lat > max) ? lat : max;
+    }
+  }
+  for (uint32_t k = 0u; k < kEXTI_STAT_BUCKETS; k++) {
+    hist += EXTI_StatRead(&sBENCH_STAT.hist.bucket[k]);
+  }
+  ok &= (EXTI_StatRead(&sBENCH_STAT.events) == threads * sBENCH_STAT_N);
+  ok &= (hist == threads * sBENCH_STAT_N);
+  ok &= (EXTI_StatRead(&sBENCH_STAT.lat_max) == max);
+  for (uint32_t line = 0u; line < kBENCH_STAT_LINES; line++) {
+    ok &= (EXTI_StatLine8Read(sBENCH_STAT.line8, line) == 255u);
+  }
+  return ok;
+}
+
+static double bench_run(uint32_t threads, uint32_t lock, uint32_t *ok)
+{
+  pthread_t          th[kBENCH_STAT_THREADS];
+  __BENCH_STAT_ARG_t arg[kBENCH_STAT_THREADS];
+  uint64_t           t0;
+
+  bench_reset();
+  t0 = BENCH_NowNs();
+  for (uint32_t t = 0u; t < threads; t++) {
+    arg[t].id   = t;
+    arg[t].lock = lock;
+    pthread_create(&th[t], NULL, bench_stat_thread, &arg[t]);
+  }
+  for (uint32_t t = 0u; t < threads; t++) {
+    pthread_join(th[t], NULL);
+  }
+  *ok = bench_check(threads);
+  return (double) (BENCH_NowNs() - t0) / ((double) threads * sBENCH_STAT_N);
+}
+
+int main(int argc, char **argv)
+{
+  static const uint32_t kTHREADS[] = { 1u, 2u, 4u };
+
+  sBENCH_STAT_N = BENCH_Iterations(argc, argv, 4000000u);
+  printf("shared statistics: %u events per thread (add + max + histogram + packed line count)\n",
+         sBENCH_STAT_N);
+  printf("%-8s %12s %12s %8s\n", "threads", "lock ns/ev", "atomic ns/ev", "totals");
+
+  for (uint32_t i = 0u; i < sizeof(kTHREADS) / sizeof(kTHREADS[0]); i++) {
+    uint32_t ok_lock, ok_atomic;
+    double   t_lock   = bench_run(kTHREADS[i], 1u, &ok_lock);
+    double   t_atomic = bench_run(kTHREADS[i], 0u, &ok_atomic);
+
+    printf("%-8u %12.2f %12.2f %8s\n", kTHREADS[i], t_lock, t_atomic,
+           (ok_lock && ok_atomic) ? "ok" : "WRONG");
+  }
+  return 0;
+}
@@ -0,0 +1,31 @@
+/**
+ * \file bench_util.h
+ * \brief Utilidades comunes de los benchmarks de host (reloj y formato).
+ */
+
+#ifndef BENCH_UTIL_H_
+#define BENCH_UTIL_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * \brief  Marca de tiempo monotónica en nanosegundos.
+ */
+static inline uint64_t BENCH_NowNs(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * \brief  Número de iteraciones: primer argumento del programa o valor por defecto.
+ */
+static inline uint32_t BENCH_Iterations(int argc, char **argv, uint32_t dflt)
+{
+  return (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : dflt;
+}
+
+#endif /* BENCH_UTIL_H_ */
@@ -0,0 +1,219 @@
+/**
+ * \file bench_wait.c
+ * \brief Coste por tick de N esperas "flanco o plazo": rueda jerárquica frente a sondeo.
+ * \details Sobre el backend STM32L4 simulado se mantienen N esperas vivas en las líneas
+ * 0-15 con plazos aleatorios de 100 a 5000 ticks; al resolverse, cada espera se vuelve a
+ * armar en otra línea. En cada tick llega un flanco con probabilidad 1/8.
+ *  - wheel: EXTI_wait + sEXTI_WHEEL. El tick solo procesa la ranura que expira y el flanco
+ *    cancela los plazos de su línea en O(1).
+ *  - poll:  cada espera es un bucle de sondeo que, en cada tick, compara el contador de
+ *    flancos de su línea y el tiempo transcurrido (lo que hoy hace cada driver).
+ * Ambas variantes ven la misma secuencia de flancos (misma semilla).
+ *
+ * Uso: bench_wait [ticks]
+ */
+
+#include <stdio.h>
+
+#include "EXTI_sim.h"
+#include "EXTI_wait.h"
+#include "bench_util.h"
+
+#define kBENCH_WAIT_LINES     (16u)
+#define kBENCH_WAIT_MAX       (1024u)
+#define kBENCH_WAIT_TMIN      (100u)
+#define kBENCH_WAIT_TSPAN     (4900u)
+
+static uint32_t sBENCH_RNG;         /* Líneas y plazos de las esperas */
+static uint32_t sBENCH_EDGE_RNG;    /* Flancos: secuencia propia, igual en ambas variantes */
+static uint32_t sBENCH_TICK;
+static uint32_t sBENCH_EDGES, sBENCH_TIMEOUTS;
+
+uint32_t EXTI_TIME_Now(void)
+{
+  return sBENCH_TICK;
+}
+
+static uint32_t bench_xorshift(uint32_t *state)
+{
+  uint32_t x = *state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static uint32_t bench_rand(void)
+{
+  return bench_xorshift(&sBENCH_RNG);
+}
+
+static uint32_t bench_timeout(void)
+{
+  return kBENCH_WAIT_TMIN + bench_rand() % kBENCH_WAIT_TSPAN;
+}
+
+/* Flanco aleatorio del tick (misma secuencia en ambas variantes) */
+static void bench_edge(void)
+{
+  uint32_t r = bench_xorshift(&sBENCH_EDGE_RNG);
+
+  if ((r & 7u) == 0u) {
+    uint32_t line = (r >> 3) % kBENCH_WAIT_LINES;
+
+    (void) EXTI_SIM_Edge(line, 1u);
+    EXTI_STM32L4_Service(1u << line);
+  }
+}
+
+/* ---- Rueda ---- */
+
+static __EXTI_WAIT_t sBENCH_WAITS[kBENCH_WAIT_MAX];
+
+static void bench_wait_done(__EXTI_WAIT_t *wt, void *ctx)
+{
+  (void) ctx;
+  if (EXTI_WaitState(wt) == kEXTI_WAIT_EDGE) {
+    sBENCH_EDGES++;
+  } else {
+    sBENCH_TIMEOUTS++;
+  }
+  (void) EXTI_WaitStart(wt, bench_rand() % kBENCH_WAIT_LINES, kEXTI_TRIG_EDGE_RISING,
+                        bench_timeout(), bench_wait_done, NULL);
+}
+
+static uint64_t bench_wheel(uint32_t n, uint32_t ticks)
+{
+  uint64_t t0;
+
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  EXTI_WaitInit(0u);
+  for (uint32_t line = 0u; line < kBENCH_WAIT_LINES; line++) {
+    (void) EXTI_WaitAttach(line, kEXTI_TRIG_EDGE_RISING);
+  }
+  sBENCH_RNG      = 0x1234567u;
+  sBENCH_EDGE_RNG = 0x89ABCDEu;
+  sBENCH_TICK = 0u;
+  for (uint32_t i = 0u; i < n; i++) {
+    (void) EXTI_WaitStart(&sBENCH_WAITS[i], bench_rand() % kBENCH_WAIT_LINES,
+                          kEXTI_TRIG_EDGE_RISING, bench_timeout(), bench_wait_done, NULL);
+  }
+
+  t0 = BENCH_NowNs();
+  for (uint32_t t = 0u; t < ticks; t++) {
+    sBENCH_TICK++;
+    (void) EXTI_WheelTick(&sEXTI_WHEEL);
+    bench_edge();
+  }
+  t0 = BENCH_NowNs() - t0;
+
+  for (uint32_t i = 0u; i < n; i++) {
+    EXTI_WaitCancel(&sBENCH_WAITS[i]);
+  }
+  return t0;
+}
+
+/* ---- Sondeo ---- */
+
+typedef struct {
+  uint32_t line;
+  uint32_t seen;
+  uint32_t start;
+  uint32_t timeout;
+} __BENCH_POLL_t;
+
+static __BENCH_POLL_t    sBENCH_POLL[kBENCH_WAIT_MAX];
+static volatile uint32_t sBENCH_LINE_EDGES[kBENCH_WAIT_LINES];
+
+static void bench_poll_handler(uint32_t line, uint32_t events, void *ctx)
+{
+  (void) events;
+  (void) ctx;
+  sBENCH_LINE_EDGES[line]++;
+}
+
+static void bench_poll_arm(__BENCH_POLL_t *p)
+{
+  p->line    = bench_rand() % kBENCH_WAIT_LINES;
+  p->seen    = sBENCH_LINE_EDGES[p->line];
+  p->start   = sBENCH_TICK;
+  p->timeout = bench_timeout();
+}
+
+static uint64_t bench_poll(uint32_t n, uint32_t ticks)
+{
+  uint64_t t0;
+
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  for (uint32_t line = 0u; line < kBENCH_WAIT_LINES; line++) {
+    sBENCH_LINE_EDGES[line] = 0u;
+    (void) EXTI_LineConfig(line, kEXTI_TRIG_EDGE_RISING, bench_poll_handler, NULL);
+    EXTI_LineEnable(line);
+  }
+  sBENCH_RNG      = 0x1234567u;
+  sBENCH_EDGE_RNG = 0x89ABCDEu;
+  sBENCH_TICK = 0u;
+  for (uint32_t i = 0u; i < n; i++) {
+    bench_poll_arm(&sBENCH_POLL[i]);
+  }
+
+  t0 = BENCH_NowNs();
+  for (uint32_t t = 0u; t < ticks; t++) {
+    sBENCH_TICK++;
+    for (uint32_t i = 0u; i < n; i++) {
+      __BENCH_POLL_t *p = &sBENCH_POLL[i];
+
+      if (sBENCH_LINE_EDGES[p->line] != p->seen) {
+        sBENCH_EDGES++;
+        bench_poll_arm(p);
+      } else if (sBENCH_TICK - p->start >= p->timeout) {
+        sBENCH_TIMEOUTS++;
+        bench_poll_arm(p);
+      }
+    }
+    bench_edge();
+  }
+  return BENCH_NowNs() - t0;
+}
+
+/* ---- Espera bloqueante: el "WFI" de la simulación avanza un tick ---- */
+
+void EXTI_WAIT_Idle(void)
+{
+  sBENCH_TICK++;
+  (void) EXTI_WheelTick(&sEXTI_WHEEL);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t ticks = BENCH_Iterations(argc, argv, 200000u);
+  uint32_t start;
+  uint32_t events = 0u;
+  __EXTI_WAIT_STATE_t st;
+
+  printf("edge-or-timeout waits, %u ticks, edge probability 1/8 per tick\n", ticks);
+  printf("%-6s %10s %12s %10s %10s\n", "waits", "mode", "ns/tick", "edges", "timeouts");
+  for (uint32_t n = 16u; n <= kBENCH_WAIT_MAX; n *= 4u) {
+    uint64_t ns;
+
+    sBENCH_EDGES = sBENCH_TIMEOUTS = 0u;
+    ns = bench_wheel(n, ticks);
+    printf("%-6u %10s %12.2f %10u %10u\n", n, "wheel", (double) ns / ticks, sBENCH_EDGES, sBENCH_TIMEOUTS);
+
+    sBENCH_EDGES = sBENCH_TIMEOUTS = 0u;
+    ns = bench_poll(n, ticks);
+    printf("%-6u %10s %12.2f %10u %10u\n", n, "poll", (double) ns / ticks, sBENCH_EDGES, sBENCH_TIMEOUTS);
+  }
+
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  EXTI_WaitInit(sBENCH_TICK);
+  (void) EXTI_WaitAttach(0u, kEXTI_TRIG_EDGE_RISING);
+  start = sBENCH_TICK;
+  st = EXTI_WaitBlocking(0u, kEXTI_TRIG_EDGE_RISING, 50u, &events);
+  printf("blocking wait, no edge: state %d after %u ticks\n", (int) st, sBENCH_TICK - start);
+  return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * \file bench_wake.c
+ * \brief Armado y decodificación de fuentes de despertar internas (EXTI_wake.h) frente a
+ * recorrer las líneas una a una.
+ * \details Sobre el backend STM32L4 simulado (EXTI_sim.h, con pendientes del NVIC):
+ *  - Comprobación: conjuntos armados y conjuntos de disparo aleatorios entre las fuentes de la
+ *    variante; EXTI_WakeReason() debe devolver exactamente las armadas que se dispararon.
+ *  - Coste de armar: EXTI_WakeArm() frente a EXTI_PORT_Config() + EXTI_PORT_Enable() por
+ *    línea, el camino de EXTI_LineConfig().
+ *  - Coste de decodificar: EXTI_WakeReason() frente a un bucle por las líneas 16-40 que
+ *    consulta PRx o el pendiente del vector de cada línea armada.
+ * En el simulador las escrituras W1C de PRx son llamadas a función; los tiempos comparan el
+ * número de accesos, no el coste real del bus.
+ *
+ * Uso: bench_wake [iteraciones]
+ */
+
+#include <stdio.h>
+
+#include "EXTI_sim.h"
+#include "EXTI_wake.h"
+#include "bench_util.h"
+
+static uint32_t          sBENCH_WAKE_RNG = 0x3A4E5EEDu;
+static volatile uint64_t sBENCH_WAKE_SINK;
+
+#define BENCH_WAKE_IRQN_CASE_(line, name, irqn)   case (line): return (irqn);
+
+static uint32_t bench_irqn(uint32_t line)
+{
+  switch (line) {
+    EXTI_VAR_SOURCES(BENCH_WAKE_IRQN_CASE_)
+    default: return 0u;
+  }
+}
+
+static uint64_t bench_rand64(void)
+{
+  uint64_t r = 0u;
+
+  for (uint32_t i = 0u; i < 2u; i++) {
+    uint32_t x = sBENCH_WAKE_RNG;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sBENCH_WAKE_RNG = x;
+    r = (r << 32) | x;
+  }
+  return r;
+}
+
+/* Referencia: una línea cada vez */
+static __EXTI_WAKE_SET_t bench_reason_lines(__EXTI_WAKE_SET_t armed)
+{
+  __EXTI_WAKE_SET_t why = 0u;
+
+  for (uint32_t line = kEXTI_GPIO_LINES; line <= kEXTI_MAX_LINE; line++) {
+    if ((armed & EXTI_WAKE(line)) == 0u) {
+      continue;
+    }
+    if (EXTI_VAR_LINE_CONFIGURABLE(line)) {
+      if (line < 32u) {
+        if (rEXTI_PR1 & EXTI_LINE_BIT(line)) {
+          EXTI_PR1_CLEAR(EXTI_LINE_BIT(line));
+          why |= EXTI_WAKE(line);
+        }
+      } else if (rEXTI_PR2 & EXTI_LINE_BIT(line)) {
+        EXTI_PR2_CLEAR(EXTI_LINE_BIT(line));
+        why |= EXTI_WAKE(line);
+      }
+    } else {
+      uint32_t irqn = bench_irqn(line);
+
+      if ((sEXTI_SIM_NVIC.ISPR[irqn >> 5] >> (irqn & 31u)) & 1u) {
+        why |= EXTI_WAKE(line);
+      }
+    }
+  }
+  return why;
+}
+
+static void bench_fire(__EXTI_WAKE_SET_t fire)
+{
+  for (__EXTI_WAKE_SET_t rest = fire; rest != 0u; ) {
+    (void) EXTI_SIM_Edge((uint32_t) EXTI_WakeNext(&rest), 1u);
+  }
+}
+
+static void bench_reset(void)
+{
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  EXTI_WakeDisarm(kEXTI_WAKE_SOURCES);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t          n      = BENCH_Iterations(argc, argv, 1000000u);
+  uint32_t          errors = 0u;
+  __EXTI_WAKE_SET_t four   = EXTI_WAKE(kEXTI_SRC_RTC_WKUP) | EXTI_WAKE(kEXTI_SRC_LPUART1) |
+                             EXTI_WAKE(kEXTI_SRC_LPTIM1) | EXTI_WAKE(kEXTI_SRC_COMP1);
+  uint64_t          t0, t_arm_set, t_arm_line, t_set, t_line;
+
+  printf("%d internal wake sources (%d configurable, %d direct)\n",
+         __builtin_popcountll(kEXTI_WAKE_SOURCES), __builtin_popcountll(kEXTI_WAKE_CONFIG),
+         __builtin_popcountll(kEXTI_WAKE_DIRECT));
+
+  /* Comprobación */
+  for (uint32_t i = 0u; i < 100000u; i++) {
+    __EXTI_WAKE_SET_t armed = bench_rand64() & kEXTI_WAKE_SOURCES;
+    __EXTI_WAKE_SET_t fire  = bench_rand64() & bench_rand64() & kEXTI_WAKE_SOURCES;
+    __EXTI_WAKE_SET_t why;
+
+    bench_reset();
+    (void) EXTI_WakeArm(armed, kEXTI_TRIG_EDGE_RISING);
+    bench_fire(fire);
+    why     = EXTI_WakeReason();
+    errors += (why != (fire & armed)) || ((rEXTI_PR1 | rEXTI_PR2) != 0u);
+  }
+  printf("decode check: 100000 random armed/fired sets, %u mismatches\n", errors);
+
+  /* Coste de armar 4 fuentes */
+  bench_reset();
+  t0 = BENCH_NowNs();
+  for (uint32_t i = 0u; i < n; i++) {
+    (void) EXTI_WakeArm(four, kEXTI_TRIG_EDGE_RISING);
+  }
+  t_arm_set = BENCH_NowNs() - t0;
+
+  bench_reset();
+  t0 = BENCH_NowNs();
+  for (uint32_t i = 0u; i < n; i++) {
+    for (__EXTI_WAKE_SET_t rest = four; rest != 0u; ) {
+      uint32_t line = (uint32_t) EXTI_WakeNext(&rest);
+
+      (void) EXTI_PORT_Config(line, kEXTI_TRIG_EDGE_RISING);
+      EXTI_PORT_Enable(line, 1u);
+    }
+  }
+  t_arm_line = BENCH_NowNs() - t0;
+  printf("arm 4 sources: EXTI_WakeArm %.2f ns, per-line config + enable %.2f ns\n",
+         (double) t_arm_set / n, (double) t_arm_line / n);
+
+  /* Coste de decodificar: 4 fuentes armadas y todas armadas, una disparada */
+  for (uint32_t all = 0u; all < 2u; all++) {
+    __EXTI_WAKE_SET_t armed = all ? kEXTI_WAKE_SOURCES : four;
+
+    bench_reset();
+    (void) EXTI_WakeArm(armed, kEXTI_TRIG_EDGE_RISING);
+    bench_fire(EXTI_WAKE(kEXTI_SRC_LPUART1));
+    t0 = BENCH_NowNs();
+    for (uint32_t i = 0u; i < n; i++) {
+      sBENCH_WAKE_SINK += EXTI_WakeReason();
+    }
+    t_set = BENCH_NowNs() - t0;
+    t0    = BENCH_NowNs();
+    for (uint32_t i = 0u; i < n; i++) {
+      sBENCH_WAKE_SINK += bench_reason_lines(armed);
+    }
+    t_line = BENCH_NowNs() - t0;
+    printf("decode, %2d armed: EXTI_WakeReason %.2f ns, per-line scan %.2f ns\n",
+           __builtin_popcountll(armed), (double) t_set / n, (double) t_line / n);
+  }
+  return (errors == 0u) ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+/**
+ * \file cm4_matrix.c
+ * \brief Matriz de operaciones EXTI compilada para Cortex-M4 (arm-none-eabi).
+ * \details No se enlaza: el objetivo cm4_access_report la compila con varios niveles de
+ * optimización, la desensambla y tools/objdump_report.py cuenta instrucciones, bytes y
+ * ciclos estimados de cada variante. Cada operación existe en dos estilos:
+ *
+ *  - _mask:     palabra completa rEXTI_* con máscaras mEXTI_*
+ *  - _bitfield: campos bEXTI_* de las uniones .b
+ *
+ * El nombre de cada función es op_<operacion>_<estilo>, de modo que el informe agrupa
+ * por operación y muestra los estilos en columnas.
+ */
+
+#include <stdint.h>
+
+#include "EXIT_lib.h"
+
+#define CM4_FN        __attribute__((noinline)) void
+
+extern void exti_handler(uint32_t line);
+
+/* Habilitar la línea 5: subida, sin bajada, desenmascarada */
+CM4_FN op_enable_line_mask(void)
+{
+  rEXTI_RTSR1 |= mEXTI_RTSR1_RT5;
+  rEXTI_FTSR1 &= ~mEXTI_FTSR1_FT5;
+  rEXTI_IMR1  |= mEXTI_IMR1_IM5;
+}
+
+CM4_FN op_enable_line_bitfield(void)
+{
+  bEXTI_RT5 = 1u;
+  bEXTI_FT5 = 0u;
+  bEXTI_IM5 = 1u;
+}
+
+/* Reconocer el pendiente de la línea 5 (la variante bitfield hace RMW sobre PR1 W1C) */
+CM4_FN op_clear_pending_mask(void)
+{
+  rEXTI_PR1 = mEXTI_PR1_PIF5;
+}
+
+CM4_FN op_clear_pending_bitfield(void)
+{
+  bEXTI_PIF5 = 1u;
+}
+
+/* Reconfigurar el flanco de la línea 5 de subida a bajada */
+CM4_FN op_reconfig_edge_mask(void)
+{
+  uint32_t rt = rEXTI_RTSR1;
+  uint32_t ft = rEXTI_FTSR1;
+
+  rEXTI_RTSR1 = rt & ~mEXTI_RTSR1_RT5;
+  rEXTI_FTSR1 = ft | mEXTI_FTSR1_FT5;
+}
+
+CM4_FN op_reconfig_edge_bitfield(void)
+{
+  bEXTI_RT5 = 0u;
+  bEXTI_FT5 = 1u;
+}
+
+/* Despacho del vector EXTI9_5 (N = 5 líneas) */
+CM4_FN op_dispatch5_mask(void)
+{
+  uint32_t pend = rEXTI_PR1 & rEXTI_IMR1 & 0x000003E0u;
+
+  rEXTI_PR1 = pend;
+  while (pend != 0u) {
+    uint32_t line = 31u - (uint32_t) __builtin_clz(pend);
+    pend &= ~(1u << line);
+    exti_handler(line);
+  }
+}
+
+CM4_FN op_dispatch5_bitfield(void)
+{
+  if (bEXTI_PIF5 && bEXTI_IM5) { rEXTI_PR1 = mEXTI_PR1_PIF5; exti_handler(5u); }
+  if (bEXTI_PIF6 && bEXTI_IM6) { rEXTI_PR1 = mEXTI_PR1_PIF6; exti_handler(6u); }
+  if (bEXTI_PIF7 && bEXTI_IM7) { rEXTI_PR1 = mEXTI_PR1_PIF7; exti_handler(7u); }
+  if (bEXTI_PIF8 && bEXTI_IM8) { rEXTI_PR1 = mEXTI_PR1_PIF8; exti_handler(8u); }
+  if (bEXTI_PIF9 && bEXTI_IM9) { rEXTI_PR1 = mEXTI_PR1_PIF9; exti_handler(9u); }
+}
+
+/* Despacho del vector EXTI15_10 (N = 6 líneas) */
+CM4_FN op_dispatch6_mask(void)
+{
+  uint32_t pend = rEXTI_PR1 & rEXTI_IMR1 & 0x0000FC00u;
+
+  rEXTI_PR1 = pend;
+  while (pend != 0u) {
+    uint32_t line = 31u - (uint32_t) __builtin_clz(pend);
+    pend &= ~(1u << line);
+    exti_handler(line);
+  }
+}
+
+CM4_FN op_dispatch6_bitfield(void)
+{
+  if (bEXTI_PIF10 && bEXTI_IM10) { rEXTI_PR1 = mEXTI_PR1_PIF10; exti_handler(10u); }
+  if (bEXTI_PIF11 && bEXTI_IM11) { rEXTI_PR1 = mEXTI_PR1_PIF11; exti_handler(11u); }
+  if (bEXTI_PIF12 && bEXTI_IM12) { rEXTI_PR1 = mEXTI_PR1_PIF12; exti_handler(12u); }
+  if (bEXTI_PIF13 && bEXTI_IM13) { rEXTI_PR1 = mEXTI_PR1_PIF13; exti_handler(13u); }
+  if (bEXTI_PIF14 && bEXTI_IM14) { rEXTI_PR1 = mEXTI_PR1_PIF14; exti_handler(14u); }
+  if (bEXTI_PIF15 && bEXTI_IM15) { rEXTI_PR1 = mEXTI_PR1_PIF15; exti_handler(15u); }
+}
@@ -0,0 +1,56 @@
+/**
+ * \file cm4_static.cpp
+ * \brief Rutinas de servicio GPIO de STM32L4 compiladas para Cortex-M4: registro genérico de
+ * EXTI_line frente al despacho estático de EXTI_static.h.
+ * \details No se enlaza: el objetivo cm4_access_report la compila, la desensambla y
+ * tools/objdump_report.py cuenta instrucciones, bytes y ciclos estimados. Cada vector existe
+ * en dos estilos, op_<vector>_generic (el cuerpo de EXTI_STM32L4_Service() con el despacho
+ * por bitscan y sEXTI_SLOTS) y op_<vector>_static, con la misma tabla de líneas:
+ *
+ *  - exti0:     una línea usada.
+ *  - exti9_5:   líneas 5, 6 y 7.
+ *  - exti15_10: líneas 10-15.
+ *
+ * La estimación estática no modela bucles: el camino genérico cuenta una iteración, es decir,
+ * una línea pendiente.
+ */
+
+#include <cstdint>
+
+#include "EXTI_static.h"
+
+#define CM4_FN        extern "C" __attribute__((noinline)) void
+
+extern "C" void cm4_handler(uint32_t line, uint32_t events, void *ctx);
+
+using cm4_table = exti::static_dispatch<
+    exti::on<0,  kEXTI_TRIG_EDGE_FALLING, cm4_handler>,
+    exti::on<5,  kEXTI_TRIG_EDGE_RISING,  cm4_handler>,
+    exti::on<6,  kEXTI_TRIG_EDGE_BOTH,    cm4_handler>,
+    exti::on<7,  kEXTI_TRIG_EDGE_RISING,  cm4_handler>,
+    exti::on<10, kEXTI_TRIG_EDGE_RISING,  cm4_handler>,
+    exti::on<11, kEXTI_TRIG_EDGE_RISING,  cm4_handler>,
+    exti::on<12, kEXTI_TRIG_EDGE_BOTH,    cm4_handler>,
+    exti::on<13, kEXTI_TRIG_EDGE_RISING,  cm4_handler>,
+    exti::on<14, kEXTI_TRIG_EDGE_RISING,  cm4_handler>,
+    exti::on<15, kEXTI_TRIG_EDGE_FALLING, cm4_handler>>;
+
+/* Cuerpo de EXTI_STM32L4_Service() en modo EXTI_DISPATCH_BITSCAN */
+static inline void cm4_generic(uint32_t lines)
+{
+  uint32_t pend = rEXTI_PR1 & rEXTI_IMR1 & lines;
+
+  if (pend != 0u) {
+    EXTI_PR1_CLEAR(pend);
+    EXTI_DispatchMask(0u, pend);
+  }
+}
+
+CM4_FN op_exti0_generic(void)      { cm4_generic(0x00000001u); }
+CM4_FN op_exti0_static(void)       { cm4_table::service<0x00000001u>(); }
+
+CM4_FN op_exti9_5_generic(void)    { cm4_generic(0x000003E0u); }
+CM4_FN op_exti9_5_static(void)     { cm4_table::service<0x000003E0u>(); }
+
+CM4_FN op_exti15_10_generic(void)  { cm4_generic(0x0000FC00u); }
+CM4_FN op_exti15_10_static(void)   { cm4_table::service<0x0000FC00u>(); }
@@ -0,0 +1,397 @@
+/**
+ * \file exti_energy.c
+ * \brief Energía por hora de una traza de flancos con distintas estrategias EXTI.
+ * \details La traza (una línea "t_ns línea [nivel]" por flanco, '#' para comentarios; el
+ * formato de exti_fuzz sin nivel alterna el nivel de cada línea) se ejecuta en tiempo virtual
+ * (1 tick de sEXTI_WHEEL = 1 us) contra el bloque EXTI simulado, el motor real de EXTI_line
+ * y el modelo de energía de EXTI_energy.h, con cada estrategia sobre las líneas GPIO de la
+ * traza, ambos flancos:
+ *  - irq:      interrupción por flanco; el manejador procesa cada flanco.
+ *  - debounce: interrupción por flanco que rearma un temporizador de la rueda (-w); al vencer,
+ *              despertar del temporizador y el manejador procesa el estado estable.
+ *  - coalesce: EXTI_coalesce.h con ventana -w: una interrupción por ráfaga, la línea
+ *              enmascarada durante la ventana y un despertar del temporizador por ventana.
+ *  - event:    EMR en lugar de IMR y WFE: cada flanco despierta sin excepción y el bucle
+ *              principal procesa el flanco (incluida la lectura de pines para saber cuál).
+ * Cada manejador que entrega un evento a la aplicación cuesta -H ciclos; el de la estrategia
+ * debounce, kTOOL_DEBOUNCE_CYCLES por flanco. Se informa de los eventos entregados, los
+ * despertares por camino, el tiempo despierto, la residencia en STOP y los mJ/hora de cada
+ * chip de la tabla.
+ *
+ * Sin -t se genera una traza sintética de campo (pulsador con rebotes, contacto de puerta
+ * con vibración, ráfagas de un sensor de vibración y un latido de 1 Hz) de -g segundos, que
+ * se puede guardar con -o. Las trazas deben durar menos de 71 minutos (rueda de 32 bits en us).
+ *
+ * Uso: exti_energy [-t traza | -g segundos [-o traza]] [-c chip] [-w ventana_us] [-H ciclos]
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "EXTI_coalesce.h"
+#include "EXTI_energy.h"
+#include "EXTI_sim.h"
+
+#define kTOOL_DEBOUNCE_CYCLES (40u)
+#define kTOOL_NEVER           (UINT32_MAX)
+
+typedef struct {
+  uint64_t t;       /*!< Instante del flanco [ns] */
+  uint32_t line;
+  uint32_t level;   /*!< Nivel tras el flanco */
+} __TOOL_EDGE_t;
+
+typedef struct {
+  uint32_t       n;
+  uint32_t       cap;
+  uint32_t       lines;   /*!< Máscara de líneas usadas */
+  __TOOL_EDGE_t *e;
+} __TOOL_TRACE_t;
+
+typedef enum {
+  kTOOL_IRQ,
+  kTOOL_DEBOUNCE,
+  kTOOL_COALESCE,
+  kTOOL_EVENT,
+  kTOOL_STRATEGIES
+} __TOOL_STRATEGY_t;
+
+static const char *const kTOOL_NAME[kTOOL_STRATEGIES] = { "irq", "debounce", "coalesce", "event" };
+
+static struct {
+  uint32_t        now;                          /*!< Tick de la rueda [us] */
+  uint32_t        rng;
+  uint32_t        window;
+  uint32_t        cycles;
+  uint32_t        delivered;
+  __EXTI_ENERGY_t e;
+  __EXTI_TIMER_t  timer[kEXTI_GPIO_LINES];
+  __EXTI_COAL_t   coal[kEXTI_GPIO_LINES];
+} sTOOL = { .rng = 0x5EED0E11u, .window = 20000u, .cycles = 2000u };
+
+uint32_t EXTI_TIME_Now(void)
+{
+  return sTOOL.now;
+}
+
+/* ---- Traza ---- */
+
+static void tool_push(__TOOL_TRACE_t *tr, uint64_t t, uint32_t line, uint32_t level)
+{
+  if (tr->n == tr->cap) {
+    tr->cap = (tr->cap != 0u) ? 2u * tr->cap : 4096u;
+    tr->e   = realloc(tr->e, tr->cap * sizeof(tr->e[0]));
+  }
+  tr->e[tr->n].t     = t;
+  tr->e[tr->n].line  = line;
+  tr->e[tr->n].level = level;
+  tr->lines         |= 1u << line;
+  tr->n++;
+}
+
+static int tool_cmp(const void *a, const void *b)
+{
+  const __TOOL_EDGE_t *x = a;
+  const __TOOL_EDGE_t *y = b;
+
+  return (x->t > y->t) - (x->t < y->t);
+}
+
+static int tool_load(const char *path, __TOOL_TRACE_t *tr)
+{
+  FILE    *f = fopen(path, "r");
+  char     buf[128];
+  uint32_t level[kEXTI_GPIO_LINES];
+
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+  for (uint32_t i = 0u; i < kEXTI_GPIO_LINES; i++) {
+    level[i] = 1u;
+  }
+  while (fgets(buf, sizeof(buf), f) != NULL) {
+    uint64_t t;
+    uint32_t line, lv;
+    int      n;
+
+    if (buf[0] == '#') {
+      continue;
+    }
+    n = sscanf(buf, "%" SCNu64 " %u %u", &t, &line, &lv);
+    if ((n < 2) || (line >= kEXTI_GPIO_LINES)) {
+      continue;
+    }
+    level[line] = (n == 3) ? (lv != 0u) : !level[line];
+    tool_push(tr, t, line, level[line]);
+  }
+  fclose(f);
+  qsort(tr->e, tr->n, sizeof(tr->e[0]), tool_cmp);
+  return 0;
+}
+
+static double tool_uniform(void)
+{
+  uint32_t x = sTOOL.rng;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sTOOL.rng = x;
+  return ((double) x + 1.0) / 4294967297.0;
+}
+
+static double tool_exp(double mean)
+{
+  return -log(tool_uniform()) * mean;
+}
+
+/* Ráfaga de n flancos alternos en [t, t + span] que termina en el nivel final */
+static void tool_burst(__TOOL_TRACE_t *tr, uint32_t line, double t, double span, uint32_t n,
+                       uint32_t final)
+{
+  uint32_t level = (n & 1u) ? final : !final;
+
+  for (uint32_t i = 0u; i < n; i++) {
+    level = !level;
+    tool_push(tr, (uint64_t) ((t + span * i / n + tool_uniform() * span / n) * 1e9), line,
+              level);
+  }
+}
+
+static void tool_generate(__TOOL_TRACE_t *tr, double seconds)
+{
+  double t;
+
+  /* 0: pulsador cada ~30 s, 8 rebotes al pulsar (1,5 ms) y 6 al soltar (1 ms) tras ~150 ms */
+  for (t = tool_exp(30.0); t < seconds - 1.0; t += tool_exp(30.0)) {
+    tool_burst(tr, 0u, t, 1.5e-3, 8u, 0u);
+    tool_burst(tr, 0u, t + 0.1 + tool_uniform() * 0.1, 1e-3, 6u, 1u);
+  }
+  /* 1: contacto de puerta cada ~2 min, 20 flancos de vibración en 15 ms */
+  for (t = tool_exp(120.0); t < seconds - 1.0; t += tool_exp(120.0)) {
+    tool_burst(tr, 1u, t, 15e-3, 20u, 0u);
+  }
+  /* 2: sensor de vibración cada ~1 min, 0,3 s a ~800 flancos/s */
+  for (t = tool_exp(60.0); t < seconds - 1.0; t += tool_exp(60.0)) {
+    tool_burst(tr, 2u, t, 0.3, 240u, 0u);
+  }
+  /* 3: latido limpio de 1 Hz, pulso de 10 ms */
+  for (t = 0.5; t < seconds - 1.0; t += 1.0) {
+    tool_push(tr, (uint64_t) (t * 1e9), 3u, 1u);
+    tool_push(tr, (uint64_t) ((t + 0.01) * 1e9), 3u, 0u);
+  }
+  qsort(tr->e, tr->n, sizeof(tr->e[0]), tool_cmp);
+}
+
+static int tool_save(const char *path, const __TOOL_TRACE_t *tr)
+{
+  FILE *f = fopen(path, "w");
+
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+  fprintf(f, "# exti_energy trace: %u edges\n", tr->n);
+  fprintf(f, "# t_ns line level\n");
+  for (uint32_t i = 0u; i < tr->n; i++) {
+    fprintf(f, "%" PRIu64 " %u %u\n", tr->e[i].t, tr->e[i].line, tr->e[i].level);
+  }
+  fclose(f);
+  return 0;
+}
+
+/* ---- Estrategias ---- */
+
+static void tool_handler(uint32_t line, uint32_t events, void *ctx)
+{
+  (void) line;
+  (void) events;
+  (void) ctx;
+  sTOOL.delivered++;
+  EXTI_ENERGY_Work(&sTOOL.e, sTOOL.cycles);
+}
+
+static void tool_debounce_edge(uint32_t line, uint32_t events, void *ctx)
+{
+  (void) events;
+  (void) ctx;
+  EXTI_ENERGY_Work(&sTOOL.e, kTOOL_DEBOUNCE_CYCLES);
+  EXTI_TimerStartIn(&sEXTI_WHEEL, &sTOOL.timer[line], sTOOL.window);
+}
+
+static void tool_debounce_done(__EXTI_TIMER_t *t, void *ctx)
+{
+  (void) t;
+  tool_handler((uint32_t) (uintptr_t) ctx, 0u, NULL);
+}
+
+static void tool_coal_done(const __EXTI_COAL_EVENT_t *ev, void *ctx)
+{
+  (void) ctx;
+  tool_handler(ev->line, ev->events, NULL);
+}
+
+static void tool_config(__TOOL_STRATEGY_t s, uint32_t lines)
+{
+  for (uint32_t l = lines; l != 0u; l &= l - 1u) {
+    uint32_t line = (uint32_t) __builtin_ctz(l);
+
+    switch (s) {
+      case kTOOL_IRQ:
+        EXTI_LineConfig(line, kEXTI_TRIG_EDGE_BOTH, tool_handler, NULL);
+        EXTI_LineEnable(line);
+        break;
+      case kTOOL_DEBOUNCE:
+        EXTI_TimerInit(&sTOOL.timer[line], tool_debounce_done, (void *) (uintptr_t) line);
+        EXTI_LineConfig(line, kEXTI_TRIG_EDGE_BOTH, tool_debounce_edge, NULL);
+        EXTI_LineEnable(line);
+        break;
+      case kTOOL_COALESCE:
+        EXTI_CoalesceAttach(&sTOOL.coal[line], line, kEXTI_TRIG_EDGE_BOTH, sTOOL.window,
+                            tool_coal_done, NULL);
+        break;
+      default:
+        /* Evento: flancos configurados y EMR, IMR enmascarado */
+        rEXTI_RTSR1 |= 1u << line;
+        rEXTI_FTSR1 |= 1u << line;
+        rEXTI_EMR1  |= 1u << line;
+        break;
+    }
+  }
+}
+
+static void tool_edge(__TOOL_STRATEGY_t s, const __TOOL_EDGE_t *ed)
+{
+  uint32_t bit = 1u << ed->line;
+
+  if (s == kTOOL_EVENT) {
+    if ((rEXTI_EMR1 & bit) && ((ed->level ? rEXTI_RTSR1 : rEXTI_FTSR1) & bit)) {
+      EXTI_ENERGY_Enter(&sTOOL.e, ed->t, kEXTI_ENERGY_EVENT);
+      tool_handler(ed->line, 0u, NULL);
+    }
+    return;
+  }
+  if (EXTI_SIM_Edge(ed->line, ed->level)) {
+    EXTI_ENERGY_Enter(&sTOOL.e, ed->t, kEXTI_ENERGY_IRQ);
+    EXTI_STM32L4_Service(bit);
+  }
+}
+
+static void tool_run(__TOOL_STRATEGY_t s, const __TOOL_TRACE_t *tr,
+                     const __EXTI_ENERGY_CHIP_t *chip, uint64_t span_ns)
+{
+  uint32_t               span_us = (uint32_t) (span_ns / 1000u);
+  uint32_t               i       = 0u;
+  __EXTI_ENERGY_REPORT_t r;
+
+  sTOOL.now       = 0u;
+  sTOOL.delivered = 0u;
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  EXTI_WheelInit(&sEXTI_WHEEL, 0u);
+  EXTI_WheelClock(&sEXTI_WHEEL, EXTI_TIME_Now);
+  EXTI_ENERGY_Reset(&sTOOL.e, chip);
+  tool_config(s, tr->lines);
+
+  for (;;) {
+    uint32_t timer;
+    uint32_t has = EXTI_WheelNextExpiry(&sEXTI_WHEEL, &timer);
+
+    if ((i < tr->n) && (!has || ((uint32_t) (tr->e[i].t / 1000u) < timer))) {
+      /* La ISR corre antes de que el bucle despierto avance la rueda hasta el flanco */
+      sTOOL.now = (uint32_t) (tr->e[i].t / 1000u);
+      tool_edge(s, &tr->e[i++]);
+      (void) EXTI_WheelAdvance(&sEXTI_WHEEL, sTOOL.now);
+    } else if (has && (timer <= span_us)) {
+      sTOOL.now = timer;
+      EXTI_ENERGY_Enter(&sTOOL.e, (uint64_t) timer * 1000u, kEXTI_ENERGY_TIMER);
+      (void) EXTI_WheelAdvance(&sEXTI_WHEEL, sTOOL.now);
+    } else {
+      break;
+    }
+  }
+
+  EXTI_ENERGY_Report(&sTOOL.e, span_ns, &r);
+  printf("  %-9s %9u %7u %7u %7u %10.2f %8.4f %9.3f %9.3f %9.3f %9.3f\n", kTOOL_NAME[s],
+         sTOOL.delivered, sTOOL.e.wakes[kEXTI_ENERGY_IRQ], sTOOL.e.wakes[kEXTI_ENERGY_EVENT],
+         sTOOL.e.wakes[kEXTI_ENERGY_TIMER], sTOOL.e.awake_ns / 1e6, r.stop_pct, r.stop, r.wake,
+         r.run, r.total);
+}
+
+int main(int argc, char **argv)
+{
+  __TOOL_TRACE_t tr      = { 0u, 0u, 0u, NULL };
+  const char    *in      = NULL;
+  const char    *out     = NULL;
+  const char    *chip_id = NULL;
+  double         seconds = 600.0;
+  uint64_t       span_ns;
+
+  for (int i = 1; i < argc; i++) {
+    if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc)) {
+      in = argv[++i];
+    } else if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc)) {
+      seconds = strtod(argv[++i], NULL);
+    } else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc)) {
+      out = argv[++i];
+    } else if ((strcmp(argv[i], "-c") == 0) && (i + 1 < argc)) {
+      chip_id = argv[++i];
+    } else if ((strcmp(argv[i], "-w") == 0) && (i + 1 < argc)) {
+      sTOOL.window = (uint32_t) strtoul(argv[++i], NULL, 0);
+    } else if ((strcmp(argv[i], "-H") == 0) && (i + 1 < argc)) {
+      sTOOL.cycles = (uint32_t) strtoul(argv[++i], NULL, 0);
+    } else {
+      fprintf(stderr, "uso: %s [-t traza | -g segundos [-o traza]] [-c chip] [-w ventana_us] "
+              "[-H ciclos]\n", argv[0]);
+      return 2;
+    }
+  }
+  if ((chip_id != NULL) && (EXTI_ENERGY_Chip(chip_id) == NULL)) {
+    fprintf(stderr, "chip desconocido: %s\n", chip_id);
+    return 2;
+  }
+  if ((sTOOL.window == 0u) || ((seconds * 1e6) >= (double) kTOOL_NEVER)) {
+    fprintf(stderr, "ventana nula o traza demasiado larga\n");
+    return 2;
+  }
+
+  if (in != NULL) {
+    if (tool_load(in, &tr) != 0) {
+      return 2;
+    }
+    span_ns = (tr.n != 0u) ? (tr.e[tr.n - 1u].t / 1000000000u + 1u) * 1000000000u : 1000000000u;
+    if (span_ns / 1000u >= kTOOL_NEVER) {
+      fprintf(stderr, "traza demasiado larga\n");
+      return 2;
+    }
+  } else {
+    tool_generate(&tr, seconds);
+    span_ns = (uint64_t) (seconds * 1e9);
+    if ((out != NULL) && (tool_save(out, &tr) != 0)) {
+      return 2;
+    }
+  }
+
+  printf("%u edges on lines 0x%04x over %.1f s, window %u us, handler %u cycles\n", tr.n,
+         tr.lines, span_ns / 1e9, sTOOL.window, sTOOL.cycles);
+  for (uint32_t c = 0u; c < kEXTI_ENERGY_CHIP_COUNT; c++) {
+    const __EXTI_ENERGY_CHIP_t *chip = &kEXTI_ENERGY_CHIP[c];
+
+    if ((chip_id != NULL) && (strcmp(chip->id, chip_id) != 0)) {
+      continue;
+    }
+    printf("\n%s (%s): %u mV, run %u uA, STOP2 %u nA, wake %.1f us\n", chip->id, chip->name,
+           chip->mv, chip->run_ua, chip->stop_na, chip->wake_ns / 1e3);
+    printf("  %-9s %9s %7s %7s %7s %10s %8s %9s %9s %9s %9s\n", "strategy", "delivered",
+           "irq", "event", "timer", "awake ms", "STOP %", "stop", "wake", "run", "mJ/h");
+    for (uint32_t s = 0u; s < kTOOL_STRATEGIES; s++) {
+      tool_run((__TOOL_STRATEGY_t) s, &tr, chip, span_ns);
+    }
+  }
+  free(tr.e);
+  return 0;
+}
@@ -0,0 +1,633 @@
+/**
+ * \file exti_fuzz.c
+ * \brief Búsqueda del peor caso de latencia de despacho por fuzzing sobre el simulador.
+ * \details Cada entrada es una traza de flancos de subida (instante, línea) sobre las líneas
+ * declaradas en EXTI_nvic_plan_cfg.h. La traza se ejecuta en tiempo virtual contra el bloque
+ * EXTI simulado (EXTI_sim.h), el motor real de EXTI_line (EXTI_STM32L4_Service) y un modelo
+ * de NVIC con expulsión, encadenado de colas y las prioridades de EXTI_nvic_plan.h:
+ *
+ *  - Cada activación de un vector cuesta kEXTI_PLAN_OVERHEAD_US más el WCET declarado de
+ *    cada línea que despacha, en el orden en que la rutina de servicio llama a los manejadores.
+ *  - Un flanco sobre una línea con PR ya activo se fusiona con el anterior: flanco perdido.
+ *  - Las trazas respetan la tasa máxima declarada de cada línea (intervalo mínimo 1/tasa).
+ *
+ * El fuzzer muta trazas (desplazar, mover de línea, insertar, borrar, alinear con otro flanco,
+ * cruzar con otra traza del corpus) y conserva en el corpus las que aportan cobertura nueva
+ * (pares de expulsión, profundidad de anidamiento, líneas por activación, cubo logarítmico de
+ * latencia por línea) o empeoran la puntuación: flancos perdidos y, después, la mayor
+ * latencia flanco -> manejador relativa al plazo. Las peores trazas se guardan como ficheros
+ * de texto reproducibles con --replay.
+ *
+ * Uso: exti_fuzz [-n iteraciones] [-s semilla] [-o directorio]
+ *      exti_fuzz --replay <traza>
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "EXTI_line.h"
+#include "EXTI_sim.h"
+#include "EXTI_nvic_plan.h"
+#include EXTI_PLAN_CONFIG
+
+#define kFUZZ_MAX_EDGES       (64u)
+#define kFUZZ_MAX_SEGMENTS    (kEXTI_GPIO_LINES)
+#define kFUZZ_MAX_CORPUS      (256u)
+#define kFUZZ_HORIZON_NS      (10000000u)     /* Ventana de cada traza: 10 ms */
+#define kFUZZ_COVERAGE_BITS   (2048u)
+#define kFUZZ_NO_LINE         (0xFFu)
+#define kFUZZ_PRIO_NONE       (0xFFu)
+
+#define US_TO_NS(us)          ((uint64_t) ((us) * 1000.0 + 0.5))
+
+typedef struct {
+  uint64_t t;     /*!< Instante del flanco [ns] */
+  uint32_t line;
+} __FUZZ_EDGE_t;
+
+typedef struct {
+  uint32_t      n;
+  __FUZZ_EDGE_t e[kFUZZ_MAX_EDGES];
+} __FUZZ_TRACE_t;
+
+/* Resultado de una ejecución */
+typedef struct {
+  uint64_t latency[kEXTI_GPIO_LINES];   /*!< Peor flanco -> inicio del manejador [ns] */
+  uint64_t response[kEXTI_GPIO_LINES];  /*!< Peor flanco -> fin del manejador [ns] */
+  uint32_t lost[kEXTI_GPIO_LINES];      /*!< Flancos fusionados con un PR ya activo */
+  uint32_t lost_total;
+  uint64_t score;
+  uint8_t  coverage[kFUZZ_COVERAGE_BITS / 8u];
+} __FUZZ_RESULT_t;
+
+/* Tramo de trabajo de una activación: entrada/salida (line = kFUZZ_NO_LINE) o un manejador */
+typedef struct {
+  uint32_t line;
+  uint64_t edge_t;
+  uint64_t work;
+} __FUZZ_SEGMENT_t;
+
+typedef struct {
+  uint32_t         vector;
+  uint32_t         nseg;
+  uint32_t         cur;
+  uint32_t         started;
+  __FUZZ_SEGMENT_t seg[kFUZZ_MAX_SEGMENTS + 1u];
+} __FUZZ_ACTIVATION_t;
+
+/* ---- Modelo: líneas, vectores y prioridades ---- */
+
+typedef struct {
+  uint32_t line;
+  uint64_t period;    /*!< Intervalo mínimo entre flancos [ns] */
+  uint64_t deadline;
+  uint64_t wcet;
+} __FUZZ_LINE_t;
+
+typedef struct {
+  const char *name;
+  uint32_t    irqn;
+  uint32_t    mask;
+  uint32_t    prio;
+} __FUZZ_VECTOR_t;
+
+#define FUZZ_LINE_(line, rate, deadline, wcet) \
+  { (line), US_TO_NS(1e6 / (double) (rate)), US_TO_NS(deadline), US_TO_NS(wcet) },
+#define FUZZ_VECTOR_(name, irqn, mask)  { #name, (irqn), (mask), kFUZZ_PRIO_NONE },
+#define FUZZ_PRIO_CASE_(name, irqn, prio)  case (irqn): return (prio);
+
+static const __FUZZ_LINE_t sFUZZ_LINES[]   = { EXTI_PLAN_LINES(FUZZ_LINE_) };
+static __FUZZ_VECTOR_t     sFUZZ_VECTORS[] = { EXTI_VAR_GPIO_VECTORS(FUZZ_VECTOR_) };
+
+#define kFUZZ_NLINES    (sizeof(sFUZZ_LINES) / sizeof(sFUZZ_LINES[0]))
+#define kFUZZ_NVECTORS  (sizeof(sFUZZ_VECTORS) / sizeof(sFUZZ_VECTORS[0]))
+
+static const uint64_t kFUZZ_OVERHEAD_NS = US_TO_NS(kEXTI_PLAN_OVERHEAD_US);
+
+static uint32_t fuzz_plan_prio(uint32_t irqn)
+{
+  switch (irqn) {
+    EXTI_NVIC_PLAN_VECTORS(FUZZ_PRIO_CASE_)
+    default: return kFUZZ_PRIO_NONE;
+  }
+}
+
+/* ---- Simulación en tiempo virtual ---- */
+
+static struct {
+  uint64_t             now;
+  uint64_t             pend_t[kEXTI_GPIO_LINES];  /*!< Instante del flanco que activó PR */
+  uint64_t             wcet[kEXTI_GPIO_LINES];
+  __FUZZ_ACTIVATION_t  stack[kFUZZ_NVECTORS];
+  uint32_t             depth;
+  __FUZZ_RESULT_t     *res;
+  FILE                *log;
+} sFUZZ;
+
+static void fuzz_cover(uint32_t feature)
+{
+  feature %= kFUZZ_COVERAGE_BITS;
+  sFUZZ.res->coverage[feature >> 3] |= (uint8_t) (1u << (feature & 7u));
+}
+
+/* Manejador registrado en EXTI_line: encola su WCET como tramo de la activación en curso */
+static void fuzz_handler(uint32_t line, uint32_t events, void *ctx)
+{
+  __FUZZ_ACTIVATION_t *a = &sFUZZ.stack[sFUZZ.depth - 1u];
+
+  (void) events;
+  (void) ctx;
+  a->seg[a->nseg].line   = line;
+  a->seg[a->nseg].edge_t = sFUZZ.pend_t[line];
+  a->seg[a->nseg].work   = sFUZZ.wcet[line];
+  a->nseg++;
+}
+
+static void fuzz_edge(uint32_t line, uint64_t t)
+{
+  if (rEXTI_PR1 & (1u << line)) {
+    sFUZZ.res->lost[line]++;
+    sFUZZ.res->lost_total++;
+    fuzz_cover(1024u + line);
+    if (sFUZZ.log) {
+      fprintf(sFUZZ.log, "%12" PRIu64 "  edge    line %2u  LOST (PR activo)\n", t, line);
+    }
+    return;
+  }
+  sFUZZ.pend_t[line] = t;
+  (void) EXTI_SIM_Edge(line, 1u);
+  if (sFUZZ.log) {
+    fprintf(sFUZZ.log, "%12" PRIu64 "  edge    line %2u\n", t, line);
+  }
+}
+
+/* Vector pendiente de mayor prioridad capaz de expulsar a la activación en curso */
+static uint32_t fuzz_next_vector(void)
+{
+  uint32_t pend   = rEXTI_PR1 & rEXTI_IMR1;
+  uint32_t best   = kFUZZ_NVECTORS;
+  uint32_t ceil_p = (sFUZZ.depth != 0u) ? sFUZZ_VECTORS[sFUZZ.stack[sFUZZ.depth - 1u].vector].prio
+                                        : UINT32_MAX;
+
+  for (uint32_t v = 0u; v < kFUZZ_NVECTORS; v++) {
+    uint32_t active = 0u;
+
+    if ((pend & sFUZZ_VECTORS[v].mask) == 0u) {
+      continue;
+    }
+    for (uint32_t d = 0u; d < sFUZZ.depth; d++) {
+      active |= (sFUZZ.stack[d].vector == v);
+    }
+    /* A igual prioridad el NVIC elige el IRQn menor; nunca expulsa a la misma prioridad */
+    if (!active && (sFUZZ_VECTORS[v].prio < ceil_p)
+        && ((best == kFUZZ_NVECTORS) || (sFUZZ_VECTORS[v].prio < sFUZZ_VECTORS[best].prio))) {
+      best = v;
+    }
+  }
+  return best;
+}
+
+static void fuzz_activate(uint32_t v)
+{
+  __FUZZ_ACTIVATION_t *a = &sFUZZ.stack[sFUZZ.depth];
+
+  if (sFUZZ.depth != 0u) {
+    fuzz_cover(64u + sFUZZ.stack[sFUZZ.depth - 1u].vector * 8u + v);
+  }
+  sFUZZ.depth++;
+  fuzz_cover(128u + sFUZZ.depth);
+
+  a->vector  = v;
+  a->cur     = 0u;
+  a->started = 0u;
+  a->nseg    = 1u;
+  a->seg[0].line = kFUZZ_NO_LINE;
+  a->seg[0].work = kFUZZ_OVERHEAD_NS;
+  EXTI_STM32L4_Service(sFUZZ_VECTORS[v].mask);
+  fuzz_cover(256u + v * 32u + a->nseg);
+
+  if (sFUZZ.log) {
+    fprintf(sFUZZ.log, "%12" PRIu64 "  enter   %-9s prio %u, %u manejador(es), nivel %u\n",
+            sFUZZ.now, sFUZZ_VECTORS[v].name, sFUZZ_VECTORS[v].prio, a->nseg - 1u, sFUZZ.depth);
+  }
+}
+
+static uint32_t fuzz_log2(uint64_t x)
+{
+  return (x == 0u) ? 0u : 63u - (uint32_t) __builtin_clzll(x);
+}
+
+static void fuzz_segment_event(const __FUZZ_SEGMENT_t *s, uint32_t done)
+{
+  uint64_t dt = sFUZZ.now - s->edge_t;
+
+  if (s->line == kFUZZ_NO_LINE) {
+    return;
+  }
+  if (!done) {
+    if (dt > sFUZZ.res->latency[s->line]) {
+      sFUZZ.res->latency[s->line] = dt;
+    }
+    fuzz_cover(1280u + s->line * 32u + fuzz_log2(dt));
+  } else if (dt > sFUZZ.res->response[s->line]) {
+    sFUZZ.res->response[s->line] = dt;
+  }
+  if (sFUZZ.log) {
+    fprintf(sFUZZ.log, "%12" PRIu64 "  %s line %2u  +%" PRIu64 " ns\n",
+            sFUZZ.now, done ? "end    " : "handler", s->line, dt);
+  }
+}
+
+static void fuzz_run(const __FUZZ_TRACE_t *tr, __FUZZ_RESULT_t *res)
+{
+  uint32_t k = 0u;
+  uint64_t worst = 0u;
+
+  memset(res, 0, sizeof(*res));
+  sFUZZ.res   = res;
+  sFUZZ.now   = 0u;
+  sFUZZ.depth = 0u;
+  EXTI_SIM_ClearPending1(mEXTI_PR1_VALID);
+
+  for (;;) {
+    uint32_t v = fuzz_next_vector();
+
+    if (v != kFUZZ_NVECTORS) {
+      fuzz_activate(v);
+      continue;
+    }
+    if (sFUZZ.depth == 0u) {
+      if (k == tr->n) {
+        break;
+      }
+      sFUZZ.now = tr->e[k].t;
+      fuzz_edge(tr->e[k].line, tr->e[k].t);
+      k++;
+      continue;
+    }
+
+    __FUZZ_ACTIVATION_t *a = &sFUZZ.stack[sFUZZ.depth - 1u];
+    __FUZZ_SEGMENT_t    *s = &a->seg[a->cur];
+
+    if (!a->started) {
+      a->started = 1u;
+      fuzz_segment_event(s, 0u);
+    }
+    if ((k < tr->n) && (tr->e[k].t < sFUZZ.now + s->work)) {
+      s->work  -= tr->e[k].t - sFUZZ.now;
+      sFUZZ.now = tr->e[k].t;
+      fuzz_edge(tr->e[k].line, tr->e[k].t);
+      k++;
+      continue;
+    }
+    sFUZZ.now += s->work;
+    fuzz_segment_event(s, 1u);
+    a->started = 0u;
+    if (++a->cur == a->nseg) {
+      sFUZZ.depth--;
+      if (sFUZZ.log) {
+        fprintf(sFUZZ.log, "%12" PRIu64 "  exit    %s\n", sFUZZ.now, sFUZZ_VECTORS[a->vector].name);
+      }
+    }
+  }
+
+  for (uint32_t i = 0u; i < kFUZZ_NLINES; i++) {
+    uint32_t line  = sFUZZ_LINES[i].line;
+    uint64_t ratio = res->latency[line] * 1000u / sFUZZ_LINES[i].deadline;
+
+    if (ratio > worst) {
+      worst = ratio;
+    }
+  }
+  res->score = ((uint64_t) res->lost_total << 32) | (worst & 0xFFFFFFFFu);
+}
+
+/* ---- Trazas ---- */
+
+static uint32_t sFUZZ_RNG = 1u;
+
+static uint32_t fuzz_rand(void)
+{
+  uint32_t x = sFUZZ_RNG;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return sFUZZ_RNG = x;
+}
+
+static uint32_t fuzz_below(uint32_t n)
+{
+  return (n == 0u) ? 0u : fuzz_rand() % n;
+}
+
+static int fuzz_edge_cmp(const void *a, const void *b)
+{
+  const __FUZZ_EDGE_t *x = a, *y = b;
+
+  return (x->t > y->t) - (x->t < y->t);
+}
+
+/* Ordena, recorta a la ventana y descarta los flancos que violan la tasa de su línea */
+static void fuzz_normalize(__FUZZ_TRACE_t *tr)
+{
+  uint64_t last[kEXTI_GPIO_LINES];
+  uint32_t seen = 0u, n = 0u;
+
+  qsort(tr->e, tr->n, sizeof(tr->e[0]), fuzz_edge_cmp);
+  for (uint32_t i = 0u; i < tr->n; i++) {
+    __FUZZ_EDGE_t e = tr->e[i];
+    uint64_t      period = 0u;
+
+    for (uint32_t j = 0u; j < kFUZZ_NLINES; j++) {
+      if (sFUZZ_LINES[j].line == e.line) {
+        period = sFUZZ_LINES[j].period;
+      }
+    }
+    if ((period == 0u) || (e.t >= kFUZZ_HORIZON_NS)) {
+      continue;
+    }
+    if ((seen & (1u << e.line)) && (e.t - last[e.line] < period)) {
+      continue;
+    }
+    seen |= 1u << e.line;
+    last[e.line] = e.t;
+    tr->e[n++] = e;
+  }
+  tr->n = n;
+}
+
+static uint32_t fuzz_random_line(void)
+{
+  return sFUZZ_LINES[fuzz_below(kFUZZ_NLINES)].line;
+}
+
+/* Desplazamiento con signo del orden de un WCET: es la escala de las interferencias */
+static int64_t fuzz_jitter(void)
+{
+  int64_t span = (int64_t) US_TO_NS(200.0);
+
+  return (int64_t) fuzz_below((uint32_t) (2 * span)) - span;
+}
+
+static void fuzz_mutate(__FUZZ_TRACE_t *tr, const __FUZZ_TRACE_t *other)
+{
+  uint32_t rounds = 1u + fuzz_below(4u);
+
+  for (uint32_t r = 0u; r < rounds; r++) {
+    uint32_t i = fuzz_below(tr->n);
+
+    switch (fuzz_below(6u)) {
+      case 0: /* Desplazar */
+        if (tr->n != 0u) {
+          int64_t t = (int64_t) tr->e[i].t + fuzz_jitter();
+          tr->e[i].t = (t < 0) ? 0u : (uint64_t) t;
+        }
+        break;
+      case 1: /* Cambiar de línea */
+        if (tr->n != 0u) {
+          tr->e[i].line = fuzz_random_line();
+        }
+        break;
+      case 2: /* Insertar cerca de otro flanco */
+        if (tr->n < kFUZZ_MAX_EDGES) {
+          int64_t t = (tr->n != 0u) ? (int64_t) tr->e[i].t + fuzz_jitter()
+                                    : (int64_t) fuzz_below(kFUZZ_HORIZON_NS);
+          tr->e[tr->n].t    = (t < 0) ? 0u : (uint64_t) t;
+          tr->e[tr->n].line = fuzz_random_line();
+          tr->n++;
+        }
+        break;
+      case 3: /* Borrar */
+        if (tr->n != 0u) {
+          tr->e[i] = tr->e[--tr->n];
+        }
+        break;
+      case 4: /* Alinear con otro flanco (coincidencias en el mismo vector) */
+        if (tr->n > 1u) {
+          uint32_t j = fuzz_below(tr->n);
+          tr->e[i].t = tr->e[j].t + fuzz_below((uint32_t) US_TO_NS(2.0));
+        }
+        break;
+      default: /* Cruzar: tomar los flancos de other a partir de un instante */
+        if (other != NULL && other->n != 0u) {
+          uint64_t cut = other->e[fuzz_below(other->n)].t;
+          uint32_t n = 0u;
+
+          for (uint32_t j = 0u; j < tr->n; j++) {
+            if (tr->e[j].t < cut) {
+              tr->e[n++] = tr->e[j];
+            }
+          }
+          for (uint32_t j = 0u; (j < other->n) && (n < kFUZZ_MAX_EDGES); j++) {
+            if (other->e[j].t >= cut) {
+              tr->e[n++] = other->e[j];
+            }
+          }
+          tr->n = n;
+        }
+        break;
+    }
+  }
+  fuzz_normalize(tr);
+}
+
+static int fuzz_save(const char *path, const __FUZZ_TRACE_t *tr, const __FUZZ_RESULT_t *res,
+                     const char *what)
+{
+  FILE *f = fopen(path, "w");
+
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+  fprintf(f, "# exti_fuzz trace: %s\n", what);
+  fprintf(f, "# lost %u, score 0x%016" PRIx64 "\n", res->lost_total, res->score);
+  fprintf(f, "# t_ns line\n");
+  for (uint32_t i = 0u; i < tr->n; i++) {
+    fprintf(f, "%" PRIu64 " %u\n", tr->e[i].t, tr->e[i].line);
+  }
+  fclose(f);
+  return 0;
+}
+
+static int fuzz_load(const char *path, __FUZZ_TRACE_t *tr)
+{
+  FILE *f = fopen(path, "r");
+  char  buf[128];
+
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+  tr->n = 0u;
+  while ((fgets(buf, sizeof(buf), f) != NULL) && (tr->n < kFUZZ_MAX_EDGES)) {
+    uint64_t t;
+    uint32_t line;
+
+    if ((buf[0] != '#') && (sscanf(buf, "%" SCNu64 " %u", &t, &line) == 2)) {
+      tr->e[tr->n].t    = t;
+      tr->e[tr->n].line = line;
+      tr->n++;
+    }
+  }
+  fclose(f);
+  return 0;
+}
+
+static void fuzz_report(const __FUZZ_RESULT_t *res)
+{
+  printf("%5s %12s %12s %12s %6s\n", "line", "D ns", "latency ns", "response ns", "lost");
+  for (uint32_t i = 0u; i < kFUZZ_NLINES; i++) {
+    uint32_t line = sFUZZ_LINES[i].line;
+
+    printf("%5u %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %6u %s\n", line,
+           sFUZZ_LINES[i].deadline, res->latency[line], res->response[line], res->lost[line],
+           (res->response[line] > sFUZZ_LINES[i].deadline) ? "MISS" : "");
+  }
+}
+
+/* ---- Bucle de fuzzing ---- */
+
+static __FUZZ_TRACE_t  sFUZZ_CORPUS[kFUZZ_MAX_CORPUS];
+static uint8_t         sFUZZ_SEEN[kFUZZ_COVERAGE_BITS / 8u];
+
+static uint32_t fuzz_new_coverage(const __FUZZ_RESULT_t *res)
+{
+  uint32_t fresh = 0u;
+
+  for (uint32_t i = 0u; i < sizeof(sFUZZ_SEEN); i++) {
+    uint8_t add = res->coverage[i] & (uint8_t) ~sFUZZ_SEEN[i];
+
+    fresh += (uint32_t) __builtin_popcount(add);
+    sFUZZ_SEEN[i] |= add;
+  }
+  return fresh;
+}
+
+static int fuzz_main(uint32_t iterations, const char *outdir)
+{
+  __FUZZ_TRACE_t  best, worst_line[kEXTI_GPIO_LINES];
+  __FUZZ_RESULT_t res, best_res;
+  uint64_t        worst_lat[kEXTI_GPIO_LINES] = { 0u };
+  uint32_t        ncorpus = 1u;
+  char            path[512];
+
+  /* Semilla: un flanco por línea en instantes aleatorios */
+  sFUZZ_CORPUS[0].n = 0u;
+  for (uint32_t i = 0u; i < kFUZZ_NLINES; i++) {
+    sFUZZ_CORPUS[0].e[i].t    = fuzz_below(kFUZZ_HORIZON_NS / 10u);
+    sFUZZ_CORPUS[0].e[i].line = sFUZZ_LINES[i].line;
+    sFUZZ_CORPUS[0].n++;
+  }
+  fuzz_normalize(&sFUZZ_CORPUS[0]);
+  best = sFUZZ_CORPUS[0];
+  fuzz_run(&best, &best_res);
+  (void) fuzz_new_coverage(&best_res);
+
+  for (uint32_t it = 0u; it < iterations; it++) {
+    __FUZZ_TRACE_t tr = sFUZZ_CORPUS[fuzz_below(ncorpus)];
+    uint32_t       keep;
+
+    fuzz_mutate(&tr, &sFUZZ_CORPUS[fuzz_below(ncorpus)]);
+    fuzz_run(&tr, &res);
+
+    keep = fuzz_new_coverage(&res);
+    if (res.score > best_res.score) {
+      best     = tr;
+      best_res = res;
+      keep     = 1u;
+    }
+    for (uint32_t i = 0u; i < kFUZZ_NLINES; i++) {
+      uint32_t line = sFUZZ_LINES[i].line;
+
+      if (res.latency[line] > worst_lat[line]) {
+        worst_lat[line]  = res.latency[line];
+        worst_line[line] = tr;
+        keep = 1u;
+      }
+    }
+    if (keep) {
+      sFUZZ_CORPUS[(ncorpus < kFUZZ_MAX_CORPUS) ? ncorpus++ : fuzz_below(kFUZZ_MAX_CORPUS)] = tr;
+    }
+  }
+
+  printf("exti_fuzz: %u iterations, corpus %u, lost %u\n", iterations, ncorpus, best_res.lost_total);
+  printf("worst overall trace (%u edges):\n", best.n);
+  fuzz_report(&best_res);
+
+  snprintf(path, sizeof(path), "%s/worst.trace", outdir);
+  if (fuzz_save(path, &best, &best_res, "peor puntuacion global") != 0) {
+    return 2;
+  }
+  for (uint32_t i = 0u; i < kFUZZ_NLINES; i++) {
+    uint32_t line = sFUZZ_LINES[i].line;
+
+    if (worst_lat[line] != 0u) {
+      char what[64];
+
+      fuzz_run(&worst_line[line], &res);
+      snprintf(path, sizeof(path), "%s/worst_line%u.trace", outdir, line);
+      snprintf(what, sizeof(what), "peor latencia de la linea %u", line);
+      if (fuzz_save(path, &worst_line[line], &res, what) != 0) {
+        return 2;
+      }
+    }
+  }
+  printf("traces written to %s\n", outdir);
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t    iterations = 200000u;
+  const char *outdir     = ".";
+  const char *replay     = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc)) {
+      iterations = (uint32_t) strtoul(argv[++i], NULL, 0);
+    } else if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc)) {
+      sFUZZ_RNG = (uint32_t) strtoul(argv[++i], NULL, 0) | 1u;
+    } else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc)) {
+      outdir = argv[++i];
+    } else if ((strcmp(argv[i], "--replay") == 0) && (i + 1 < argc)) {
+      replay = argv[++i];
+    } else {
+      fprintf(stderr, "uso: %s [-n iteraciones] [-s semilla] [-o dir] | --replay <traza>\n", argv[0]);
+      return 2;
+    }
+  }
+
+  for (uint32_t v = 0u; v < kFUZZ_NVECTORS; v++) {
+    sFUZZ_VECTORS[v].prio = fuzz_plan_prio(sFUZZ_VECTORS[v].irqn);
+  }
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  for (uint32_t i = 0u; i < kFUZZ_NLINES; i++) {
+    uint32_t line = sFUZZ_LINES[i].line;
+
+    sFUZZ.wcet[line] = sFUZZ_LINES[i].wcet;
+    EXTI_LineConfig(line, kEXTI_TRIG_EDGE_RISING, fuzz_handler, NULL);
+    EXTI_LineEnable(line);
+  }
+
+  if (replay != NULL) {
+    __FUZZ_TRACE_t  tr;
+    __FUZZ_RESULT_t res;
+
+    if (fuzz_load(replay, &tr) != 0) {
+      return 2;
+    }
+    fuzz_normalize(&tr);
+    sFUZZ.log = stdout;
+    printf("%12s  timeline (%u edges)\n", "t ns", tr.n);
+    fuzz_run(&tr, &res);
+    sFUZZ.log = NULL;
+    fuzz_report(&res);
+    return (res.lost_total != 0u) ? 1 : 0;
+  }
+  return fuzz_main(iterations, outdir);
+}
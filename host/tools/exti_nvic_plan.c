@@ -0,0 +1,237 @@
+/**
+ * \file exti_nvic_plan.c
+ * \brief Planificador de prioridades NVIC para los vectores EXTI (herramienta de host).
+ * \details Lee la tabla EXTI_PLAN_LINES de la configuración (EXTI_PLAN_CONFIG) y:
+ *
+ *  1. Agrupa las líneas por vector según EXTI_VAR_GPIO_VECTORS (EXTI_variant.h).
+ *  2. Asigna prioridades con el algoritmo de Audsley: del nivel más bajo al más alto, coloca
+ *     en cada nivel un vector cuyas líneas cumplan su plazo con todos los demás por encima.
+ *     Si ningún vector cabe, ordena el resto por plazo (deadline-monotonic) y lo informa.
+ *  3. Calcula el tiempo de respuesta en el peor caso de cada línea con la iteración clásica
+ *     R = C + O + B + sum_j ceil(R / T_j) * (C_j + O), donde j recorre las líneas de los
+ *     vectores de mayor prioridad y las demás líneas del mismo vector (un vector compartido
+ *     atiende sus líneas en serie, sin expulsión entre ellas).
+ *  4. Escribe EXTI_nvic_plan.h con la prioridad de cada vector y devuelve 1 si alguna línea
+ *     no cumple su plazo, de modo que la compilación se detiene.
+ *
+ * Uso: exti_nvic_plan <salida.h>
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "EXTI_variant.h"
+
+#ifndef EXTI_PLAN_CONFIG
+#define EXTI_PLAN_CONFIG "EXTI_nvic_plan_cfg.h"
+#endif
+#include EXTI_PLAN_CONFIG
+
+#define kPLAN_MAX_VECTORS     (8u)
+#define kPLAN_MAX_LINES       (kEXTI_GPIO_LINES)
+#define kPLAN_UNASSIGNED      (-1)
+
+_Static_assert(kPLAN_MAX_VECTORS >= 7u, "kPLAN_MAX_VECTORS < vectores EXTI GPIO");
+
+typedef struct {
+  uint32_t line;
+  double   period;    /*!< Intervalo mínimo entre flancos [us] */
+  double   deadline;  /*!< Plazo [us] */
+  double   wcet;      /*!< Tiempo de ejecución en el peor caso [us] */
+  uint32_t vector;    /*!< Índice en sPLAN_VECTORS */
+  double   response;  /*!< Tiempo de respuesta calculado [us] */
+} __PLAN_LINE_t;
+
+typedef struct {
+  const char *name;
+  uint32_t    irqn;
+  uint32_t    mask;
+  int         level;     /*!< 0 = más prioritario entre los vectores EXTI */
+  double      deadline;  /*!< Plazo mínimo de sus líneas */
+  uint32_t    nlines;
+} __PLAN_VECTOR_t;
+
+#define PLAN_LINE_(line, rate, deadline, wcet) \
+  { (line), 1e6 / (double) (rate), (double) (deadline), (double) (wcet), 0u, 0.0 },
+#define PLAN_VECTOR_(name, irqn, mask) \
+  { #name, (irqn), (mask), kPLAN_UNASSIGNED, INFINITY, 0u },
+
+static __PLAN_LINE_t   sPLAN_LINES[]   = { EXTI_PLAN_LINES(PLAN_LINE_) };
+static __PLAN_VECTOR_t sPLAN_VECTORS[] = { EXTI_VAR_GPIO_VECTORS(PLAN_VECTOR_) };
+
+#define kPLAN_NLINES    (sizeof(sPLAN_LINES) / sizeof(sPLAN_LINES[0]))
+#define kPLAN_NVECTORS  (sizeof(sPLAN_VECTORS) / sizeof(sPLAN_VECTORS[0]))
+
+/* ¿Interfiere el vector w con una línea del vector v, con la asignación de 'level'?
+ * Los vectores sin nivel se consideran por encima (hipótesis de Audsley). */
+static int plan_interferes(uint32_t w, uint32_t v, const int *level)
+{
+  if (w == v) {
+    return 1;
+  }
+  if (level[w] == kPLAN_UNASSIGNED) {
+    return 1;
+  }
+  if (level[v] == kPLAN_UNASSIGNED) {
+    return 0;
+  }
+  return level[w] < level[v];
+}
+
+/* Tiempo de respuesta de la línea i; devuelve INFINITY si supera su plazo */
+static double plan_response(uint32_t i, const int *level)
+{
+  const __PLAN_LINE_t *li = &sPLAN_LINES[i];
+  double r    = li->wcet + kEXTI_PLAN_OVERHEAD_US + kEXTI_PLAN_BLOCKING_US;
+  double prev = 0.0;
+
+  while (r != prev) {
+    prev = r;
+    r = li->wcet + kEXTI_PLAN_OVERHEAD_US + kEXTI_PLAN_BLOCKING_US;
+    for (uint32_t j = 0u; j < kPLAN_NLINES; j++) {
+      const __PLAN_LINE_t *lj = &sPLAN_LINES[j];
+
+      if ((j != i) && plan_interferes(lj->vector, li->vector, level)) {
+        r += ceil(prev / lj->period) * (lj->wcet + kEXTI_PLAN_OVERHEAD_US);
+      }
+    }
+    if (r > li->deadline) {
+      return INFINITY;
+    }
+  }
+  return r;
+}
+
+static int plan_vector_feasible(uint32_t v, const int *level)
+{
+  for (uint32_t i = 0u; i < kPLAN_NLINES; i++) {
+    if ((sPLAN_LINES[i].vector == v) && isinf(plan_response(i, level))) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int main(int argc, char **argv)
+{
+  int      level[kPLAN_MAX_VECTORS];
+  uint32_t used = 0u, misses = 0u;
+  int      audsley_ok = 1;
+  FILE    *out;
+
+  if (argc != 2) {
+    fprintf(stderr, "uso: %s <salida.h>\n", argv[0]);
+    return 2;
+  }
+
+  /* 1. Agrupar líneas por vector */
+  for (uint32_t i = 0u; i < kPLAN_NLINES; i++) {
+    __PLAN_LINE_t *l = &sPLAN_LINES[i];
+    uint32_t v;
+
+    if (l->line >= kPLAN_MAX_LINES) {
+      fprintf(stderr, "exti_nvic_plan: la linea %u no es una linea GPIO\n", l->line);
+      return 2;
+    }
+    for (v = 0u; v < kPLAN_NVECTORS; v++) {
+      if (sPLAN_VECTORS[v].mask & (1u << l->line)) {
+        break;
+      }
+    }
+    l->vector = v;
+    sPLAN_VECTORS[v].nlines++;
+    if (l->deadline < sPLAN_VECTORS[v].deadline) {
+      sPLAN_VECTORS[v].deadline = l->deadline;
+    }
+  }
+  for (uint32_t v = 0u; v < kPLAN_NVECTORS; v++) {
+    level[v] = kPLAN_UNASSIGNED;
+    used += (sPLAN_VECTORS[v].nlines != 0u);
+  }
+
+  /* 2. Audsley: del nivel más bajo (used - 1) al más alto (0) */
+  for (int lv = (int) used - 1; lv >= 0; lv--) {
+    int placed = 0;
+
+    for (uint32_t v = 0u; (v < kPLAN_NVECTORS) && !placed; v++) {
+      if ((sPLAN_VECTORS[v].nlines == 0u) || (level[v] != kPLAN_UNASSIGNED)) {
+        continue;
+      }
+      level[v] = lv;
+      if (plan_vector_feasible(v, level)) {
+        placed = 1;
+      } else {
+        level[v] = kPLAN_UNASSIGNED;
+      }
+    }
+    if (!placed) {
+      audsley_ok = 0;
+      /* Resto por plazo creciente (deadline-monotonic) */
+      for (int k = 0; k <= lv; k++) {
+        uint32_t best = kPLAN_NVECTORS;
+
+        for (uint32_t v = 0u; v < kPLAN_NVECTORS; v++) {
+          if ((sPLAN_VECTORS[v].nlines != 0u) && (level[v] == kPLAN_UNASSIGNED)
+              && ((best == kPLAN_NVECTORS) || (sPLAN_VECTORS[v].deadline < sPLAN_VECTORS[best].deadline))) {
+            best = v;
+          }
+        }
+        level[best] = k;
+      }
+      break;
+    }
+  }
+
+  if (kEXTI_PLAN_PRIO_BASE + used > (1u << kEXTI_PLAN_PRIO_BITS)) {
+    fprintf(stderr, "exti_nvic_plan: %u vectores no caben en %u bits de prioridad desde %u\n",
+            used, kEXTI_PLAN_PRIO_BITS, kEXTI_PLAN_PRIO_BASE);
+    return 2;
+  }
+
+  /* 3. Tiempos de respuesta finales */
+  printf("EXTI NVIC plan (%s)\n", audsley_ok ? "Audsley" : "deadline-monotonic fallback");
+  printf("%-10s %4s %5s %10s %10s %10s %10s %s\n",
+         "vector", "prio", "line", "T us", "C us", "D us", "R us", "");
+  for (uint32_t v = 0u; v < kPLAN_NVECTORS; v++) {
+    for (uint32_t i = 0u; i < kPLAN_NLINES; i++) {
+      __PLAN_LINE_t *l = &sPLAN_LINES[i];
+
+      if (l->vector != v) {
+        continue;
+      }
+      l->response = plan_response(i, level);
+      misses += isinf(l->response);
+      printf("%-10s %4d %5u %10.1f %10.1f %10.1f %10.1f %s\n",
+             sPLAN_VECTORS[v].name, kEXTI_PLAN_PRIO_BASE + level[v], l->line,
+             l->period, l->wcet, l->deadline, l->response,
+             isinf(l->response) ? "MISS" : "ok");
+    }
+  }
+
+  /* 4. Cabecera generada */
+  out = fopen(argv[1], "w");
+  if (out == NULL) {
+    perror(argv[1]);
+    return 2;
+  }
+  fprintf(out, "/* Generado por exti_nvic_plan a partir de %s. No editar. */\n\n", EXTI_PLAN_CONFIG);
+  fprintf(out, "#ifndef EXTI_NVIC_PLAN_H_\n#define EXTI_NVIC_PLAN_H_\n\n");
+  fprintf(out, "#define kEXTI_NVIC_PLAN_PRIO_BITS  (%u)\n", kEXTI_PLAN_PRIO_BITS);
+  fprintf(out, "#define kEXTI_NVIC_PLAN_MISSES     (%u)\n\n", misses);
+  fprintf(out, "/* X(vector, IRQn, prioridad) */\n#define EXTI_NVIC_PLAN_VECTORS(X) \\\n");
+  for (uint32_t v = 0u; v < kPLAN_NVECTORS; v++) {
+    if (level[v] != kPLAN_UNASSIGNED) {
+      fprintf(out, "  X(%s, %u, %d) \\\n", sPLAN_VECTORS[v].name, sPLAN_VECTORS[v].irqn,
+              kEXTI_PLAN_PRIO_BASE + level[v]);
+    }
+  }
+  fprintf(out, "\n#endif /* EXTI_NVIC_PLAN_H_ */\n");
+  fclose(out);
+
+  if (misses != 0u) {
+    fprintf(stderr, "exti_nvic_plan: %u linea(s) no cumplen su plazo\n", misses);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,514 @@
+/**
+ * \file exti_prof.c
+ * \brief Ranking de líneas por coste energético a partir de un volcado del perfilador de
+ * despertares (EXTI_prof.h).
+ * \details Lee la imagen binaria de sEXTI_PROF (volcado del depurador o copia de
+ * EXTI_ProfCopy() enviada por USB), comprueba firma, versión y dimensiones de la cabecera y
+ * ordena las entradas por energía con la tabla de chips de EXTI_energy.h:
+ *
+ *     E = V * I_run * (despertares * t_salida_STOP + ticks_despierto / hz)
+ *
+ * La transición de salida de STOP no la ve el contador de ciclos del destino y se añade aquí.
+ * Con -s (duración de la sesión de campo) se estima además la residencia en STOP, los mJ/hora
+ * de cada línea y su parte del consumo total: la fracción de batería que se ahorraría sin
+ * ella. Se listan la dirección del último manejador de cada línea (para addr2line sobre el
+ * ELF del firmware), el tiempo medio y máximo y el histograma log2 del tiempo despierto de la
+ * línea más cara.
+ *
+ * Sin volcado, -g ejecuta en tiempo virtual (80 MHz) un firmware de ejemplo con el perfilador
+ * real (EXTI_PROF) sobre el bucle EXTI_loop y el EXTI simulado: un pulsador con rebotes
+ * (línea 0), un contacto que vibra a ráfagas (línea 3), un sensor con dato listo a 1 Hz y
+ * manejador pesado (línea 5) y un latido de la rueda de 1 s (despertares sin línea). El
+ * volcado resultante se guarda con -o y se analiza como uno real.
+ *
+ * Uso: exti_prof [volcado | -g segundos [-o volcado]] [-c chip] [-s segundos_sesión]
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "EXTI_energy.h"
+#include "EXTI_loop.h"
+#include "EXTI_sim.h"
+
+#define kTOOL_HDR_WORDS       (10u)
+#define kTOOL_LINE_FIXED      (32u)
+#define kTOOL_TICK_US         (kEXTI_TIME_HZ / 1000000u)   /*!< Ticks por tick de la rueda */
+
+/**
+ * \brief  Entrada del volcado, ya decodificada.
+ */
+typedef struct {
+  uint32_t entry;
+  uint32_t wakes;
+  uint32_t dispatches;
+  uint32_t handler;
+  uint32_t handler_max;
+  uint64_t awake;
+  uint64_t busy;
+  uint32_t hist[32];
+  double   mj;             /*!< Energía de sus despertares */
+} __TOOL_ENTRY_t;
+
+typedef struct {
+  uint32_t        entries;
+  uint32_t        buckets;
+  uint32_t        hz;
+  uint32_t        shift;
+  uint32_t        sleeps;
+  __TOOL_ENTRY_t *e;
+} __TOOL_DUMP_t;
+
+/* ---- Firmware de ejemplo (-g) ---- */
+
+typedef struct {
+  uint32_t line;
+  uint32_t isr_cycles;     /*!< Manejador de línea (ISR) */
+  uint32_t loop_cycles;    /*!< Procesado del evento en el bucle */
+} __TOOL_LINE_t;
+
+static const __TOOL_LINE_t kTOOL_LINES[] = {
+  { 0u, 120u,  3000u },    /* Pulsador */
+  { 3u, 120u,   800u },    /* Contacto que vibra */
+  { 5u, 200u,  8000u },    /* Dato listo del sensor (lectura SPI y filtro) */
+};
+
+#define kTOOL_LINE_N          (sizeof(kTOOL_LINES) / sizeof(kTOOL_LINES[0]))
+#define kTOOL_HEARTBEAT_CYCLES (5000u)
+
+typedef struct {
+  uint64_t t;              /*!< Instante del flanco [ticks] */
+  uint32_t line;
+  uint32_t level;
+} __TOOL_EDGE_t;
+
+static struct {
+  uint64_t       now;      /*!< Reloj virtual [ticks a kEXTI_TIME_HZ] */
+  uint32_t       rng;
+  uint32_t       n;
+  uint32_t       cap;
+  uint32_t       next;     /*!< Próximo flanco sin aplicar */
+  __TOOL_EDGE_t *edge;
+  __EXTI_LOOP_t  loop;
+} sTOOL = { .rng = 0x5EED9F0Fu };
+
+uint32_t EXTI_TIME_Now(void)
+{
+  return (uint32_t) sTOOL.now;
+}
+
+uint32_t EXTI_LOOP_Now(void)
+{
+  return (uint32_t) (sTOOL.now / kTOOL_TICK_US);
+}
+
+/* WFI/STOP: el reloj salta al próximo flanco o al despertar programado; la ISR del flanco se
+ * ejecuta al salir de EXTI_LoopIdle(), cuando el destino bajaría PRIMASK */
+void EXTI_LOOP_Sleep(uint32_t armed, uint32_t deadline)
+{
+  uint64_t wake = UINT64_MAX;
+
+  if (armed) {
+    wake = (sTOOL.now / kTOOL_TICK_US +
+            (uint32_t) (deadline - (uint32_t) (sTOOL.now / kTOOL_TICK_US))) * kTOOL_TICK_US;
+  }
+  if ((sTOOL.next < sTOOL.n) && (sTOOL.edge[sTOOL.next].t < wake)) {
+    wake = sTOOL.edge[sTOOL.next].t;
+  }
+  if ((wake != UINT64_MAX) && (wake > sTOOL.now)) {
+    sTOOL.now = wake;
+  }
+}
+
+static void tool_work(uint32_t cycles)
+{
+  sTOOL.now += cycles;
+}
+
+static void tool_isr(uint32_t line, uint32_t events, void *ctx)
+{
+  for (uint32_t i = 0u; i < kTOOL_LINE_N; i++) {
+    if (kTOOL_LINES[i].line == line) {
+      tool_work(kTOOL_LINES[i].isr_cycles);
+    }
+  }
+  EXTI_LoopCapture(line, events, ctx);
+}
+
+static void tool_event(const __EXTI_EVENT_t *ev, void *ctx)
+{
+  (void) ev;
+  tool_work(((const __TOOL_LINE_t *) ctx)->loop_cycles);
+}
+
+static void tool_heartbeat(__EXTI_TIMER_t *t, void *ctx)
+{
+  (void) ctx;
+  tool_work(kTOOL_HEARTBEAT_CYCLES);
+  EXTI_TimerStart(&sEXTI_WHEEL, t, t->expires + 1000000u);
+}
+
+/* Flancos ya alcanzados por el reloj: petición EXTI y rutina de servicio */
+static void tool_fire_due(void)
+{
+  while ((sTOOL.next < sTOOL.n) && (sTOOL.edge[sTOOL.next].t <= sTOOL.now)) {
+    const __TOOL_EDGE_t *ed = &sTOOL.edge[sTOOL.next++];
+
+    if (EXTI_SIM_Edge(ed->line, ed->level)) {
+      EXTI_STM32L4_Service(1u << ed->line);
+    }
+  }
+}
+
+static double tool_uniform(void)
+{
+  uint32_t x = sTOOL.rng;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sTOOL.rng = x;
+  return ((double) x + 1.0) / 4294967297.0;
+}
+
+static double tool_exp(double mean)
+{
+  return -log(tool_uniform()) * mean;
+}
+
+static void tool_push(double t_s, uint32_t line, uint32_t *level)
+{
+  if (sTOOL.n == sTOOL.cap) {
+    sTOOL.cap  = (sTOOL.cap != 0u) ? 2u * sTOOL.cap : 4096u;
+    sTOOL.edge = realloc(sTOOL.edge, sTOOL.cap * sizeof(sTOOL.edge[0]));
+  }
+  level[line]               ^= 1u;
+  sTOOL.edge[sTOOL.n].t      = (uint64_t) (t_s * kEXTI_TIME_HZ);
+  sTOOL.edge[sTOOL.n].line   = line;
+  sTOOL.edge[sTOOL.n].level  = level[line];
+  sTOOL.n++;
+}
+
+static int tool_edge_cmp(const void *a, const void *b)
+{
+  const __TOOL_EDGE_t *x = a;
+  const __TOOL_EDGE_t *y = b;
+
+  return (x->t > y->t) - (x->t < y->t);
+}
+
+static void tool_generate(double seconds)
+{
+  uint32_t level[kEXTI_GPIO_LINES] = { 0u };
+
+  /* Pulsador: una pulsación cada ~20 s, 8 rebotes en 2 ms al pulsar y al soltar */
+  for (double t = tool_exp(20.0); t < seconds; t += tool_exp(20.0)) {
+    for (uint32_t k = 0u; k < 2u; k++) {
+      double at = t + k * 0.15;
+
+      for (uint32_t b = 0u; b < 9u; b++) {
+        tool_push(at + b * 0.00025, 0u, level);
+      }
+    }
+  }
+  /* Contacto: ráfagas de ~5 s cada ~30 s a ~200 flancos/s */
+  for (double t = tool_exp(30.0); t < seconds; t += tool_exp(30.0)) {
+    double end = t + 1.0 + tool_exp(4.0);
+
+    for (double at = t; (at < end) && (at < seconds); at += tool_exp(1.0 / 200.0)) {
+      tool_push(at, 3u, level);
+    }
+  }
+  /* Sensor: dato listo cada segundo, pulso de 50 us */
+  for (double t = 0.25; t < seconds; t += 1.0) {
+    tool_push(t, 5u, level);
+    tool_push(t + 50e-6, 5u, level);
+  }
+  qsort(sTOOL.edge, sTOOL.n, sizeof(sTOOL.edge[0]), tool_edge_cmp);
+}
+
+static int tool_demo(double seconds, const char *out, void *image, uint32_t *len)
+{
+  __EXTI_TIMER_t heartbeat;
+  uint64_t       end = (uint64_t) (seconds * kEXTI_TIME_HZ);
+
+  tool_generate(seconds);
+  EXTI_SIM_Reset();
+  EXTI_LineInit();
+  EXTI_LoopInit(&sTOOL.loop);
+  for (uint32_t i = 0u; i < kTOOL_LINE_N; i++) {
+    uint32_t line = kTOOL_LINES[i].line;
+
+    (void) EXTI_LoopLineConfig(&sTOOL.loop, line, kEXTI_TRIG_EDGE_BOTH, tool_event,
+                               (void *) &kTOOL_LINES[i]);
+    (void) EXTI_LineConfig(line, kEXTI_TRIG_EDGE_BOTH, tool_isr, &sTOOL.loop);
+    EXTI_LineEnable(line);
+  }
+  EXTI_TimerInit(&heartbeat, tool_heartbeat, NULL);
+  EXTI_TimerStartIn(&sEXTI_WHEEL, &heartbeat, 1000000u);
+
+  while (sTOOL.now < end) {
+    tool_fire_due();
+    (void) EXTI_LoopRunOnce(&sTOOL.loop);
+    tool_fire_due();
+    EXTI_LoopIdle(&sTOOL.loop);
+  }
+  *len = EXTI_ProfCopy(image);
+
+  printf("demo: %u edges over %.0f s, %u loop wakeups, %u events, %u timers\n", sTOOL.n,
+         seconds, sTOOL.loop.wakeups, sTOOL.loop.events, sTOOL.loop.timers);
+  printf("demo: lines 0, 3, 5 share the ISR handler 0x%08x\n", (uint32_t) (uintptr_t) tool_isr);
+  free(sTOOL.edge);
+
+  if (out != NULL) {
+    FILE *f = fopen(out, "wb");
+
+    if ((f == NULL) || (fwrite(image, 1u, *len, f) != *len)) {
+      perror(out);
+      if (f != NULL) {
+        fclose(f);
+      }
+      return -1;
+    }
+    fclose(f);
+  }
+  return 0;
+}
+
+/* ---- Volcado ---- */
+
+static uint32_t tool_u32(const uint8_t *p)
+{
+  return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) |
+         ((uint32_t) p[3] << 24);
+}
+
+static uint64_t tool_u64(const uint8_t *p)
+{
+  return (uint64_t) tool_u32(p) | ((uint64_t) tool_u32(p + 4) << 32);
+}
+
+static int tool_parse(const uint8_t *buf, size_t len, __TOOL_DUMP_t *d)
+{
+  size_t rec;
+
+  if ((len < 4u * kTOOL_HDR_WORDS) || (tool_u32(buf) != kEXTI_PROF_MAGIC)) {
+    fprintf(stderr, "not a profiler dump (bad magic)\n");
+    return -1;
+  }
+  if (tool_u32(buf + 4) != kEXTI_PROF_VERSION) {
+    fprintf(stderr, "unsupported dump version %u\n", tool_u32(buf + 4));
+    return -1;
+  }
+  d->entries = tool_u32(buf + 8);
+  d->buckets = tool_u32(buf + 12);
+  d->hz      = tool_u32(buf + 16);
+  d->shift   = tool_u32(buf + 20);
+  d->sleeps  = tool_u32(buf + 24);
+  rec        = kTOOL_LINE_FIXED + 4u * (size_t) d->buckets;
+  if ((d->entries == 0u) || (d->entries > 64u) || (d->buckets == 0u) || (d->buckets > 32u) ||
+      (d->hz == 0u) || (len < 4u * kTOOL_HDR_WORDS + d->entries * rec)) {
+    fprintf(stderr, "truncated or inconsistent dump (%zu bytes)\n", len);
+    return -1;
+  }
+
+  d->e = calloc(d->entries, sizeof(d->e[0]));
+  for (uint32_t i = 0u; i < d->entries; i++) {
+    const uint8_t  *p = buf + 4u * kTOOL_HDR_WORDS + i * rec;
+    __TOOL_ENTRY_t *e = &d->e[i];
+
+    e->entry       = i;
+    e->wakes       = tool_u32(p);
+    e->dispatches  = tool_u32(p + 4);
+    e->handler     = tool_u32(p + 8);
+    e->handler_max = tool_u32(p + 12);
+    e->awake       = tool_u64(p + 16);
+    e->busy        = tool_u64(p + 24);
+    for (uint32_t k = 0u; k < d->buckets; k++) {
+      e->hist[k] = tool_u32(p + kTOOL_LINE_FIXED + 4u * k);
+    }
+  }
+  return 0;
+}
+
+static uint8_t *tool_read(const char *path, size_t *len)
+{
+  FILE    *f = fopen(path, "rb");
+  uint8_t *buf;
+  long     n;
+
+  if (f == NULL) {
+    perror(path);
+    return NULL;
+  }
+  fseek(f, 0, SEEK_END);
+  n = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  buf = malloc((n > 0) ? (size_t) n : 1u);
+  *len = (n > 0) ? fread(buf, 1u, (size_t) n, f) : 0u;
+  fclose(f);
+  return buf;
+}
+
+/* ---- Ranking ---- */
+
+#define TOOL_SRC_NAME_(line, name, irqn)   [line] = #name,
+static const char *const kTOOL_SRC_NAME[kEXTI_LINE_COUNT] = {
+  EXTI_VAR_SOURCES(TOOL_SRC_NAME_)
+};
+
+static void tool_name(const __TOOL_DUMP_t *d, uint32_t entry, char *buf, size_t len)
+{
+  if (entry == d->entries - 1u) {
+    snprintf(buf, len, "other");
+  } else if ((d->entries == kEXTI_PROF_ENTRIES) && (kTOOL_SRC_NAME[entry] != NULL)) {
+    snprintf(buf, len, "%u %s", entry, kTOOL_SRC_NAME[entry]);
+  } else {
+    snprintf(buf, len, "%u", entry);
+  }
+}
+
+static int tool_cost_cmp(const void *a, const void *b)
+{
+  const __TOOL_ENTRY_t *x = a;
+  const __TOOL_ENTRY_t *y = b;
+
+  return (x->mj < y->mj) - (x->mj > y->mj);
+}
+
+static void tool_rank(__TOOL_DUMP_t *d, const __EXTI_ENERGY_CHIP_t *chip, double session_s)
+{
+  double v_ma   = chip->mv * 1e-3 * chip->run_ua * 1e-3;   /* V * mA -> mJ por segundo */
+  double total  = 0.0;
+  double awake  = 0.0;
+  double per_h  = (session_s > 0.0) ? 3600.0 / session_s : 0.0;
+  char   name[32];
+
+  for (uint32_t i = 0u; i < d->entries; i++) {
+    __TOOL_ENTRY_t *e = &d->e[i];
+    double          s = e->wakes * chip->wake_ns * 1e-9 + (double) e->awake / d->hz;
+
+    e->mj  = v_ma * s;
+    total += e->mj;
+    awake += s;
+  }
+  if (session_s > 0.0) {
+    double stop_s  = (session_s > awake) ? session_s - awake : 0.0;
+    double stop_mj = chip->mv * 1e-3 * chip->stop_na * 1e-6 * stop_s;
+
+    printf("session %.0f s: awake %.3f s (%.3f%%), STOP %.3f mJ, wakes %.3f mJ, "
+           "%.3f mJ/h total\n", session_s, awake, 100.0 * awake / session_s, stop_mj, total,
+           (stop_mj + total) * per_h);
+    total += stop_mj;
+  }
+  qsort(d->e, d->entries, sizeof(d->e[0]), tool_cost_cmp);
+
+  printf("%-18s %9s %9s %10s %9s %9s %9s %10s %8s %7s  %s\n", "line", "wakes", "dispatch",
+         "awake ms", "mean us", "busy ms", "max us", "mJ", "mJ/h", "share", "handler");
+  for (uint32_t i = 0u; i < d->entries; i++) {
+    const __TOOL_ENTRY_t *e = &d->e[i];
+
+    if ((e->wakes == 0u) && (e->dispatches == 0u)) {
+      continue;
+    }
+    tool_name(d, e->entry, name, sizeof(name));
+    printf("%-18s %9u %9u %10.3f %9.1f %9.3f %9.1f %10.4f %8.3f %6.1f%%  0x%08x\n", name,
+           e->wakes, e->dispatches, e->awake * 1e3 / d->hz,
+           (e->wakes != 0u) ? e->awake * 1e6 / d->hz / e->wakes : 0.0, e->busy * 1e3 / d->hz,
+           e->handler_max * 1e6 / d->hz, e->mj, e->mj * per_h,
+           (total > 0.0) ? 100.0 * e->mj / total : 0.0, e->handler);
+  }
+
+  if ((d->entries != 0u) && (d->e[0].wakes != 0u)) {
+    const __TOOL_ENTRY_t *e = &d->e[0];
+
+    tool_name(d, e->entry, name, sizeof(name));
+    printf("\nawake time per wake, line %s:\n", name);
+    for (uint32_t k = 0u; k < d->buckets; k++) {
+      double lo = (k == 0u) ? 0.0 : ldexp(1.0, (int) (k - 1u + d->shift)) * 1e6 / d->hz;
+
+      if (e->hist[k] == 0u) {
+        continue;
+      }
+      if (k + 1u == d->buckets) {
+        printf("  >= %10.1f us %9u\n", lo, e->hist[k]);
+      } else {
+        printf("  %10.1f us.. %9u\n", lo, e->hist[k]);
+      }
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  static uint8_t              image[sizeof(__EXTI_PROF_t)];
+  const char                 *in        = NULL;
+  const char                 *out       = NULL;
+  const char                 *chip_id   = "L43X";
+  const __EXTI_ENERGY_CHIP_t *chip;
+  double                      seconds   = 0.0;
+  double                      session_s = 0.0;
+  uint8_t                    *buf;
+  size_t                      len;
+  __TOOL_DUMP_t               d;
+
+  for (int i = 1; i < argc; i++) {
+    if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc)) {
+      seconds = strtod(argv[++i], NULL);
+    } else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc)) {
+      out = argv[++i];
+    } else if ((strcmp(argv[i], "-c") == 0) && (i + 1 < argc)) {
+      chip_id = argv[++i];
+    } else if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc)) {
+      session_s = strtod(argv[++i], NULL);
+    } else if ((argv[i][0] != '-') && (in == NULL)) {
+      in = argv[i];
+    } else {
+      in = NULL;
+      seconds = -1.0;
+      break;
+    }
+  }
+  chip = EXTI_ENERGY_Chip(chip_id);
+  if ((seconds < 0.0) || ((in == NULL) == (seconds == 0.0)) || (seconds > 3600.0)) {
+    fprintf(stderr, "uso: %s [volcado | -g segundos [-o volcado]] [-c chip] "
+            "[-s segundos_sesión]\n", argv[0]);
+    return 2;
+  }
+  if (chip == NULL) {
+    fprintf(stderr, "chip desconocido: %s\n", chip_id);
+    return 2;
+  }
+
+  if (in != NULL) {
+    buf = tool_read(in, &len);
+    if (buf == NULL) {
+      return 2;
+    }
+  } else {
+    uint32_t n;
+
+    if (tool_demo(seconds, out, image, &n) != 0) {
+      return 2;
+    }
+    buf       = image;
+    len       = n;
+    session_s = (session_s > 0.0) ? session_s : seconds;
+  }
+  if (tool_parse(buf, len, &d) != 0) {
+    return 2;
+  }
+
+  printf("%u entries, %u sleeps, %u Hz ticks; %s (%s): %u mV, run %u uA, wake %.1f us\n\n",
+         d.entries, d.sleeps, d.hz, chip->id, chip->name, chip->mv, chip->run_ua,
+         chip->wake_ns / 1e3);
+  tool_rank(&d, chip, session_s);
+  free(d.e);
+  if (buf != image) {
+    free(buf);
+  }
+  return 0;
+}
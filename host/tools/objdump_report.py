@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""Cuenta instrucciones, bytes y ciclos estimados por función a partir de objdump -d.
+
+Uso: objdump_report.py [--objdump OBJDUMP] [--cycles cortex-m4] [--title T] BINARIO REGEX
+
+Se listan las funciones cuyo nombre coincide con REGEX, agrupadas por el nombre sin el
+último sufijo (_sim, _mirror, _mask, _bitfield, ...) para comparar variantes en columnas.
+
+La estimación de ciclos de Cortex-M4 es estática (suma de todas las instrucciones de la
+función, sin modelar bucles) y usa los tiempos del TRM con memoria sin estados de espera:
+LDR/STR 2, LDM/STM/PUSH/POP 1+N, saltos tomados 1+P con P = 2 (se supone tomado todo
+salto condicional), UDIV/SDIV 12 (peor caso) y 1 ciclo para el resto.
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+FUNC_RE = re.compile(r"^[0-9a-f]+ <(?P<name>[^>]+)>:$")
+PADDING = ("nop", "nopw", "nopl", "cs", "data16", "int3", "xchg")
+ADDR_RE = re.compile(r"^\s*[0-9a-f]+:\s*(?P<bytes>(?:[0-9a-f]{2,8}\s*)*)$")
+
+
+def disassemble(objdump, binary):
+    out = subprocess.run([objdump, "-d", binary],
+                         check=True, capture_output=True, text=True).stdout
+    funcs = {}
+    current = None
+    for line in out.splitlines():
+        m = FUNC_RE.match(line)
+        if m:
+            current = funcs.setdefault(m.group("name"), [])
+            continue
+        if current is None:
+            continue
+        # GNU objdump:  "addr:<TAB>bytes<TAB>mnemonico<TAB>operandos"
+        # llvm-objdump: "addr: bytes<TAB>mnemonico<TAB>operandos"
+        parts = line.split("\t")
+        m = ADDR_RE.match(parts[0])
+        if not m:
+            if not line.strip():
+                current = None
+            continue
+        if not m.group("bytes"):
+            parts = parts[1:]
+        else:
+            parts[0] = m.group("bytes")
+        nbytes = sum(len(tok) // 2 for tok in parts[0].split()) if parts else 0
+        mnem = " ".join(parts[1:]).split()
+        if mnem:
+            current.append([mnem[0], " ".join(mnem[1:]), nbytes])
+        elif current:
+            # Continuación de una instrucción larga (solo bytes)
+            current[-1][2] += nbytes
+    # Quita el relleno de alineamiento que objdump atribuye a la función anterior
+    for insns in funcs.values():
+        while insns and insns[-1][0] in PADDING:
+            insns.pop()
+    return funcs
+
+
+def cycles_cortex_m4(mnem, operands):
+    """Ciclos estimados de una instrucción Thumb-2 en Cortex-M4."""
+    base = mnem.split(".")[0]
+    if base.startswith("."):
+        return 0
+    if base in ("push", "pop", "stmdb", "ldmia") or base.startswith(("ldm", "stm")):
+        regs = operands[operands.find("{") + 1:operands.find("}")]
+        n = 0
+        for r in regs.split(","):
+            r = r.strip()
+            if "-" in r:
+                lo, hi = r.split("-")
+                n += int(hi.strip().lstrip("r")) - int(lo.strip().lstrip("r")) + 1
+            elif r:
+                n += 1
+        return 1 + n + (2 if "pc" in regs else 0)
+    if base in ("ldrd", "strd"):
+        return 3
+    if base.startswith(("ldr", "str")):
+        return 2
+    if base in ("udiv", "sdiv"):
+        return 12
+    if base in ("bx", "blx", "bl") or base in ("cbz", "cbnz"):
+        return 3
+    if base == "b" or (base.startswith("b") and len(base) == 3 and
+                       base[1:] in ("eq", "ne", "cs", "cc", "hs", "lo", "mi", "pl", "vs",
+                                    "vc", "hi", "ls", "ge", "lt", "gt", "le", "al")):
+        return 3
+    return 1
+
+
+CYCLE_MODELS = {"cortex-m4": cycles_cortex_m4}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--objdump", default="objdump")
+    ap.add_argument("--cycles", choices=sorted(CYCLE_MODELS))
+    ap.add_argument("--title")
+    ap.add_argument("binary")
+    ap.add_argument("regex")
+    args = ap.parse_args()
+
+    funcs = disassemble(args.objdump, args.binary)
+    pattern = re.compile(args.regex)
+
+    rows = {}
+    targets = []
+    for name, insns in sorted(funcs.items()):
+        if not pattern.search(name):
+            continue
+        base, _, target = name.rpartition("_")
+        if target not in targets:
+            targets.append(target)
+        code = [i for i in insns if not i[0].startswith(".")]
+        cell = [len(code), sum(i[2] for i in insns)]
+        if args.cycles:
+            cell.append(sum(CYCLE_MODELS[args.cycles](i[0], i[1]) for i in code))
+        rows.setdefault(base, {})[target] = cell
+
+    if not rows:
+        print("no functions match %r" % args.regex, file=sys.stderr)
+        return 1
+
+    unit = "insn/B/cyc" if args.cycles else "insn/B"
+    width = max(len(b) for b in rows)
+    if args.title:
+        print(args.title)
+    print("%-*s" % (width, "function") +
+          "".join(" %20s" % ("%s %s" % (t, unit)) for t in targets))
+    for base in sorted(rows):
+        cells = []
+        for t in targets:
+            n = rows[base].get(t)
+            cells.append(" %20s" % ("/".join(str(v) for v in n) if n else "-"))
+        print("%-*s" % (width, base) + "".join(cells))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())